@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "boot_timeline.hh"
+#include "logged_lock.hh"
+#include "messages.h"
+
+#include <cstdio>
+#include <string>
+
+static constexpr size_t TIMELINE_SIZE = 64;
+
+class GlobalTimeline
+{
+  private:
+    LoggedLock::Mutex lock_;
+    BootTimeline::Timeline<TIMELINE_SIZE> timeline_;
+
+    /* close enough to program start for our purposes */
+    const std::chrono::steady_clock::time_point program_start_;
+
+    bool is_startup_completed_;
+    std::chrono::steady_clock::time_point startup_completed_;
+
+  public:
+    GlobalTimeline(const GlobalTimeline &) = delete;
+    GlobalTimeline &operator=(const GlobalTimeline &) = delete;
+
+    explicit GlobalTimeline():
+        program_start_(std::chrono::steady_clock::now()),
+        is_startup_completed_(false)
+    {
+        LoggedLock::configure(lock_, "BootTimeline", MESSAGE_LEVEL_DEBUG);
+    }
+
+    size_t begin(const char *phase, const char *subject)
+    {
+        const auto now = std::chrono::steady_clock::now();
+
+        LOGGED_LOCK_CONTEXT_HINT;
+        std::lock_guard<LoggedLock::Mutex> lock(lock_);
+        return timeline_.begin(phase, subject, now);
+    }
+
+    void end(size_t idx)
+    {
+        const auto now = std::chrono::steady_clock::now();
+
+        LOGGED_LOCK_CONTEXT_HINT;
+        std::lock_guard<LoggedLock::Mutex> lock(lock_);
+        timeline_.end(idx, now);
+    }
+
+    void startup_completed()
+    {
+        const auto now = std::chrono::steady_clock::now();
+
+        LOGGED_LOCK_CONTEXT_HINT;
+        std::lock_guard<LoggedLock::Mutex> lock(lock_);
+
+        if(is_startup_completed_)
+            return;
+
+        is_startup_completed_ = true;
+        startup_completed_ = now;
+    }
+
+    /*!
+     * Call \p fn for each line of a human-readable report.
+     */
+    template <typename F>
+    void for_each_report_line(const F &fn)
+    {
+        LOGGED_LOCK_CONTEXT_HINT;
+        std::lock_guard<LoggedLock::Mutex> lock(lock_);
+
+        char buffer[256];
+
+        if(is_startup_completed_)
+            snprintf(buffer, sizeof(buffer),
+                     "Boot timeline: %zu phases, startup completed after %lld ms",
+                     timeline_.size(), to_ms(startup_completed_));
+        else
+            snprintf(buffer, sizeof(buffer),
+                     "Boot timeline: %zu phases, startup not completed",
+                     timeline_.size());
+
+        fn(buffer);
+
+        timeline_.for_each(
+            [this, &fn, &buffer] (const BootTimeline::Entry &e)
+            {
+                const std::string indent(2 * e.depth_, ' ');
+
+                if(e.is_finished_)
+                    snprintf(buffer, sizeof(buffer), "  %7lld ms %7lld ms  %s%s%s%s",
+                             to_ms(e.begin_),
+                             static_cast<long long>(
+                                std::chrono::duration_cast<std::chrono::milliseconds>(
+                                    e.end_ - e.begin_).count()),
+                             indent.c_str(), e.phase_,
+                             e.subject_ != nullptr ? " " : "",
+                             e.subject_ != nullptr ? e.subject_ : "");
+                else
+                    snprintf(buffer, sizeof(buffer), "  %7lld ms    (running)  %s%s%s%s",
+                             to_ms(e.begin_),
+                             indent.c_str(), e.phase_,
+                             e.subject_ != nullptr ? " " : "",
+                             e.subject_ != nullptr ? e.subject_ : "");
+
+                fn(buffer);
+            });
+    }
+
+  private:
+    long long to_ms(std::chrono::steady_clock::time_point t) const
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                    t - program_start_).count();
+    }
+};
+
+static GlobalTimeline global_timeline;
+
+size_t BootTimeline::begin(const char *phase, const char *subject)
+{
+    return global_timeline.begin(phase, subject);
+}
+
+void BootTimeline::end(size_t idx)
+{
+    global_timeline.end(idx);
+}
+
+void BootTimeline::startup_completed()
+{
+    global_timeline.startup_completed();
+
+    if(msg_is_verbose(MESSAGE_LEVEL_DIAG))
+        global_timeline.for_each_report_line(
+            [] (const char *line) { msg_info("%s", line); });
+}
+
+std::string BootTimeline::dump()
+{
+    std::string report;
+
+    global_timeline.for_each_report_line(
+        [&report] (const char *line)
+        {
+            report += line;
+            report += '\n';
+        });
+
+    return report;
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#ifndef BOOT_TIMELINE_HH
+#define BOOT_TIMELINE_HH
+
+#include <array>
+#include <chrono>
+#include <limits>
+#include <string>
+
+/*!
+ * \addtogroup boot_timeline Startup time instrumentation
+ *
+ * Monotonic timestamps of the phases \c drcpd goes through during startup.
+ *
+ * Phases are recorded with their begin and end times, relative to program
+ * start, and with their nesting depth. Recording is always enabled since
+ * there are only a few dozen phases. The timeline is written to the log at
+ * the end of startup at verbosity level #MESSAGE_LEVEL_DIAG or higher. It
+ * can also be dumped on demand by passing #BootTimeline::DUMP_REQUEST as
+ * level name to the \c DebugLevel method of the \c de.tahifi.Debug.Logging
+ * D-Bus interface.
+ */
+/*!@{*/
+
+namespace BootTimeline
+{
+
+/*!
+ * Pseudo level name for requesting a dump of the boot timeline.
+ */
+static constexpr const char *DUMP_REQUEST = "dump-boot-timeline";
+
+struct Entry
+{
+    const char *phase_;
+    const char *subject_;
+    unsigned int depth_;
+    std::chrono::steady_clock::time_point begin_;
+    std::chrono::steady_clock::time_point end_;
+    bool is_finished_;
+};
+
+/*!
+ * Fixed-size list of startup phases.
+ *
+ * Phases beyond capacity are not recorded.
+ *
+ * This class is not thread-safe.
+ */
+template <size_t N>
+class Timeline
+{
+  public:
+    static constexpr size_t INVALID_INDEX = std::numeric_limits<size_t>::max();
+
+  private:
+    std::array<Entry, N> entries_;
+    size_t count_;
+    unsigned int depth_;
+
+  public:
+    Timeline(const Timeline &) = delete;
+    Timeline &operator=(const Timeline &) = delete;
+
+    explicit Timeline(): count_(0), depth_(0) {}
+
+    static constexpr size_t capacity() { return N; }
+
+    size_t size() const { return count_; }
+
+    size_t begin(const char *phase, const char *subject,
+                 std::chrono::steady_clock::time_point now)
+    {
+        const unsigned int depth = depth_++;
+
+        if(count_ >= N)
+            return INVALID_INDEX;
+
+        auto &e(entries_[count_]);
+        e.phase_ = phase;
+        e.subject_ = subject;
+        e.depth_ = depth;
+        e.begin_ = now;
+        e.end_ = now;
+        e.is_finished_ = false;
+
+        return count_++;
+    }
+
+    void end(size_t idx, std::chrono::steady_clock::time_point now)
+    {
+        if(depth_ > 0)
+            --depth_;
+
+        if(idx >= count_)
+            return;
+
+        entries_[idx].end_ = now;
+        entries_[idx].is_finished_ = true;
+    }
+
+    /*!
+     * Call \p fn for each recorded phase in order of their beginning.
+     */
+    template <typename F>
+    void for_each(const F &fn) const
+    {
+        for(size_t i = 0; i < count_; ++i)
+            fn(entries_[i]);
+    }
+};
+
+/*!
+ * Store begin of a phase in the global timeline.
+ *
+ * \param phase
+ *     Name of the phase, must remain valid for the lifetime of the program.
+ * \param subject
+ *     Optional name of the object the phase applies to, such as a view
+ *     name. Must remain valid for the lifetime of the program.
+ *
+ * \returns
+ *     Index to be passed to #BootTimeline::end().
+ */
+size_t begin(const char *phase, const char *subject = nullptr);
+
+/*!
+ * Store end of a phase in the global timeline.
+ */
+void end(size_t idx);
+
+/*!
+ * Record end of startup, write timeline to the log if verbose enough.
+ */
+void startup_completed();
+
+/*!
+ * Return global timeline as human-readable text, one phase per line.
+ */
+std::string dump();
+
+/*!
+ * Record a phase for the lifetime of an object of this class.
+ */
+class Phase
+{
+  private:
+    const size_t idx_;
+
+  public:
+    Phase(const Phase &) = delete;
+    Phase &operator=(const Phase &) = delete;
+
+    explicit Phase(const char *phase, const char *subject = nullptr):
+        idx_(begin(phase, subject))
+    {}
+
+    ~Phase() { end(idx_); }
+};
+
+}
+
+/*!@}*/
+
+#endif /* !BOOT_TIMELINE_HH */
@@ -259,6 +259,9 @@ enum class CacheSegmentState
 
     /*! Cached in center, mix of other states at top and bottom. */
     CACHED_CENTER,
+
+    /*! Top and bottom segments are cached, center is empty. */
+    CACHED_TOP_AND_BOTTOM_EMPTY_CENTER,
 };
 
 }
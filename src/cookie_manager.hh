@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2019, 2020, 2021  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2019, 2020, 2021, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -52,6 +52,22 @@ class CookieManagerIface
             const void *proxy, uint32_t cookie,
             NotifyByCookieFn &&notify, FetchByCookieFn &&fetch) = 0;
     virtual bool abort_cookie(const void *proxy, uint32_t cookie) = 0;
+
+    /*!
+     * An asynchronous request has been sent, its cookie is not known yet.
+     *
+     * Notifications about cookies which are not known must be kept until the
+     * corresponding #DBusRNF::CookieManagerIface::async_request_done() call
+     * because they may belong to the answer of this request. Any kept
+     * notifications are delivered by
+     * #DBusRNF::CookieManagerIface::set_pending_cookie().
+     */
+    virtual void async_request_started(const void *proxy) = 0;
+
+    /*!
+     * The answer to an asynchronous request has been processed.
+     */
+    virtual void async_request_done(const void *proxy) = 0;
 };
 
 }
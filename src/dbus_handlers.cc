@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -32,6 +32,8 @@
 #include "configuration_drcpd.hh"
 #include "messages.h"
 #include "system_errors.hh"
+#include "render_trace.hh"
+#include "boot_timeline.hh"
 
 #include <unordered_map>
 
@@ -1169,3 +1171,34 @@ gboolean dbusmethod_config_set_multiple_values(tdbusConfigurationWrite *object,
 
     return TRUE;
 }
+
+/*!
+ * Intercept requests for dumping the render trace or the boot timeline.
+ *
+ * The pseudo level names #RenderTrace::DUMP_REQUEST and
+ * #BootTimeline::DUMP_REQUEST are not verbosity levels, so they are handled
+ * here without changing the verbosity. All other requests are passed on to
+ * the generic handler connected after this one.
+ *
+ * The render trace or boot timeline is returned to the caller in place of
+ * the level name.
+ */
+gboolean dbusmethod_debug_level(tdbusdebugLogging *object,
+                                GDBusMethodInvocation *invocation,
+                                const gchar *arg_new_level,
+                                gpointer user_data)
+{
+    if(arg_new_level == nullptr)
+        return FALSE;
+
+    if(strcmp(arg_new_level, RenderTrace::DUMP_REQUEST) == 0)
+        tdbus_debug_logging_complete_debug_level(
+            object, invocation, RenderTrace::dump().c_str());
+    else if(strcmp(arg_new_level, BootTimeline::DUMP_REQUEST) == 0)
+        tdbus_debug_logging_complete_debug_level(
+            object, invocation, BootTimeline::dump().c_str());
+    else
+        return FALSE;
+
+    return TRUE;
+}
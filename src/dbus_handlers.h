@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015--2019, 2021, 2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015--2019, 2021, 2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -26,6 +26,7 @@
 
 #include "de_tahifi_audiopath.h"
 #include "de_tahifi_configuration.h"
+#include "de_tahifi_debug.h"
 
 /*!
  * \addtogroup dbus_handlers DBus handlers for signals
@@ -110,6 +111,11 @@ gboolean dbusmethod_config_set_multiple_values(tdbusConfigurationWrite *object,
                                                const char *origin, GVariant *values,
                                                gpointer user_data);
 
+gboolean dbusmethod_debug_level(tdbusdebugLogging *object,
+                                GDBusMethodInvocation *invocation,
+                                const gchar *arg_new_level,
+                                gpointer user_data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015--2019, 2021, 2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015--2019, 2021, 2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -34,6 +34,22 @@
 #include "messages.h"
 #include "messages_dbus.h"
 #include "logged_lock.hh"
+#include "boot_timeline.hh"
+
+#include <memory>
+
+/*!
+ * Bookkeeping for D-Bus proxies created concurrently during startup.
+ *
+ * Creating a proxy involves a round trip to fetch its properties, so we
+ * request all proxies at once and wait only for the slowest one instead of
+ * waiting for each of them in turn.
+ */
+struct PendingProxies
+{
+    unsigned int pending;
+    unsigned int failed;
+};
 
 struct DBusData
 {
@@ -72,6 +88,8 @@ struct DBusData
 
     tdbusdebugLogging *debug_logging_iface;
     tdbusdebugLoggingConfig *debug_logging_config_proxy;
+
+    PendingProxies pending_proxies;
 };
 
 struct ProcessData
@@ -138,6 +156,9 @@ static void bus_acquired(GDBusConnection *connection,
     g_signal_connect(data.configuration_write_iface, "handle-set-multiple-values",
                      G_CALLBACK(dbusmethod_config_set_multiple_values), data.handler_data);
 
+    g_signal_connect(data.debug_logging_iface,
+                     "handle-debug-level",
+                     G_CALLBACK(dbusmethod_debug_level), nullptr);
     g_signal_connect(data.debug_logging_iface,
                      "handle-debug-level",
                      G_CALLBACK(msg_dbus_handle_debug_level), nullptr);
@@ -167,63 +188,145 @@ static void dcpd_appeared(GDBusConnection *connection, const gchar *name,
                           const gchar *name_owner, gpointer user_data)
 {
     auto &data = *static_cast<DBusData *>(user_data);
-    GErrorWrapper error;
 
-    tdbus_configuration_proxy_call_register(data.configuration_proxy,
-                                            "drcpd", "/de/tahifi/Drcpd",
-                                            nullptr, nullptr, error.await());
-    error.log_failure("Register configuration proxy");
+    if(data.configuration_proxy != nullptr)
+    {
+        GErrorWrapper error;
+        tdbus_configuration_proxy_call_register(data.configuration_proxy,
+                                                "drcpd", "/de/tahifi/Drcpd",
+                                                nullptr, nullptr, error.await());
+        error.log_failure("Register configuration proxy");
+    }
+    else
+        msg_error(0, LOG_ERR,
+                  "Cannot register with dcpd, have no configuration proxy");
 
     g_bus_unwatch_name(data.bus_watch_dcpd);
     data.bus_watch_dcpd = 0;
 }
 
+/*!
+ * Register with dcpd as soon as it shows up on the bus.
+ *
+ * Must be called only after all proxies have been created because the initial
+ * callback of the watch may be invoked by any following main loop iteration.
+ */
+static void watch_for_dcpd(DBusData &data)
+{
+    if(data.configuration_proxy == nullptr)
+    {
+        msg_error(0, LOG_ERR,
+                  "Cannot register with dcpd, have no configuration proxy");
+        return;
+    }
+
+    auto *proxy = G_DBUS_PROXY(data.configuration_proxy);
+
+    data.bus_watch_dcpd =
+        g_bus_watch_name_on_connection(g_dbus_proxy_get_connection(proxy),
+                                       g_dbus_proxy_get_name(proxy),
+                                       G_BUS_NAME_WATCHER_FLAGS_NONE,
+                                       dcpd_appeared, nullptr,
+                                       &data, nullptr);
+}
+
+template <typename T>
+class ProxyRequest
+{
+  public:
+    using NewFn = void (*)(GDBusConnection *, GDBusProxyFlags,
+                           const gchar *, const gchar *, GCancellable *,
+                           GAsyncReadyCallback, gpointer);
+    using FinishFn = T *(*)(GAsyncResult *, GError **);
+
+  private:
+    T *&proxy_;
+    const FinishFn finish_fn_;
+    const char *const what_;
+    PendingProxies &pending_;
+
+  public:
+    ProxyRequest(const ProxyRequest &) = delete;
+    ProxyRequest &operator=(const ProxyRequest &) = delete;
+
+    explicit ProxyRequest(T *&proxy, FinishFn finish_fn, const char *what,
+                          PendingProxies &pending):
+        proxy_(proxy),
+        finish_fn_(finish_fn),
+        what_(what),
+        pending_(pending)
+    {}
+
+    static void start(GDBusConnection *connection, GDBusProxyFlags flags,
+                      const char *bus_name, const char *object_path,
+                      NewFn new_fn, FinishFn finish_fn, T *&proxy,
+                      const char *what, PendingProxies &pending)
+    {
+        proxy = nullptr;
+        ++pending.pending;
+        new_fn(connection, flags, bus_name, object_path, nullptr, done,
+               new ProxyRequest(proxy, finish_fn, what, pending));
+    }
+
+  private:
+    static void done(GObject *source_object, GAsyncResult *res,
+                     gpointer user_data)
+    {
+        std::unique_ptr<ProxyRequest> req(static_cast<ProxyRequest *>(user_data));
+        GErrorWrapper error;
+
+        req->proxy_ = req->finish_fn_(res, error.await());
+
+        if(error.log_failure(req->what_))
+            ++req->pending_.failed;
+
+        msg_log_assert(req->pending_.pending > 0);
+        --req->pending_.pending;
+    }
+};
+
+template <typename T>
+static inline void
+create_proxy(GDBusConnection *connection, DBusData &data, GDBusProxyFlags flags,
+             const char *bus_name, const char *object_path,
+             typename ProxyRequest<T>::NewFn new_fn,
+             typename ProxyRequest<T>::FinishFn finish_fn,
+             T *&proxy, const char *what)
+{
+    ProxyRequest<T>::start(connection, flags, bus_name, object_path,
+                           new_fn, finish_fn, proxy, what,
+                           data.pending_proxies);
+}
+
 static void connect_signals_dcpd(GDBusConnection *connection,
                                  DBusData &data, GDBusProxyFlags flags,
                                  const char *bus_name, const char *object_path)
 {
-    GErrorWrapper error;
-
-    data.dcpd_playback_proxy =
-        tdbus_dcpd_playback_proxy_new_sync(connection, flags,
-                                           bus_name, object_path,
-                                           nullptr, error.await());
-    error.log_failure("Create playback proxy");
-
-    data.dcpd_views_proxy =
-        tdbus_dcpd_views_proxy_new_sync(connection, flags,
-                                        bus_name, object_path,
-                                        nullptr, error.await());
-    error.log_failure("Create views proxy");
-
-    data.dcpd_list_navigation_proxy =
-        tdbus_dcpd_list_navigation_proxy_new_sync(connection, flags,
-                                                  bus_name, object_path,
-                                                  nullptr, error.await());
-    error.log_failure("Create own navigation proxy");
-
-    data.dcpd_list_item_proxy =
-        tdbus_dcpd_list_item_proxy_new_sync(connection, flags,
-                                            bus_name, object_path,
-                                            nullptr, error.await());
-    error.log_failure("Create list item proxy");
-
-    data.configuration_proxy =
-        tdbus_configuration_proxy_proxy_new_sync(connection, flags,
-                                                 bus_name, object_path,
-                                                 nullptr, error.await());
-    error.log_failure("Create configuration proxy");
+    create_proxy(connection, data, flags, bus_name, object_path,
+                 tdbus_dcpd_playback_proxy_new,
+                 tdbus_dcpd_playback_proxy_new_finish,
+                 data.dcpd_playback_proxy, "Create playback proxy");
+    create_proxy(connection, data, flags, bus_name, object_path,
+                 tdbus_dcpd_views_proxy_new,
+                 tdbus_dcpd_views_proxy_new_finish,
+                 data.dcpd_views_proxy, "Create views proxy");
+    create_proxy(connection, data, flags, bus_name, object_path,
+                 tdbus_dcpd_list_navigation_proxy_new,
+                 tdbus_dcpd_list_navigation_proxy_new_finish,
+                 data.dcpd_list_navigation_proxy, "Create own navigation proxy");
+    create_proxy(connection, data, flags, bus_name, object_path,
+                 tdbus_dcpd_list_item_proxy_new,
+                 tdbus_dcpd_list_item_proxy_new_finish,
+                 data.dcpd_list_item_proxy, "Create list item proxy");
+    create_proxy(connection, data, flags, bus_name, object_path,
+                 tdbus_configuration_proxy_proxy_new,
+                 tdbus_configuration_proxy_proxy_new_finish,
+                 data.configuration_proxy, "Create configuration proxy");
 
     data.debug_logging_config_proxy = nullptr;
     tdbus_debug_logging_config_proxy_new(connection, flags,
                                          bus_name, object_path, nullptr,
                                          created_debug_config_proxy, &data);
-
-    data.bus_watch_dcpd =
-        g_bus_watch_name_on_connection(connection, bus_name,
-                                       G_BUS_NAME_WATCHER_FLAGS_NONE,
-                                       dcpd_appeared, nullptr,
-                                       &data, nullptr);
 }
 
 static void connect_signals_rest_api(GDBusConnection *connection,
@@ -232,33 +335,27 @@ static void connect_signals_rest_api(GDBusConnection *connection,
                                      const char *object_path_dcpd,
                                      const char *object_path_display)
 {
-    GErrorWrapper error;
-
-    data.rest_dcpd_playback_proxy =
-        tdbus_dcpd_playback_proxy_new_sync(connection, flags,
-                                           bus_name, object_path_dcpd,
-                                           nullptr, error.await());
-    error.log_failure("Create REST playback proxy");
-
-    data.rest_display_updates_proxy =
-        tdbus_jsonemitter_proxy_new_sync(connection, flags,
-                                         bus_name, object_path_display,
-                                         nullptr, error.await());
-    error.log_failure("Create REST playback proxy");
+    create_proxy(connection, data, flags, bus_name, object_path_dcpd,
+                 tdbus_dcpd_playback_proxy_new,
+                 tdbus_dcpd_playback_proxy_new_finish,
+                 data.rest_dcpd_playback_proxy, "Create REST playback proxy");
+    create_proxy(connection, data, flags, bus_name, object_path_display,
+                 tdbus_jsonemitter_proxy_new,
+                 tdbus_jsonemitter_proxy_new_finish,
+                 data.rest_display_updates_proxy, "Create REST display proxy");
 }
 
 static void connect_signals_list_broker(GDBusConnection *connection,
+                                        DBusData &data,
                                         tdbuslistsNavigation *&proxy,
                                         GDBusProxyFlags flags,
                                         const char *bus_name,
                                         const char *object_path)
 {
-    GErrorWrapper error;
-
-    proxy = tdbus_lists_navigation_proxy_new_sync(connection, flags,
-                                                  bus_name, object_path,
-                                                  nullptr, error.await());
-    error.log_failure("Create list broker navigation proxy");
+    create_proxy(connection, data, flags, bus_name, object_path,
+                 tdbus_lists_navigation_proxy_new,
+                 tdbus_lists_navigation_proxy_new_finish,
+                 proxy, "Create list broker navigation proxy");
 }
 
 static void connect_signals_streamplayer(GDBusConnection *connection,
@@ -267,19 +364,14 @@ static void connect_signals_streamplayer(GDBusConnection *connection,
                                          const char *bus_name,
                                          const char *object_path)
 {
-    GErrorWrapper error;
-
-    data.splay_urlfifo_proxy =
-        tdbus_splay_urlfifo_proxy_new_sync(connection, flags,
-                                           bus_name, object_path,
-                                           nullptr, error.await());
-    error.log_failure("Create URL FIFO proxy");
-
-    data.splay_playback_proxy =
-        tdbus_splay_playback_proxy_new_sync(connection, flags,
-                                            bus_name, object_path,
-                                            nullptr, error.await());
-    error.log_failure("Create stream player proxy");
+    create_proxy(connection, data, flags, bus_name, object_path,
+                 tdbus_splay_urlfifo_proxy_new,
+                 tdbus_splay_urlfifo_proxy_new_finish,
+                 data.splay_urlfifo_proxy, "Create URL FIFO proxy");
+    create_proxy(connection, data, flags, bus_name, object_path,
+                 tdbus_splay_playback_proxy_new,
+                 tdbus_splay_playback_proxy_new_finish,
+                 data.splay_playback_proxy, "Create stream player proxy");
 }
 
 static void connect_signals_roonplayer(GDBusConnection *connection,
@@ -288,55 +380,47 @@ static void connect_signals_roonplayer(GDBusConnection *connection,
                                        const char *bus_name,
                                        const char *object_path)
 {
-    GErrorWrapper error;
-
-    data.roonplayer_playback_proxy =
-        tdbus_splay_playback_proxy_new_sync(connection, flags,
-                                            bus_name, object_path,
-                                            nullptr, error.await());
-    error.log_failure("Create Roon player proxy");
+    create_proxy(connection, data, flags, bus_name, object_path,
+                 tdbus_splay_playback_proxy_new,
+                 tdbus_splay_playback_proxy_new_finish,
+                 data.roonplayer_playback_proxy, "Create Roon player proxy");
 }
 
 static void connect_signals_airable(GDBusConnection *connection,
+                                    DBusData &data,
                                     tdbusAirable *&proxy,
                                     GDBusProxyFlags flags,
                                     const char *bus_name,
                                     const char *object_path)
 {
-    GErrorWrapper error;
-
-    proxy = tdbus_airable_proxy_new_sync(connection, flags,
-                                         bus_name, object_path,
-                                         nullptr, error.await());
-    error.log_failure("Create Airable proxy");
+    create_proxy(connection, data, flags, bus_name, object_path,
+                 tdbus_airable_proxy_new, tdbus_airable_proxy_new_finish,
+                 proxy, "Create Airable proxy");
 }
 
 static void connect_signals_audiopath(GDBusConnection *connection,
+                                      DBusData &data,
                                       tdbusaupathManager *&proxy,
                                       GDBusProxyFlags flags,
                                       const char *bus_name,
                                       const char *object_path)
 {
-    GErrorWrapper error;
-
-    proxy = tdbus_aupath_manager_proxy_new_sync(connection, flags,
-                                                bus_name, object_path,
-                                                nullptr, error.await());
-    error.log_failure("Create audio path manager proxy");
+    create_proxy(connection, data, flags, bus_name, object_path,
+                 tdbus_aupath_manager_proxy_new,
+                 tdbus_aupath_manager_proxy_new_finish,
+                 proxy, "Create audio path manager proxy");
 }
 
 static void connect_signals_errors(GDBusConnection *connection,
+                                   DBusData &data,
                                    tdbusErrors *&proxy,
                                    GDBusProxyFlags flags,
                                    const char *bus_name,
                                    const char *object_path)
 {
-    GErrorWrapper error;
-
-    proxy = tdbus_errors_proxy_new_sync(connection, flags,
-                                        bus_name, object_path,
-                                        nullptr, error.await());
-    error.log_failure("Create Errors proxy");
+    create_proxy(connection, data, flags, bus_name, object_path,
+                 tdbus_errors_proxy_new, tdbus_errors_proxy_new_finish,
+                 proxy, "Create Errors proxy");
 }
 
 static void name_acquired(GDBusConnection *connection,
@@ -353,15 +437,15 @@ static void name_acquired(GDBusConnection *connection,
                              "de.tahifi.REST",
                              "/de/tahifi/REST_DCPD",
                              "/de/tahifi/REST_DISPLAY");
-    connect_signals_list_broker(connection,
+    connect_signals_list_broker(connection, data,
                                 data.filebroker_lists_navigation_proxy,
                                 G_DBUS_PROXY_FLAGS_NONE,
                                 "de.tahifi.FileBroker", "/de/tahifi/FileBroker");
-    connect_signals_list_broker(connection,
+    connect_signals_list_broker(connection, data,
                                 data.airablebroker_lists_navigation_proxy,
                                 G_DBUS_PROXY_FLAGS_NONE,
                                 "de.tahifi.TuneInBroker", "/de/tahifi/TuneInBroker");
-    connect_signals_list_broker(connection,
+    connect_signals_list_broker(connection, data,
                                 data.upnpbroker_lists_navigation_proxy,
                                 G_DBUS_PROXY_FLAGS_NONE,
                                 "de.tahifi.UPnPBroker", "/de/tahifi/UPnPBroker");
@@ -369,13 +453,13 @@ static void name_acquired(GDBusConnection *connection,
                                  "de.tahifi.Streamplayer", "/de/tahifi/Streamplayer");
     connect_signals_roonplayer(connection, data, G_DBUS_PROXY_FLAGS_NONE,
                                "de.tahifi.Roon", "/de/tahifi/Roon");
-    connect_signals_airable(connection, data.airable_sec_proxy,
+    connect_signals_airable(connection, data, data.airable_sec_proxy,
                             G_DBUS_PROXY_FLAGS_NONE,
                             "de.tahifi.TuneInBroker", "/de/tahifi/TuneInBroker");
-    connect_signals_errors(connection, data.airable_errors_proxy,
+    connect_signals_errors(connection, data, data.airable_errors_proxy,
                            G_DBUS_PROXY_FLAGS_NONE,
                            "de.tahifi.TuneInBroker", "/de/tahifi/TuneInBroker");
-    connect_signals_audiopath(connection, data.audiopath_manager_proxy,
+    connect_signals_audiopath(connection, data, data.audiopath_manager_proxy,
                               G_DBUS_PROXY_FLAGS_NONE,
                               "de.tahifi.TAPSwitch", "/de/tahifi/TAPSwitch");
 }
@@ -458,6 +542,8 @@ static ProcessData process_data;
 int DBus::setup(bool connect_to_session_bus,
                 void *dbus_signal_data_for_dbus_handlers)
 {
+    BootTimeline::Phase phase("DBus::setup");
+
 #if !GLIB_CHECK_VERSION(2, 36, 0)
     g_type_init();
 #endif
@@ -500,6 +586,20 @@ int DBus::setup(bool connect_to_session_bus,
         return -1;
     }
 
+    /* proxies are being created concurrently, wait for all of them */
+    {
+        BootTimeline::Phase proxies_phase("wait for D-Bus proxies");
+
+        while(dbus_data.pending_proxies.pending > 0)
+            g_main_context_iteration(process_data.ctx, TRUE);
+    }
+
+    if(dbus_data.pending_proxies.failed > 0)
+        msg_error(0, LOG_ERR, "Failed creating %u D-Bus proxies",
+                  dbus_data.pending_proxies.failed);
+
+    watch_for_dcpd(dbus_data);
+
     msg_log_assert(dbus_data.dcpd_playback_proxy != nullptr);
     msg_log_assert(dbus_data.dcpd_views_proxy != nullptr);
     msg_log_assert(dbus_data.dcpd_list_navigation_proxy != nullptr);
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015--2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015--2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -306,13 +306,29 @@ void List::DBusList::list_invalidate(ID::List list_id, ID::List replacement_id)
 
         if(replacement_id.is_valid())
         {
+            item_cache_->rekey(list_id, replacement_id);
+
+            if(prefix_index_ != nullptr)
+                prefix_index_->rekey(list_id, replacement_id);
+
             for(auto &vp : viewports_and_fetchers_)
+            {
+                vp.first->rekey(list_id, replacement_id);
+
                 if(vp.second != nullptr)
                     vp.second->cancel_op();
+            }
         }
         else
+        {
             for(auto &vp : viewports_and_fetchers_)
                 vp.first->clear_for_line(0);
+
+            item_cache_->forget_list(list_id);
+
+            if(prefix_index_ != nullptr)
+                prefix_index_->forget_list(list_id);
+        }
     }
 
     QueryContextEnterList::restart_if_necessary(enter_list_data_.query_,
@@ -551,23 +567,86 @@ void List::DBusList::add_referrer(std::shared_ptr<DBusListViewport> vp)
 }
 
 static void update_viewport_cache(List::DBusListViewport &viewport,
+                                  ID::List list_id,
                                   const DBusRNF::GetRangeResult &result,
                                   const List::DBusListViewport::NewItemFn &new_item_fn)
 {
     viewport.locked(
-        [&result, &new_item_fn] (auto &vp)
+        [list_id, &result, &new_item_fn] (auto &vp)
         {
-            const unsigned int beginning_of_gap = vp.prepare_update();
-
             if(result.have_meta_data_)
                 vp.update_cache_region_with_meta_data(
-                        new_item_fn, beginning_of_gap, result.list_);
+                        new_item_fn, list_id, result.first_item_id_,
+                        result.list_);
             else
                 vp.update_cache_region_simple(
-                        new_item_fn, beginning_of_gap, result.list_);
+                        new_item_fn, list_id, result.first_item_id_,
+                        result.list_);
         });
 }
 
+void List::DBusList::update_prefix_index(ID::List list_id,
+                                         const DBusRNF::GetRangeResult &result)
+{
+    if(prefix_index_ == nullptr || list_id != list_id_)
+        return;
+
+    const unsigned int count = g_variant_n_children(GVariantWrapper::get(result.list_));
+
+    for(unsigned int i = 0; i < count; ++i)
+    {
+        const unsigned int line = result.first_item_id_ + i;
+        const auto *item =
+            dynamic_cast<const List::SearchableItem *>(item_cache_->lookup(list_id, line));
+
+        if(item == nullptr)
+            continue;
+
+        const auto &key(item->get_search_key());
+        prefix_index_->put(list_id, number_of_items_, line,
+                           key.codepoints(), key.length());
+    }
+}
+
+bool List::DBusList::lookup_in_prefix_index(const Search::Key &query,
+                                            ssize_t &line) const
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::RecMutex> lk(lock_);
+
+    if(prefix_index_ == nullptr || query.empty())
+        return false;
+
+    const auto result =
+        prefix_index_->lookup(list_id_, number_of_items_,
+                              query.codepoints(), query.length(), line);
+
+    switch(result)
+    {
+      case Search::PrefixIndex::LookupResult::FOUND:
+        return true;
+
+      case Search::PrefixIndex::LookupResult::NOT_INDEXED:
+      case Search::PrefixIndex::LookupResult::QUERY_TOO_LONG:
+        break;
+
+      case Search::PrefixIndex::LookupResult::INCOMPLETE:
+        msg_vinfo(MESSAGE_LEVEL_DIAG,
+                  "Prefix index covers %u of %u lines [%s]",
+                  prefix_index_->get_number_of_known_lines(),
+                  number_of_items_, list_iface_name_.c_str());
+        break;
+
+      case Search::PrefixIndex::LookupResult::UNSORTED:
+        msg_vinfo(MESSAGE_LEVEL_DIAG,
+                  "Prefix index not usable, list %u not sorted [%s]",
+                  list_id_.get_raw_id(), list_iface_name_.c_str());
+        break;
+    }
+
+    return false;
+}
+
 const List::Item *
 List::DBusList::get_item(std::shared_ptr<DBusListViewport> vp, unsigned int line)
 {
@@ -596,20 +675,25 @@ List::DBusList::get_item(std::shared_ptr<DBusListViewport> vp, unsigned int line
     }
 
     unsigned int cached_lines_count;
-    vp->set_view(line, vp->get_default_view_size(), get_number_of_items(),
-                 cached_lines_count);
-
-    Segment missing(vp->get_missing_segment());
+    if(vp->set_view(list_id_, line, vp->get_default_view_size(),
+                    get_number_of_items(),
+                    cached_lines_count) == CacheSegmentState::CACHED)
+        return vp->item_at(line).first;
 
     try
     {
-        const auto expected_size = missing.size();
-        const DBusRNF::GetRangeResult result(
-            fetch_window_sync(cm_, dbus_proxy_, list_iface_name_, list_contexts_,
-                              list_id_, std::move(missing)));
-
-        msg_log_assert(g_variant_n_children(GVariantWrapper::get(result.list_)) == expected_size);
-        update_viewport_cache(*vp, result, new_item_fn_);
+        /* cached lines between gaps are not fetched again */
+        for(auto &missing : vp->get_missing_segments())
+        {
+            const auto expected_size = missing.size();
+            const DBusRNF::GetRangeResult result(
+                fetch_window_sync(cm_, dbus_proxy_, list_iface_name_, list_contexts_,
+                                  list_id_, std::move(missing)));
+
+            msg_log_assert(g_variant_n_children(GVariantWrapper::get(result.list_)) == expected_size);
+            update_viewport_cache(*vp, list_id_, result, new_item_fn_);
+            update_prefix_index(list_id_, result);
+        }
     }
     catch(const std::exception &e)
     {
@@ -625,6 +709,85 @@ List::DBusList::get_item(std::shared_ptr<DBusListViewport> vp, unsigned int line
     return vp->item_at(line).first;
 }
 
+void List::DBusList::get_items_concurrently(
+        const std::vector<std::shared_ptr<DBusListViewport>> &vps,
+        const std::vector<unsigned int> &lines)
+{
+    msg_log_assert(vps.size() >= lines.size());
+
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::RecMutex> lk(lock_);
+
+    msg_log_assert(list_id_.is_valid());
+
+    const uint32_t list_flags(list_contexts_[DBUS_LISTS_CONTEXT_GET(list_id_.get_raw_id())].get_flags());
+    const bool with_meta_data =
+        (list_flags & List::ContextInfo::HAS_EXTERNAL_META_DATA) != 0;
+
+    std::vector<std::pair<size_t, std::shared_ptr<DBusRNF::GetRangeCallBase>>> calls;
+
+    for(size_t i = 0; i < lines.size(); ++i)
+    {
+        if(lines[i] >= number_of_items_)
+            continue;
+
+        unsigned int cached_lines_count;
+        if(vps[i]->set_view(list_id_, lines[i], 1, number_of_items_,
+                            cached_lines_count) == CacheSegmentState::CACHED)
+            continue;
+
+        calls.emplace_back(i, mk_get_range_rnf_call(list_id_, with_meta_data,
+                                                    vps[i]->get_missing_segment(),
+                                                    nullptr, nullptr));
+    }
+
+    if(calls.empty())
+        return;
+
+    msg_info("Fetch %zu single lines of list %u (concurrently) [%s]",
+             calls.size(), list_id_.get_raw_id(), list_iface_name_.c_str());
+
+    /* answers are dispatched to a private main context so that we can wait
+     * for them without processing any unrelated events */
+    GMainContext *ctx = g_main_context_new();
+    g_main_context_push_thread_default(ctx);
+
+    for(const auto &c : calls)
+        c.second->request_async();
+
+    while(std::any_of(calls.begin(), calls.end(),
+                      [] (const auto &c) { return c.second->is_request_in_flight(); }))
+        g_main_context_iteration(ctx, TRUE);
+
+    g_main_context_pop_thread_default(ctx);
+    g_main_context_unref(ctx);
+
+    for(const auto &c : calls)
+    {
+        try
+        {
+            c.second->fetch_blocking();
+            const DBusRNF::GetRangeResult result(c.second->get_result_locked());
+            update_viewport_cache(*vps[c.first], list_id_, result, new_item_fn_);
+            update_prefix_index(list_id_, result);
+        }
+        catch(const std::exception &e)
+        {
+            msg_error(0, LOG_NOTICE,
+                      "Failed fetching line %u of list %u: %s [%s]",
+                      lines[c.first], list_id_.get_raw_id(), e.what(),
+                      list_iface_name_.c_str());
+        }
+        catch(...)
+        {
+            msg_error(0, LOG_NOTICE,
+                      "Failed fetching line %u of list %u [%s]",
+                      lines[c.first], list_id_.get_raw_id(),
+                      list_iface_name_.c_str());
+        }
+    }
+}
+
 enum class AnnounceResult
 {
     REGISTERED_AND_CLEARED_VIEWPORT,
@@ -660,12 +823,86 @@ announce_viewport(List::DBusList::ViewportsAndFetchersMap &vfm,
         return AnnounceResult::FILLER_UP_TO_DATE;
     }
 
-    /* viewport is known, filler is out of date */
-    vf->second->cancel_op();
+    /* viewport is known, filler is out of date; in case other viewports are
+     * waiting for the filler's results, the RNF operation is left running
+     * for them */
+    if(!vf->second->has_followers())
+        vf->second->cancel_op();
+
     vf->second = nullptr;
     return AnnounceResult::CANCELED_OLD_FILLER;
 }
 
+/*!
+ * Find fetcher of another viewport which is loading lines we are missing.
+ *
+ * In case a fetcher is found, \p missing is trimmed down to the part not
+ * covered by that fetcher's RNF operation. Only fetchers which cover either
+ * all of \p missing or its top or bottom part are considered so that the
+ * remaining lines can be loaded by a single RNF operation.
+ */
+static std::shared_ptr<List::DBusListSegmentFetcher>
+find_leader(const List::DBusList::ViewportsAndFetchersMap &vfm,
+            const std::shared_ptr<List::DBusListViewport> &viewport,
+            ID::List list_id, List::Segment &missing)
+{
+    std::shared_ptr<List::DBusListSegmentFetcher> leader;
+    List::Segment remainder;
+    unsigned int best_overlap = 0;
+
+    for(const auto &vf : vfm)
+    {
+        if(vf.first == viewport || vf.second == nullptr)
+            continue;
+
+        const auto q(vf.second->get_query_in_flight());
+
+        if(q == nullptr || q->list_id_ != list_id)
+            continue;
+
+        unsigned int overlap;
+
+        switch(missing.intersection(q->loading_segment_, overlap))
+        {
+          case List::SegmentIntersection::DISJOINT:
+          case List::SegmentIntersection::CENTER_REMAINS:
+            continue;
+
+          case List::SegmentIntersection::EQUAL:
+          case List::SegmentIntersection::INCLUDED_IN_OTHER:
+            if(overlap > best_overlap)
+                remainder = List::Segment(missing.line(), 0);
+
+            break;
+
+          case List::SegmentIntersection::TOP_REMAINS:
+            if(overlap > best_overlap)
+                remainder = List::Segment(missing.line() + overlap,
+                                          missing.size() - overlap);
+
+            break;
+
+          case List::SegmentIntersection::BOTTOM_REMAINS:
+            if(overlap > best_overlap)
+                remainder = List::Segment(missing.line(),
+                                          missing.size() - overlap);
+
+            break;
+        }
+
+        if(overlap > best_overlap)
+        {
+            best_overlap = overlap;
+            leader = vf.second;
+        }
+    }
+
+    if(leader != nullptr)
+        missing = remainder;
+
+    return leader;
+}
+
 void List::DBusList::detach_viewport(std::shared_ptr<DBusListViewport> vp)
 {
     msg_log_assert(vp != nullptr);
@@ -783,7 +1020,8 @@ List::DBusList::get_item_async_set_hint(std::shared_ptr<DBusListViewport> vp,
     }
 
     unsigned int cached_lines_count;
-    const auto segment_state = vp->set_view(line, count, number_of_items_,
+    const auto segment_state = vp->set_view(list_id_, line, count,
+                                            number_of_items_,
                                             cached_lines_count);
 
     switch(segment_state)
@@ -808,6 +1046,11 @@ List::DBusList::get_item_async_set_hint(std::shared_ptr<DBusListViewport> vp,
          * canceled and ignored */
         break;
 
+      case CacheSegmentState::CACHED_TOP_AND_BOTTOM_EMPTY_CENTER:
+        /* need to start loading the gap in the middle, any other load
+         * operation can be canceled and ignored */
+        break;
+
       case CacheSegmentState::CACHED:
         /* everything is there already */
         return OpResult::SUCCEEDED;
@@ -819,30 +1062,46 @@ List::DBusList::get_item_async_set_hint(std::shared_ptr<DBusListViewport> vp,
         return OpResult::STARTED;
     }
 
-    auto fetcher = std::make_shared<DBusListSegmentFetcher>(vp);
+    auto fetcher =
+        std::make_shared<DBusListSegmentFetcher>(vp, std::move(hinted_fn));
+    Segment missing(vp->get_missing_segment());
+    const auto leader(find_leader(viewports_and_fetchers_, vp, list_id_, missing));
 
-    fetcher->prepare(
-        // #List::DBusListSegmentFetcher::MkGetRangeRNFCall
-        [this, status_watcher = std::move(status_watcher)]
-        (Segment &&missing, std::unique_ptr<QueryContextGetItem> ctx) mutable
-        {
-            const auto flags =
-                list_contexts_[DBUS_LISTS_CONTEXT_GET(list_id_.get_raw_id())]
-                .get_flags();
-            const bool with_meta_data =
-                (flags & List::ContextInfo::HAS_EXTERNAL_META_DATA) != 0;
-
-            return mk_get_range_rnf_call(list_id_, with_meta_data,
-                                         std::move(missing), std::move(ctx),
-                                         std::move(status_watcher));
-        },
-
-        // #List::DBusListSegmentFetcher::DoneFn
-        [this, hinted_fn = std::move(hinted_fn)]
-        (DBusListSegmentFetcher &sf) mutable
-        {
-            get_item_result_available_notification(sf, std::move(hinted_fn));
-        });
+    if(leader != nullptr)
+    {
+        msg_vinfo(MESSAGE_LEVEL_DIAG,
+                  "Viewport %p joins get-range operation %p, "
+                  "loading %u remaining lines on its own [%s]",
+                  static_cast<const void *>(vp.get()),
+                  static_cast<const void *>(leader->query().get()),
+                  missing.size(), list_iface_name_.c_str());
+        fetcher->follow(*leader);
+    }
+
+    if(!missing.empty())
+        fetcher->prepare(
+            std::move(missing),
+
+            // #List::DBusListSegmentFetcher::MkGetRangeRNFCall
+            [this, status_watcher = std::move(status_watcher)]
+            (Segment &&seg, std::unique_ptr<QueryContextGetItem> ctx) mutable
+            {
+                const auto flags =
+                    list_contexts_[DBUS_LISTS_CONTEXT_GET(list_id_.get_raw_id())]
+                    .get_flags();
+                const bool with_meta_data =
+                    (flags & List::ContextInfo::HAS_EXTERNAL_META_DATA) != 0;
+
+                return mk_get_range_rnf_call(list_id_, with_meta_data,
+                                             std::move(seg), std::move(ctx),
+                                             std::move(status_watcher));
+            },
+
+            // #List::DBusListSegmentFetcher::DoneFn
+            [this] (DBusListSegmentFetcher &sf)
+            {
+                get_item_result_available_notification(sf);
+            });
 
     viewports_and_fetchers_[vp] = fetcher;
 
@@ -914,9 +1173,9 @@ List::DBusList::get_item_async(std::shared_ptr<DBusListViewport> vp,
 
     msg_error(0, LOG_NOTICE,
               "Requested line %u out of range (%s) "
-              "(cached valid segment %u +%u, view %u +%u)",
+              "(%u cached lines in view %u +%u)",
               line, it.second ? "visible/invalid" : "invisible/invalid",
-              vp->items_segment().line(), vp->items_segment().size(),
+              vp->get_number_of_cached_lines(),
               vp->view_segment().line(), vp->view_segment().size());
     return OpResult::FAILED;
 }
@@ -939,8 +1198,45 @@ bool List::DBusList::cancel_all_async_calls()
     return false;
 }
 
+bool List::DBusList::is_current_fetcher(const DBusListViewport *viewport,
+                                        const DBusListSegmentFetcher &fetcher) const
+{
+    const auto it(std::find_if(
+        viewports_and_fetchers_.begin(), viewports_and_fetchers_.end(),
+        [viewport] (const auto &vf) { return vf.first.get() == viewport; }));
+
+    if(it == viewports_and_fetchers_.end())
+    {
+        MSG_BUG("Viewport %p not found", static_cast<const void *>(viewport));
+        return false;
+    }
+
+    return it->second.get() == &fetcher;
+}
+
+void List::DBusList::complete_fetcher_part(DBusListSegmentFetcher &fetcher,
+                                           const DBusListViewport *viewport,
+                                           OpResult op_result,
+                                           bool is_leader_query)
+{
+    auto done(fetcher.part_done(op_result, is_leader_query));
+
+    if(done.first == nullptr)
+        return;
+
+    if(is_current_fetcher(viewport, fetcher))
+    {
+        auto it(std::find_if(
+            viewports_and_fetchers_.begin(), viewports_and_fetchers_.end(),
+            [viewport] (const auto &vf) { return vf.first.get() == viewport; }));
+        it->second = nullptr;
+    }
+
+    done.first(done.second);
+}
+
 void List::DBusList::get_item_result_available_notification(
-        DBusListSegmentFetcher &fetcher, HintItemDoneNotification &&hinted_fn)
+        DBusListSegmentFetcher &fetcher)
 {
     auto call_and_viewport(fetcher.take_rnf_call_and_viewport());
     auto call(std::move(call_and_viewport.first));
@@ -949,19 +1245,20 @@ void List::DBusList::get_item_result_available_notification(
     LOGGED_LOCK_CONTEXT_HINT;
     std::lock_guard<LoggedLock::RecMutex> lk(lock_);
 
-    {
-        auto vfpair(viewports_and_fetchers_.find(viewport));
-        MSG_BUG_IF(vfpair == viewports_and_fetchers_.end(),
-                   "Viewport %p not found", static_cast<const void *>(viewport.get()));
+    auto followers(fetcher.take_followers());
+    const bool is_current = is_current_fetcher(viewport.get(), fetcher);
 
-        if(vfpair->second.get() != &fetcher)
-        {
-            msg_log_assert(hinted_fn != nullptr);
-            hinted_fn(OpResult::CANCELED);
-            return;
-        }
+    std::vector<bool> is_current_follower;
+    is_current_follower.reserve(followers.size());
+
+    for(const auto &f : followers)
+        is_current_follower.push_back(is_current_fetcher(f->get_viewport().get(), *f));
 
-        vfpair->second = nullptr;
+    if(!is_current && followers.empty())
+    {
+        complete_fetcher_part(fetcher, viewport.get(), OpResult::CANCELED,
+                              false);
+        return;
     }
 
     OpResult op_result;
@@ -970,7 +1267,16 @@ void List::DBusList::get_item_result_available_notification(
     {
         auto result(call->get_result_locked());
 
-        update_viewport_cache(*viewport, result, new_item_fn_);
+        if(is_current)
+            update_viewport_cache(*viewport, call->list_id_, result, new_item_fn_);
+
+        for(size_t i = 0; i < followers.size(); ++i)
+            if(is_current_follower[i])
+                update_viewport_cache(*followers[i]->get_viewport(),
+                                      call->list_id_, result, new_item_fn_);
+
+        update_prefix_index(call->list_id_, result);
+
         op_result = OpResult::SUCCEEDED;
     }
     catch(const DBusRNF::AbortedError &)
@@ -1004,8 +1310,13 @@ void List::DBusList::get_item_result_available_notification(
                   call->list_id_.get_raw_id(), list_iface_name_.c_str(),
                   int(op_result));
 
-    msg_log_assert(hinted_fn != nullptr);
-    hinted_fn(op_result);
+    for(size_t i = 0; i < followers.size(); ++i)
+        complete_fetcher_part(*followers[i], followers[i]->get_viewport().get(),
+                              is_current_follower[i] ? op_result : OpResult::CANCELED,
+                              true);
+
+    complete_fetcher_part(fetcher, viewport.get(),
+                          is_current ? op_result : OpResult::CANCELED, false);
 }
 
 void List::DBusList::async_done_notification(DBus::AsyncCall_ &async_call)
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015--2017, 2019, 2020, 2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015--2017, 2019, 2020, 2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -24,11 +24,14 @@
 
 #include "dbuslist_viewport.hh"
 #include "dbuslist_query_context.hh"
+#include "search_prefix_index.hh"
 #include "de_tahifi_lists.h"
 #include "context_map.hh"
 
 #include <unordered_map>
 
+namespace Search { class Key; }
+
 /*!
  * \addtogroup dbus_list Lists with contents filled directly from D-Bus
  * \ingroup list
@@ -192,6 +195,19 @@ class DBusList: public ListIface, public AsyncListIface
 
     ViewportsAndFetchersMap viewports_and_fetchers_;
 
+    /*!
+     * List items shared by all viewports created by this list.
+     */
+    const std::shared_ptr<DBusListItemCache> item_cache_;
+
+    /*!
+     * Casefolded prefixes of all lines seen, for local jump-to searches.
+     *
+     * This is \c nullptr unless enabled by
+     * #List::DBusList::enable_prefix_index().
+     */
+    std::unique_ptr<Search::PrefixIndex> prefix_index_;
+
     struct EnterListData
     {
         EnterWatcher enter_watcher_;
@@ -290,10 +306,12 @@ class DBusList: public ListIface, public AsyncListIface
                       DBusRNF::CookieManagerIface &cm,
                       tdbuslistsNavigation *nav_proxy,
                       const ContextMap &list_contexts,
-                      const DBusListViewport::NewItemFn &new_item_fn):
+                      const DBusListViewport::NewItemFn &new_item_fn,
+                      size_t item_cache_budget = DBusListItemCache::DEFAULT_BUDGET):
         list_iface_name_(std::move(list_iface_name)),
         cm_(cm),
         dbus_proxy_(nav_proxy),
+        item_cache_(std::make_shared<DBusListItemCache>(item_cache_budget)),
         list_contexts_(list_contexts),
         new_item_fn_(new_item_fn),
         number_of_items_(0)
@@ -321,9 +339,39 @@ class DBusList: public ListIface, public AsyncListIface
 
     auto mk_viewport(unsigned int prefetch, const char *which) const
     {
-        return std::make_shared<DBusListViewport>(list_iface_name_, prefetch, which);
+        return std::make_shared<DBusListViewport>(list_iface_name_, prefetch,
+                                                  which, item_cache_);
+    }
+
+    /*!
+     * Maintain a #Search::PrefixIndex for the list currently entered.
+     *
+     * The index is filled from all ranges received from the list broker.
+     */
+    void enable_prefix_index()
+    {
+        LOGGED_LOCK_CONTEXT_HINT;
+        std::lock_guard<LoggedLock::RecMutex> lk(lock_);
+
+        if(prefix_index_ == nullptr)
+            prefix_index_ = std::make_unique<Search::PrefixIndex>();
     }
 
+    /*!
+     * Try to answer jump-to query from the local prefix index.
+     *
+     * \param query
+     *     The casefolded search string.
+     *
+     * \param[out] line
+     *     The first line greater than or equal to the query.
+     *
+     * \returns
+     *     True if the query has been answered, false if the search must be
+     *     done remotely by #Search::binary_search_utf8().
+     */
+    bool lookup_in_prefix_index(const Search::Key &query, ssize_t &line) const;
+
     std::string get_get_range_op_description(const DBusListViewport &viewport) const;
     const std::string &get_list_iface_name() const override { return list_iface_name_; }
     const std::string &get_async_list_iface_name() const override { return list_iface_name_; }
@@ -359,6 +407,27 @@ class DBusList: public ListIface, public AsyncListIface
     const Item *get_item(std::shared_ptr<DBusListViewport> vp,
                          unsigned int line);
 
+    /*!
+     * Fetch single lines into several viewports with concurrent requests.
+     *
+     * All get-range requests are sent before any answer is waited for, so
+     * that the calling thread blocks for about one D-Bus round trip no matter
+     * how many lines are requested. This is meant for sampling lines spread
+     * across a large list. Results returned as cookies are waited for in
+     * parallel, but fetched one after the other.
+     *
+     * \param vps
+     *     One viewport per requested line. The view of viewport \p vps[i] is
+     *     set to line \p lines[i], with a size of 1. The viewports are not
+     *     registered with the list.
+     *
+     * \param lines
+     *     The lines to fetch. Lines which could not be fetched remain missing
+     *     from their viewports.
+     */
+    void get_items_concurrently(const std::vector<std::shared_ptr<DBusListViewport>> &vps,
+                                const std::vector<unsigned int> &lines);
+
     OpResult get_item_async(std::shared_ptr<ListViewportBase> vp,
                             unsigned int line, const Item *&item) override
     {
@@ -449,8 +518,35 @@ class DBusList: public ListIface, public AsyncListIface
      *
      * Must be called while holding #List::DBusList::lock_.
      */
-    void get_item_result_available_notification(DBusListSegmentFetcher &fetcher,
-                                                HintItemDoneNotification &&hinted_fn);
+    void get_item_result_available_notification(DBusListSegmentFetcher &fetcher);
+
+    /*!
+     * Put casefolded prefixes of freshly received items into prefix index.
+     *
+     * Must be called while holding #List::DBusList::lock_.
+     */
+    void update_prefix_index(ID::List list_id,
+                             const DBusRNF::GetRangeResult &result);
+
+    /*!
+     * Whether or not given fetcher is the active filler of given viewport.
+     *
+     * Must be called while holding #List::DBusList::lock_.
+     */
+    bool is_current_fetcher(const DBusListViewport *viewport,
+                            const DBusListSegmentFetcher &fetcher) const;
+
+    /*!
+     * Notify fetcher about completion of one of its RNF operations.
+     *
+     * The fetcher's completion notification is called as soon as all RNF
+     * operations it depends on (its own and its leader's) have completed.
+     *
+     * Must be called while holding #List::DBusList::lock_.
+     */
+    void complete_fetcher_part(DBusListSegmentFetcher &fetcher,
+                               const DBusListViewport *viewport,
+                               OpResult op_result, bool is_leader_query);
 };
 
 }
@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "dbuslist_item_cache.hh"
+
+List::DBusListItemCache::Lines &
+List::DBusListItemCache::get_lines(ID::List list_id)
+{
+    auto lines(lists_.find(list_id));
+
+    if(lines != lists_.end())
+        return lines->second;
+
+    return lists_.emplace(list_id, Lines(Lines::allocator_type(slots_)))
+        .first->second;
+}
+
+void List::DBusListItemCache::set_budget(size_t budget)
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    budget_ = budget;
+    evict_overflowing_items();
+}
+
+const List::Item *
+List::DBusListItemCache::lookup(ID::List list_id, unsigned int line) const
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    const auto lines(lists_.find(list_id));
+
+    if(lines == lists_.end())
+        return nullptr;
+
+    const auto it(lines->second.find(line));
+
+    return it != lines->second.end() ? it->second.item_.get() : nullptr;
+}
+
+bool List::DBusListItemCache::ref(ID::List list_id, unsigned int line)
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    const auto lines(lists_.find(list_id));
+
+    if(lines == lists_.end())
+        return false;
+
+    const auto it(lines->second.find(line));
+
+    if(it == lines->second.end())
+        return false;
+
+    if(it->second.refcount_++ == 0)
+        lru_.erase(it->second.lru_pos_);
+
+    return true;
+}
+
+void List::DBusListItemCache::insert(ID::List list_id, unsigned int line,
+                                     Item *item)
+{
+    msg_log_assert(item != nullptr);
+
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    auto &lines(get_lines(list_id));
+    const auto it(lines.find(line));
+
+    if(it == lines.end())
+    {
+        lines.emplace(line, Entry(item, 1));
+        return;
+    }
+
+    delete item;
+
+    if(it->second.refcount_++ == 0)
+        lru_.erase(it->second.lru_pos_);
+}
+
+void List::DBusListItemCache::stash(ID::List list_id, unsigned int line,
+                                    Item *item)
+{
+    msg_log_assert(item != nullptr);
+
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    auto &lines(get_lines(list_id));
+
+    if(lines.find(line) != lines.end())
+    {
+        delete item;
+        return;
+    }
+
+    auto it(lines.emplace(line, Entry(item, 0)).first);
+    lru_.emplace_front(list_id, line);
+    it->second.lru_pos_ = lru_.begin();
+
+    evict_overflowing_items();
+}
+
+void List::DBusListItemCache::unref_entry(Lines::iterator it, const Key &key)
+{
+    if(it->second.refcount_ == 0)
+    {
+        MSG_BUG("Dropping reference to unreferenced line %u of list %u",
+                key.second, key.first.get_raw_id());
+        return;
+    }
+
+    if(--it->second.refcount_ > 0)
+        return;
+
+    lru_.push_front(key);
+    it->second.lru_pos_ = lru_.begin();
+}
+
+void List::DBusListItemCache::unref(ID::List list_id, unsigned int line)
+{
+    unref_segment(list_id, Segment(line, 1));
+}
+
+void List::DBusListItemCache::unref_segment(ID::List list_id,
+                                            const Segment &segment)
+{
+    if(segment.empty())
+        return;
+
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    auto lines(lists_.find(list_id));
+
+    if(lines == lists_.end())
+    {
+        MSG_BUG("Dropping references to %u lines of unknown list %u",
+                segment.size(), list_id.get_raw_id());
+        return;
+    }
+
+    for(auto it(lines->second.lower_bound(segment.line()));
+        it != lines->second.end() && it->first < segment.beyond();
+        ++it)
+    {
+        unref_entry(it, Key(list_id, it->first));
+    }
+
+    evict_overflowing_items();
+}
+
+void List::DBusListItemCache::evict_overflowing_items()
+{
+    while(lru_.size() > budget_)
+    {
+        const Key &key(lru_.back());
+        auto lines(lists_.find(key.first));
+
+        msg_log_assert(lines != lists_.end());
+        lines->second.erase(key.second);
+
+        if(lines->second.empty())
+            lists_.erase(lines);
+
+        lru_.pop_back();
+    }
+}
+
+void List::DBusListItemCache::rekey(ID::List old_id, ID::List new_id)
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    if(old_id == new_id)
+        return;
+
+    auto lines(lists_.find(old_id));
+
+    if(lines == lists_.end())
+        return;
+
+    if(lists_.find(new_id) != lists_.end())
+    {
+        MSG_BUG("Cannot move cached items of list %u to list %u, "
+                "target list is cached already",
+                old_id.get_raw_id(), new_id.get_raw_id());
+        return;
+    }
+
+    auto &moved(lists_.emplace(new_id, std::move(lines->second)).first->second);
+    lists_.erase(lines);
+
+    for(auto &it : moved)
+        if(it.second.refcount_ == 0)
+            it.second.lru_pos_->first = new_id;
+}
+
+void List::DBusListItemCache::forget_list(ID::List list_id)
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    auto lines(lists_.find(list_id));
+
+    if(lines == lists_.end())
+        return;
+
+    for(auto it = lines->second.begin(); it != lines->second.end(); /* nothing */)
+    {
+        if(it->second.refcount_ == 0)
+        {
+            lru_.erase(it->second.lru_pos_);
+            it = lines->second.erase(it);
+        }
+        else
+            ++it;
+    }
+
+    if(lines->second.empty())
+        lists_.erase(lines);
+}
+
+size_t List::DBusListItemCache::size() const
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    size_t result = 0;
+
+    for(const auto &l : lists_)
+        result += l.second.size();
+
+    return result;
+}
+
+size_t List::DBusListItemCache::get_number_of_unreferenced_items() const
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+    return lru_.size();
+}
+
+size_t List::DBusListItemCache::get_number_of_free_slots() const
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+    return slots_.get_number_of_free_slots();
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#ifndef DBUSLIST_ITEM_CACHE_HH
+#define DBUSLIST_ITEM_CACHE_HH
+
+#include "list.hh"
+#include "cache_segment.hh"
+#include "idtypes.hh"
+#include "logged_lock.hh"
+#include "slot_pool.hh"
+
+#include <map>
+#include <list>
+#include <memory>
+
+namespace List
+{
+
+/*!
+ * Cache of list items shared by all viewports of a #List::DBusList.
+ *
+ * The cache stores items per list ID, keyed by line number. Each entry is
+ * reference counted: a #List::DBusListViewport takes a reference for each
+ * line it has in view and drops it again when its view segment moves away
+ * from that line. Items are constructed only once, no matter how many
+ * viewports are looking at them.
+ *
+ * Items which are not referenced by any viewport are not freed right away,
+ * but kept in least-recently-used order up to a configurable item budget.
+ * This way, the cache may hold any number of disjoint segments of a list, and
+ * going back and forth between distant positions in a long list does not
+ * require reloading the same items over and over again.
+ *
+ * The nodes of the internal line and LRU containers are taken from a
+ * #SlotPool, so that scrolling through a list reuses the bookkeeping slots
+ * of evicted items instead of allocating new ones. The items themselves are
+ * allocated by their creators since they are of arbitrary #List::Item types.
+ *
+ * This class is thread-safe.
+ */
+class DBusListItemCache
+{
+  public:
+    /*!
+     * Default number of unreferenced items kept in cache.
+     */
+    static constexpr size_t DEFAULT_BUDGET = 512;
+
+  private:
+    using Key = std::pair<ID::List, unsigned int>;
+    using LRU = std::list<Key, SlotAllocator<Key>>;
+
+    struct Entry
+    {
+        std::unique_ptr<Item> item_;
+        unsigned int refcount_;
+
+        /*! Position in LRU list, valid only if reference count is zero. */
+        LRU::iterator lru_pos_;
+
+        Entry(const Entry &) = delete;
+        Entry(Entry &&) = default;
+        Entry &operator=(const Entry &) = delete;
+
+        explicit Entry(Item *item, unsigned int refcount):
+            item_(item),
+            refcount_(refcount)
+        {}
+    };
+
+    using Lines =
+        std::map<unsigned int, Entry, std::less<unsigned int>,
+                 SlotAllocator<std::pair<const unsigned int, Entry>>>;
+
+    mutable LoggedLock::Mutex lock_;
+
+    /*!
+     * Storage for nodes of \c lists_ and \c lru_, must outlive them.
+     */
+    SlotPool slots_;
+
+    std::map<ID::List, Lines> lists_;
+
+    /*!
+     * Unreferenced items, most recently released first.
+     */
+    LRU lru_;
+
+    /*!
+     * Maximum number of unreferenced items kept in cache.
+     */
+    size_t budget_;
+
+  public:
+    DBusListItemCache(const DBusListItemCache &) = delete;
+    DBusListItemCache(DBusListItemCache &&) = delete;
+    DBusListItemCache &operator=(const DBusListItemCache &) = delete;
+    DBusListItemCache &operator=(DBusListItemCache &&) = delete;
+
+    explicit DBusListItemCache(size_t budget = DEFAULT_BUDGET):
+        lru_(SlotAllocator<Key>(slots_)),
+        budget_(budget)
+    {
+        LoggedLock::configure(lock_, "DBusListItemCache", MESSAGE_LEVEL_DEBUG);
+    }
+
+    /*!
+     * Change the number of unreferenced items kept in cache.
+     *
+     * Least recently used items are evicted if the new budget is smaller than
+     * the number of unreferenced items currently in cache.
+     */
+    void set_budget(size_t budget);
+
+    /*!
+     * Look up item without touching its reference count.
+     *
+     * The returned pointer is valid as long as the caller holds a reference
+     * to the line. Unreferenced items may be evicted by any later modification
+     * of the cache.
+     */
+    const Item *lookup(ID::List list_id, unsigned int line) const;
+
+    /*!
+     * Take a reference to an already cached item.
+     *
+     * \returns
+     *     True if the item was found in cache, false if it is not cached. In
+     *     the latter case, the caller should construct the item and pass it
+     *     to #List::DBusListItemCache::insert().
+     */
+    bool ref(ID::List list_id, unsigned int line);
+
+    /*!
+     * Put new item into cache, taking the first reference to it.
+     *
+     * The cache takes ownership of the item. In case there is an item stored
+     * for the same line already (which happens if two viewports fill in the
+     * same line at about the same time), the cached item is kept and \p item
+     * is deleted, but a reference is taken nevertheless.
+     */
+    void insert(ID::List list_id, unsigned int line, Item *item);
+
+    /*!
+     * Put new item into cache without taking a reference to it.
+     *
+     * The item is stored as most recently used unreferenced item. In case
+     * there is an item stored for the same line already, \p item is deleted.
+     */
+    void stash(ID::List list_id, unsigned int line, Item *item);
+
+    /*!
+     * Take reference to cached item, or construct and insert a new one.
+     */
+    template <typename FN>
+    void ref_or_insert(ID::List list_id, unsigned int line, const FN &mk_item)
+    {
+        if(!ref(list_id, line))
+            insert(list_id, line, mk_item());
+    }
+
+    /*!
+     * Construct and stash a new item, but only if it is not cached yet.
+     */
+    template <typename FN>
+    void stash_if_missing(ID::List list_id, unsigned int line,
+                          const FN &mk_item)
+    {
+        if(lookup(list_id, line) == nullptr)
+            stash(list_id, line, mk_item());
+    }
+
+    /*!
+     * Drop one reference to given line.
+     */
+    void unref(ID::List list_id, unsigned int line);
+
+    /*!
+     * Drop one reference to each line in given segment.
+     */
+    void unref_segment(ID::List list_id, const Segment &segment);
+
+    /*!
+     * Move all items stored for one list ID over to another list ID.
+     *
+     * This is for list invalidation with a replacement list, in which case
+     * the list broker tells us that the list content has not changed.
+     */
+    void rekey(ID::List old_id, ID::List new_id);
+
+    /*!
+     * Remove all unreferenced items of given list.
+     */
+    void forget_list(ID::List list_id);
+
+    /*!
+     * Number of items currently stored in cache.
+     */
+    size_t size() const;
+
+    /*!
+     * Number of unreferenced items currently stored in cache.
+     */
+    size_t get_number_of_unreferenced_items() const;
+
+    /*!
+     * Number of bookkeeping slots kept for reuse.
+     */
+    size_t get_number_of_free_slots() const;
+
+  private:
+    Lines &get_lines(ID::List list_id);
+    void unref_entry(Lines::iterator it, const Key &key);
+    void evict_overflowing_items();
+};
+
+}
+
+#endif /* !DBUSLIST_ITEM_CACHE_HH */
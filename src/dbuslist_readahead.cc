@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "dbuslist_readahead.hh"
+
+void List::DBusListReadAhead::update(const Nav &nav)
+{
+    const ID::List list_id(list_.get_list_id());
+
+    if(!list_id.is_valid())
+    {
+        reset();
+        return;
+    }
+
+    if(list_id != list_id_)
+    {
+        reset();
+        list_id_ = list_id;
+    }
+
+    const unsigned int total = list_.get_number_of_items();
+
+    if(total == 0)
+        return;
+
+    const Segment segment(policy_.update(nav.get_cursor_unchecked(),
+                                         *nav.begin(),
+                                         nav.maximum_number_of_displayed_lines_,
+                                         total));
+
+    if(segment.empty())
+        return;
+
+    const auto result =
+        list_.get_item_async_set_hint(
+            viewport_, segment.line(), segment.size(), nullptr,
+            [] (AsyncListIface::OpResult) {});
+
+    msg_vinfo(MESSAGE_LEVEL_TRACE,
+              "Read ahead lines %u +%u of list %u [%s], result %d",
+              segment.line(), segment.size(), list_id.get_raw_id(),
+              list_.get_list_iface_name().c_str(), int(result));
+}
+
+void List::DBusListReadAhead::reset()
+{
+    policy_.reset();
+    list_id_ = ID::List();
+}
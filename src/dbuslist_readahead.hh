@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#ifndef DBUSLIST_READAHEAD_HH
+#define DBUSLIST_READAHEAD_HH
+
+#include "dbuslist.hh"
+#include "listnav.hh"
+#include "list_readahead.hh"
+
+namespace List
+{
+
+/*!
+ * Load list items in background before they become visible.
+ *
+ * This class follows the movements of a #List::Nav object using a
+ * #List::ReadAheadPolicy, and loads the suggested segments through its own
+ * viewport of a #List::DBusList. The items end up in the item cache shared by
+ * all viewports of the list, so that the viewport used for displaying the
+ * list finds them there when the user gets to see them.
+ */
+class DBusListReadAhead
+{
+  private:
+    DBusList &list_;
+    ReadAheadPolicy policy_;
+    std::shared_ptr<DBusListViewport> viewport_;
+
+    /*!
+     * The list the policy has been following.
+     */
+    ID::List list_id_;
+
+  public:
+    DBusListReadAhead(const DBusListReadAhead &) = delete;
+    DBusListReadAhead &operator=(const DBusListReadAhead &) = delete;
+
+    explicit DBusListReadAhead(DBusList &list, unsigned int page_size,
+                               unsigned int max_pages = ReadAheadPolicy::DEFAULT_MAX_PAGES):
+        list_(list),
+        policy_(max_pages),
+        viewport_(list.mk_viewport(page_size * max_pages, "read-ahead"))
+    {}
+
+    /*!
+     * Take note of navigational state, start loading items if necessary.
+     *
+     * Should be called whenever the list is about to be displayed, right
+     * after the items to be displayed have been requested.
+     */
+    void update(const Nav &nav);
+
+    /*!
+     * Forget about previous movements.
+     *
+     * Loading operations still in progress are not canceled here. They are
+     * canceled by the #List::DBusList when entering another list, or when
+     * the next read-ahead segment is requested.
+     */
+    void reset();
+};
+
+}
+
+#endif /* !DBUSLIST_READAHEAD_HH */
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2020, 2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2020, 2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -26,43 +26,60 @@
 #include "dbuslist.hh"
 #include "main_context.hh"
 
+#include <algorithm>
+
 List::CacheSegmentState
-List::DBusListViewport::compute_overlap(const Segment &segment,
-                                        unsigned int &cached_lines_count) const
+List::DBusListViewport::compute_overlap(unsigned int &cached_lines_count) const
 {
-    CacheSegmentState cached_state = CacheSegmentState::EMPTY;
+    cached_lines_count = 0;
 
-    switch(segment.intersection(items_segment_, cached_lines_count))
-    {
-      case SegmentIntersection::DISJOINT:
-        break;
+    for(const bool is_cached : cached_lines_)
+        if(is_cached)
+            ++cached_lines_count;
 
-      case SegmentIntersection::EQUAL:
-      case SegmentIntersection::INCLUDED_IN_OTHER:
-        cached_state = CacheSegmentState::CACHED;
-        break;
+    if(cached_lines_count == 0)
+        return CacheSegmentState::EMPTY;
 
-      case SegmentIntersection::TOP_REMAINS:
-        cached_state = CacheSegmentState::CACHED_TOP_EMPTY_BOTTOM;
-        break;
+    if(cached_lines_count == cached_lines_.size())
+        return CacheSegmentState::CACHED;
 
-      case SegmentIntersection::BOTTOM_REMAINS:
-        cached_state = CacheSegmentState::CACHED_BOTTOM_EMPTY_TOP;
-        break;
+    const bool have_top = cached_lines_.front();
+    const bool have_bottom = cached_lines_.back();
 
-      case SegmentIntersection::CENTER_REMAINS:
-        cached_state = CacheSegmentState::CACHED_CENTER;
-        break;
-    }
+    if(have_top && have_bottom)
+        return CacheSegmentState::CACHED_TOP_AND_BOTTOM_EMPTY_CENTER;
 
-    if(cached_lines_count == 0)
-        cached_state = CacheSegmentState::EMPTY;
+    if(have_top)
+        return CacheSegmentState::CACHED_TOP_EMPTY_BOTTOM;
+
+    if(have_bottom)
+        return CacheSegmentState::CACHED_BOTTOM_EMPTY_TOP;
+
+    return CacheSegmentState::CACHED_CENTER;
+}
+
+void List::DBusListViewport::drop_cached_lines()
+{
+    for(size_t i = 0; i < cached_lines_.size(); ++i)
+        if(cached_lines_[i])
+            item_cache_->unref(items_list_id_, view_segment_.line() + i);
+
+    cached_lines_.assign(cached_lines_.size(), false);
+}
+
+unsigned int List::DBusListViewport::get_number_of_cached_lines() const
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
 
-    return cached_state;
+    unsigned int result;
+    compute_overlap(result);
+    return result;
 }
 
 List::CacheSegmentState
-List::DBusListViewport::set_view(unsigned int line, unsigned int count,
+List::DBusListViewport::set_view(ID::List list_id,
+                                 unsigned int line, unsigned int count,
                                  unsigned int total_number_of_lines,
                                  unsigned int &cached_lines_count)
 {
@@ -73,83 +90,94 @@ List::DBusListViewport::set_view(unsigned int line, unsigned int count,
     if(line > UINT_MAX - count)
         line = UINT_MAX - count;
 
+    Segment new_view;
+
     if(line + count <= total_number_of_lines)
     {
         /* regular case */
-        view_segment_ = Segment(line, count);
+        new_view = Segment(line, count);
     }
     else if(count <= total_number_of_lines)
     {
         /* requested segment covers end of list and goes beyond */
-        view_segment_ = Segment(total_number_of_lines - count, count);
+        new_view = Segment(total_number_of_lines - count, count);
     }
     else
     {
         /* requested segment is larger than whole list */
-        view_segment_ = Segment(0, total_number_of_lines);
+        new_view = Segment(0, total_number_of_lines);
+    }
+
+    std::vector<bool> new_cached_lines(new_view.size(), false);
+
+    /* keep references to lines which remain in view, drop all others */
+    for(size_t i = 0; i < cached_lines_.size(); ++i)
+    {
+        if(!cached_lines_[i])
+            continue;
+
+        const unsigned int l = view_segment_.line() + i;
+
+        if(list_id == items_list_id_ && new_view.contains_line(l))
+            new_cached_lines[l - new_view.line()] = true;
+        else
+            item_cache_->unref(items_list_id_, l);
     }
 
-    return compute_overlap(view_segment_, cached_lines_count);
+    /* pick up lines which have been cached by other viewports or by earlier
+     * loads of this viewport */
+    for(size_t i = 0; i < new_cached_lines.size(); ++i)
+        if(!new_cached_lines[i])
+            new_cached_lines[i] = item_cache_->ref(list_id, new_view.line() + i);
+
+    view_segment_ = new_view;
+    cached_lines_ = std::move(new_cached_lines);
+    items_list_id_ = list_id;
+
+    return compute_overlap(cached_lines_count);
 }
 
 List::Segment List::DBusListViewport::get_missing_segment() const
 {
-    unsigned int intersection_size;
+    const auto first_missing =
+        std::find(cached_lines_.begin(), cached_lines_.end(), false);
 
-    switch(view_segment_.intersection(items_segment_, intersection_size))
-    {
-      case SegmentIntersection::DISJOINT:
-      case SegmentIntersection::CENTER_REMAINS:
-        return Segment(view_segment_);
-
-      case SegmentIntersection::EQUAL:
-      case SegmentIntersection::INCLUDED_IN_OTHER:
+    if(first_missing == cached_lines_.end())
         return Segment(view_segment_.line(), 0);
 
-      case SegmentIntersection::TOP_REMAINS:
-        return Segment(view_segment_.line() + intersection_size,
-                       view_segment_.size() - intersection_size);
+    const auto last_missing =
+        std::find(cached_lines_.rbegin(), cached_lines_.rend(), false);
 
-      case SegmentIntersection::BOTTOM_REMAINS:
-        return Segment(view_segment_.line(),
-                       view_segment_.size() - intersection_size);
-    }
+    const unsigned int begin = std::distance(cached_lines_.begin(), first_missing);
+    const unsigned int end = std::distance(last_missing, cached_lines_.rend());
 
-    MSG_UNREACHABLE();
-    return Segment(view_segment_);
+    return Segment(view_segment_.line() + begin, end - begin);
 }
 
-unsigned int List::DBusListViewport::prepare_update()
+std::vector<List::Segment> List::DBusListViewport::get_missing_segments() const
 {
-    unsigned int intersection_size;
-    unsigned int beginning_of_gap = 0;
+    std::vector<Segment> result;
+    auto it = cached_lines_.begin();
 
-    switch(view_segment_.intersection(items_segment_, intersection_size))
+    while(true)
     {
-      case SegmentIntersection::DISJOINT:
-      case SegmentIntersection::CENTER_REMAINS:
-        items_.clear();
-        break;
+        const auto gap_begin = std::find(it, cached_lines_.end(), false);
 
-      case SegmentIntersection::EQUAL:
-      case SegmentIntersection::INCLUDED_IN_OTHER:
-        break;
+        if(gap_begin == cached_lines_.end())
+            break;
 
-      case SegmentIntersection::TOP_REMAINS:
-        items_.shift_up(items_.get_number_of_items() - intersection_size);
-        beginning_of_gap = intersection_size;
-        break;
+        it = std::find(gap_begin, cached_lines_.end(), true);
 
-      case SegmentIntersection::BOTTOM_REMAINS:
-        items_.shift_down(items_.get_number_of_items() - intersection_size);
-        break;
+        result.emplace_back(view_segment_.line() +
+                            std::distance(cached_lines_.begin(), gap_begin),
+                            std::distance(gap_begin, it));
     }
 
-    return beginning_of_gap;
+    return result;
 }
 
 void List::DBusListViewport::update_cache_region_simple(
-        NewItemFn new_item_fn, unsigned int cache_list_index,
+        NewItemFn new_item_fn, ID::List list_id, unsigned int first_line,
         const GVariantWrapper &dbus_data)
 {
     GVariantIter iter;
@@ -157,24 +185,21 @@ void List::DBusListViewport::update_cache_region_simple(
     if(g_variant_iter_init(&iter, GVariantWrapper::get(dbus_data)) <= 0)
         return;
 
-    const bool replace_mode = !items_.empty();
+    unsigned int line = first_line;
     const gchar *name;
     uint8_t item_kind;
 
     while(g_variant_iter_next(&iter, "(&sy)", &name, &item_kind))
-    {
-        if(replace_mode)
-            items_.replace(cache_list_index++,
-                           new_item_fn(name, ListItemKind(item_kind), nullptr));
-        else
-            items_.append(new_item_fn(name, ListItemKind(item_kind), nullptr));
-    }
-
-    items_segment_ = view_segment_;
+        put_item(list_id, line++,
+                 [&new_item_fn, name, item_kind, &dbus_data] ()
+                 {
+                     return new_item_fn(name, ListItemKind(item_kind), nullptr,
+                                        dbus_data);
+                 });
 }
 
 void List::DBusListViewport::update_cache_region_with_meta_data(
-        NewItemFn new_item_fn, unsigned int cache_list_index,
+        NewItemFn new_item_fn, ID::List list_id, unsigned int first_line,
         const GVariantWrapper &dbus_data)
 {
     GVariantIter iter;
@@ -182,7 +207,7 @@ void List::DBusListViewport::update_cache_region_with_meta_data(
     if(g_variant_iter_init(&iter, GVariantWrapper::get(dbus_data)) <= 0)
         return;
 
-    const bool replace_mode = !items_.empty();
+    unsigned int line = first_line;
     const gchar *names[3];
     uint8_t primary_name_index;
     uint8_t item_kind;
@@ -195,7 +220,7 @@ void List::DBusListViewport::update_cache_region_with_meta_data(
            primary_name_index != UINT8_MAX)
         {
             MSG_BUG("Got unexpected index of primary name (%u) [%s]",
-                    primary_name_index, items_.get_list_iface_name().c_str());
+                    primary_name_index, name_.c_str());
             primary_name_index = 0;
         }
 
@@ -208,27 +233,30 @@ void List::DBusListViewport::update_cache_region_with_meta_data(
         if(primary_name_index == UINT8_MAX)
             item_kind = ListItemKind::LOCKED;
 
-        if(replace_mode)
-            items_.replace(cache_list_index++,
-                           new_item_fn(name, ListItemKind(item_kind), names));
-        else
-            items_.append(new_item_fn(name, ListItemKind(item_kind), names));
+        put_item(list_id, line++,
+                 [&new_item_fn, name, item_kind, &names, &dbus_data] ()
+                 {
+                     return new_item_fn(name, ListItemKind(item_kind), names,
+                                        dbus_data);
+                 });
     }
-
-    items_segment_ = view_segment_;
 }
 
 List::DBusListSegmentFetcher::DBusListSegmentFetcher(
-        std::shared_ptr<DBusListViewport> list_viewport):
+        std::shared_ptr<DBusListViewport> list_viewport,
+        AsyncListIface::HintItemDoneNotification &&hinted_fn):
     is_cancel_blocked_(false),
     is_done_notification_deferred_(false),
-    list_viewport_(std::move(list_viewport))
+    list_viewport_(std::move(list_viewport)),
+    hinted_fn_(std::move(hinted_fn)),
+    result_(AsyncListIface::OpResult::SUCCEEDED)
 {
     LoggedLock::configure(lock_, "DBusListSegmentFetcher", MESSAGE_LEVEL_DEBUG);
     msg_log_assert(list_viewport_ != nullptr);
 }
 
-void List::DBusListSegmentFetcher::prepare(const MkGetRangeRNFCall &mk_call,
+void List::DBusListSegmentFetcher::prepare(Segment &&missing,
+                                           const MkGetRangeRNFCall &mk_call,
                                            DoneFn &&done_fn)
 {
     auto ctx =
@@ -257,27 +285,98 @@ void List::DBusListSegmentFetcher::prepare(const MkGetRangeRNFCall &mk_call,
                 MainContext::deferred_call(fn, false);
             });
 
-    Segment missing(list_viewport_->get_missing_segment());
-
     get_range_query_ = mk_call(std::move(missing), std::move(ctx));
     msg_log_assert(get_range_query_ != nullptr);
 }
 
+void List::DBusListSegmentFetcher::follow(DBusListSegmentFetcher &leader)
+{
+    msg_log_assert(&leader != this);
+
+    auto query(leader.get_query_in_flight());
+    msg_log_assert(query != nullptr);
+
+    {
+        LOGGED_LOCK_CONTEXT_HINT;
+        std::lock_guard<LoggedLock::RecMutex> lock(lock_);
+
+        msg_log_assert(leader_query_ == nullptr);
+        leader_query_ = std::move(query);
+    }
+
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::RecMutex> lock(leader.lock_);
+    leader.followers_.emplace_back(shared_from_this());
+}
+
+std::shared_ptr<DBusRNF::GetRangeCallBase>
+List::DBusListSegmentFetcher::get_query_in_flight() const
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::RecMutex> lock(lock_);
+
+    if(get_range_query_ == nullptr || list_viewport_ == nullptr)
+        return nullptr;
+
+    if(is_done_notification_deferred_)
+        return get_range_query_;
+
+    switch(get_range_query_->is_already_loading(get_range_query_->loading_segment_.line()))
+    {
+      case DBusRNF::GetRangeCallBase::LoadingState::LOADING:
+        return get_range_query_;
+
+      case DBusRNF::GetRangeCallBase::LoadingState::INACTIVE:
+      case DBusRNF::GetRangeCallBase::LoadingState::OUT_OF_RANGE:
+      case DBusRNF::GetRangeCallBase::LoadingState::DONE:
+      case DBusRNF::GetRangeCallBase::LoadingState::FAILED_OR_ABORTED:
+        break;
+    }
+
+    return nullptr;
+}
+
+std::pair<List::AsyncListIface::HintItemDoneNotification,
+          List::AsyncListIface::OpResult>
+List::DBusListSegmentFetcher::part_done(AsyncListIface::OpResult result,
+                                        bool is_leader_query)
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::RecMutex> lock(lock_);
+
+    if(is_leader_query)
+        leader_query_ = nullptr;
+
+    /* first failure sticks */
+    if(result_ == AsyncListIface::OpResult::SUCCEEDED)
+        result_ = result;
+
+    if(get_range_query_ != nullptr || leader_query_ != nullptr)
+        return std::make_pair(nullptr, result_);
+
+    return std::make_pair(std::move(hinted_fn_), result_);
+}
+
 List::AsyncListIface::OpResult
 List::DBusListSegmentFetcher::load_segment_in_background()
 {
     LOGGED_LOCK_CONTEXT_HINT;
     std::lock_guard<LoggedLock::RecMutex> lock(lock_);
 
+    if(get_range_query_ == nullptr && leader_query_ != nullptr)
+        return AsyncListIface::OpResult::STARTED;
+
     msg_log_assert(get_range_query_ != nullptr);
 
-    switch(get_range_query_->request())
+    switch(get_range_query_->request_async())
     {
       case DBusRNF::CallState::WAIT_FOR_NOTIFICATION:
         return AsyncListIface::OpResult::STARTED;
 
       case DBusRNF::CallState::RESULT_FETCHED:
-        return AsyncListIface::OpResult::SUCCEEDED;
+        return leader_query_ != nullptr
+            ? AsyncListIface::OpResult::STARTED
+            : AsyncListIface::OpResult::SUCCEEDED;
 
       case DBusRNF::CallState::INITIALIZED:
       case DBusRNF::CallState::READY_TO_FETCH:
@@ -294,5 +393,9 @@ List::DBusListSegmentFetcher::load_segment_in_background()
     }
 
     get_range_query_ = nullptr;
+
+    /* failure is reported right here, not again when the leader is done */
+    hinted_fn_ = nullptr;
+
     return AsyncListIface::OpResult::FAILED;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2020, 2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2020, 2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -23,39 +23,58 @@
 #define DBUSLIST_VIEWPORT_HH
 
 #include "cache_segment.hh"
-#include "ramlist.hh"
+#include "dbuslist_item_cache.hh"
 #include "dbus_async.hh"
 #include "rnfcall_get_range.hh"
 #include "de_tahifi_lists_item_kinds.hh"
 
+#include <vector>
+
 namespace List
 {
 
 /*!
  * Simple POD structure for storing a little window of the list.
  *
- * Essentially, there are two things managed by this class.
- *
- * First thing is a small cache, consisting of a small fragment of the
- * underlying D-Bus list, and a line/size pair describing where in the list the
- * fragments fits. These are called "cached items" and "cached segment".
+ * The viewport manages a line/size pair describing the fragment of the list
+ * the user is currently seeing. This is called the "view segment". It is
+ * primarily used as a kind of cursor which can be moved around freely.
  *
- * Second thing is a line/size pair describing the fragment of the list the
- * user is currently seeing. This is called the "view segment". It is primarily
- * used as a kind of cursor which can be moved around freely. When needed, its
- * overlap with the cached segment can be computed so to figure out the items
- * missing from view. These can be retrieved by a #List::DBusListSegmentFetcher
- * object, and inserted into the cache when the items are available.
+ * The list items themselves are stored in the #List::DBusListItemCache shared
+ * by all viewports of the list. The viewport takes a reference to each item in
+ * view found in the shared cache. These items are called "cached items". The
+ * shared cache may hold any number of disjoint segments of the list, so the
+ * lines in view not covered by cached items are not necessarily contiguous.
+ * When needed, the smallest segment covering all lines missing from view can
+ * be computed. The missing items can be retrieved by a
+ * #List::DBusListSegmentFetcher object, and inserted into the cache when the
+ * items are available.
  */
 class DBusListViewport: public ListViewportBase
 {
   public:
+    /*!
+     * Function for constructing a list item from D-Bus data.
+     *
+     * The strings passed to this function point into \p page, the
+     * \c GVariant containing the whole range of list items retrieved from
+     * the list broker. The function may either copy the strings or keep a
+     * reference to \p page and use the strings in place.
+     */
     using NewItemFn = std::function<Item *(const char *name, ListItemKind kind,
-                                           const char *const *names)>;
+                                           const char *const *names,
+                                           const GVariantWrapper &page)>;
 
   private:
     mutable LoggedLock::Mutex lock_;
 
+    const std::string name_;
+
+    /*!
+     * Item storage shared with all other viewports of the same list.
+     */
+    const std::shared_ptr<DBusListItemCache> item_cache_;
+
     /*!
      * Segment describing which part of the list the user is currently seeing.
      *
@@ -64,21 +83,18 @@ class DBusListViewport: public ListViewportBase
     Segment view_segment_;
 
     /*!
-     * Segment describing which part of the list the cached items belong to.
+     * Which lines in view are cached.
      *
-     * This is usually referred to as "the cached segment".
+     * There is one entry per line in the view segment. The viewport holds a
+     * reference to each line marked in here in
+     * #List::DBusListViewport::item_cache_.
      */
-    Segment items_segment_;
+    std::vector<bool> cached_lines_;
 
     /*!
-     * Cached items, a fragment of a larger list.
-     *
-     * This is usually referred to as "the cached items".
-     *
-     * The location of the fragment inside the larger list is represented by
-     * #List::DBusListViewport::items_segment_, the cached segment.
+     * The list the cached lines refer to.
      */
-    RamList items_;
+    ID::List items_list_id_;
 
     /*!
      * Cache prefetch size (corresponds to the maximum size of the viewport).
@@ -92,11 +108,19 @@ class DBusListViewport: public ListViewportBase
     DBusListViewport &operator=(DBusListViewport &&) = delete;
 
     explicit DBusListViewport(const std::string &parent_list_iface_name,
-                              unsigned int cache_size, const char *which):
-        items_(parent_list_iface_name + " segment " + which),
+                              unsigned int cache_size, const char *which,
+                              std::shared_ptr<DBusListItemCache> item_cache):
+        name_(parent_list_iface_name + " segment " + which),
+        item_cache_(std::move(item_cache)),
         cache_size_(cache_size)
     {
         LoggedLock::configure(lock_, "DBusListViewport", MESSAGE_LEVEL_DEBUG);
+        msg_log_assert(item_cache_ != nullptr);
+    }
+
+    ~DBusListViewport()
+    {
+        drop_cached_lines();
     }
 
     template <typename FN>
@@ -118,10 +142,10 @@ class DBusListViewport: public ListViewportBase
      *
      * \returns
      *     A pair containing either a non-null item from cache and its
-     *     visibility (true means visible, false means invisible according to
-     *     the currently set view); or a \c nullptr and its visibility (true
-     *     means visible, but invalid (i.e., possibly loading), false means
-     *     invisible and invalid, i.e., out of range as far as this viewport is
+     *     visibility (always true because the viewport holds references only
+     *     to items in view); or a \c nullptr and its visibility (true means
+     *     visible, but invalid (i.e., possibly loading), false means invisible
+     *     and invalid, i.e., out of range as far as this viewport is
      *     concerned).
      */
     std::pair<const Item *, bool> item_at(unsigned int line) const
@@ -129,44 +153,49 @@ class DBusListViewport: public ListViewportBase
         LOGGED_LOCK_CONTEXT_HINT;
         std::lock_guard<LoggedLock::Mutex> lk(lock_);
 
-        return items_segment_.contains_line(line)
-            ? std::make_pair(items_.get_item(line - items_segment_.line()),
-                             view_segment_.contains_line(line))
-            : std::make_pair(nullptr, view_segment_.contains_line(line));
+        if(!view_segment_.contains_line(line))
+            return std::make_pair(nullptr, false);
+
+        return cached_lines_[line - view_segment_.line()]
+            ? std::make_pair(item_cache_->lookup(items_list_id_, line), true)
+            : std::make_pair(nullptr, true);
     }
 
     const Segment &view_segment() const { return view_segment_; }
-    const Segment &items_segment() const { return items_segment_; }
+
+    /*!
+     * Number of lines in view which are in cache.
+     */
+    unsigned int get_number_of_cached_lines() const;
 
   private:
     /*!
-     * Compute overlap of cached items and given segment.
-     *
-     * This function is used to determine which region is in cache and which is
-     * not. It may be used to find out which items must be fetched in case the
-     * \p segment is the segment the user wants to see.
+     * Classify coverage of the view segment by cached items.
      *
-     * \param segment
-     *     The segment to be checked for overlap with the cached items.
-     *
-     * \param cached_lines_count
-     *     Number of overlapping lines
+     * \param[out] cached_lines_count
+     *     Number of cached lines in view.
      *
      * \returns
-     *     An enum value which describes the kind of overlap between the cached
-     *     segment and the \p segment.
+     *     An enum value which describes which parts of the view segment are
+     *     in cache.
+     */
+    CacheSegmentState compute_overlap(unsigned int &cached_lines_count) const;
+
+    /*!
+     * Drop references to all cached lines in view.
      */
-    CacheSegmentState
-    compute_overlap(const Segment &segment, unsigned int &cached_lines_count) const;
+    void drop_cached_lines();
 
   public:
     /*!
      * Set the view segment by specifying the absolute line number and size.
      *
-     * This function allows moving the view segment freely over the list
-     * without modifying the cache. It does not much more than that; in
-     * particular, this function does not trigger retrieval of items nor does
-     * it interrupt any retrievals possibly running in the background.
+     * This function allows moving the view segment freely over the list. Lines
+     * which move out of view are released to the shared cache, lines which
+     * move into view are taken from the shared cache if available. It does
+     * not much more than that; in particular, this function does not trigger
+     * retrieval of items nor does it interrupt any retrievals possibly running
+     * in the background.
      *
      * The segment size will be adjusted according to \p total_number_of_lines,
      * which is the total number of lines in the whole list the viewport
@@ -178,6 +207,9 @@ class DBusListViewport: public ListViewportBase
      * cover the last \p count elements in the list. As a side effect, it is
      * possible to pass \c UINT_MAX in \p line to mean end of list.
      *
+     * \param list_id
+     *     The list the view segment refers to.
+     *
      * \param line, count
      *     The view segment.
      *
@@ -186,24 +218,28 @@ class DBusListViewport: public ListViewportBase
      *     adjustments).
      *
      * \param[out] cached_lines_count
-     *     The number of overlapping lines shared between view segment and
-     *     cached segment.
+     *     The number of lines in view found in cache.
      *
      * \returns
-     *     The kind of overlap of the view segment and the cached segment.
+     *     Which parts of the view segment are in cache.
      */
-    CacheSegmentState set_view(unsigned int line, unsigned int count,
+    CacheSegmentState set_view(ID::List list_id,
+                               unsigned int line, unsigned int count,
                                unsigned int total_number_of_lines,
                                unsigned int &cached_lines_count);
 
     /*!
      * Get the segment missing in the view.
      *
-     * The returned segment will be empty in case the view and the cached
-     * segment coincide. The returned segment will be equal to the view in case
-     * it is disjoint from the cached segment. Otherwise, the partial segment
-     * of the view segment will be returned which does not overlap with the
-     * cached segment.
+     * The returned segment will be empty in case all lines in view are cached.
+     * Otherwise, the returned segment is a single span enclosing all lines in
+     * view which are not in cache, from the first to the last of them. Cached
+     * lines at the top and bottom of the view segment are never part of the
+     * returned segment, but cached lines between two gaps are, so that these
+     * lines are fetched again along with the gaps. There is only one get-range
+     * query per #List::DBusListSegmentFetcher, hence no attempt is made to
+     * split the span here (see #List::DBusListViewport::get_missing_segments()
+     * for the gaps themselves).
      *
      * \returns
      *     The segment which is currently missing from the view. This can be
@@ -211,34 +247,49 @@ class DBusListViewport: public ListViewportBase
      *
      * \note
      *     Once the items are loaded (see #List::DBusListSegmentFetcher), use
-     *     #List::DBusListViewport::prepare_update() followed by either
-     *     #List::DBusListViewport::update_cache_region_simple() or
+     *     either #List::DBusListViewport::update_cache_region_simple() or
      *     #List::DBusListViewport::update_cache_region_with_meta_data() to
      *     update the cache.
      */
     Segment get_missing_segment() const;
 
     /*!
-     * Shift the cached items around according to given cache modifications.
+     * Get all gaps in the view.
      *
-     * This is a low-level operation for synchronizing the cached segment with
-     * the view segment. It moves the stored items in the internal list around
-     * to make space for missing items.
+     * Unlike #List::DBusListViewport::get_missing_segment(), cached lines
+     * between two gaps are not part of any returned segment, so that each
+     * segment can be fetched by a get-range query of its own.
      *
-     * Wrap calls of this function into #List::DBusListViewport::locked() and
-     * call one of the cache update functions in the same block of code.
+     * \returns
+     *     The segments missing from the view, top to bottom. The vector is
+     *     empty in case all lines in view are cached.
      */
-    unsigned int prepare_update();
+    std::vector<Segment> get_missing_segments() const;
 
     /*!
      * Put new items into the cache, including meta data.
      *
-     * This is a low-level operation.
+     * This is a low-level operation. Wrap calls of this function into
+     * #List::DBusListViewport::locked().
+     *
+     * Items in view are referenced by this viewport, items out of view are
+     * stashed into the shared cache for later use.
+     *
+     * \param new_item_fn
+     *     Function for constructing list items.
      *
-     * \see #List::DBusListViewport::prepare_update()
+     * \param list_id
+     *     The list the items have been taken from.
+     *
+     * \param first_line
+     *     The line number of the first item in \p dbus_data.
+     *
+     * \param dbus_data
+     *     Items as returned by the list broker.
      */
     void update_cache_region_with_meta_data(NewItemFn new_item_fn,
-                                            unsigned int cache_list_index,
+                                            ID::List list_id,
+                                            unsigned int first_line,
                                             const GVariantWrapper &dbus_data);
 
     /*!
@@ -246,29 +297,62 @@ class DBusListViewport: public ListViewportBase
      *
      * This is a low-level operation.
      *
-     * \see #List::DBusListViewport::prepare_update()
+     * \see #List::DBusListViewport::update_cache_region_with_meta_data()
      */
     void update_cache_region_simple(NewItemFn new_item_fn,
-                                    unsigned int cache_list_index,
+                                    ID::List list_id,
+                                    unsigned int first_line,
                                     const GVariantWrapper &dbus_data);
 
     /*!
      * Clear cached items, but keep view segment intact.
      *
-     * This function erases all cached items and shrinks the size of the cached
-     * segment down to zero. The view segment remains untouched.
+     * This function drops all references to cached items, so that all lines
+     * in view are considered missing. The items remain in the shared cache as
+     * long as its budget permits.
      *
      * \param line
-     *     The size of the cached segment is set to zero, but the line number
-     *     is set to \p line by this function. This can be useful to keep some
-     *     line number information around even if there are no items.
+     *     The view segment is moved to start at this line, but its size is
+     *     set to zero. This can be useful to keep some line number information
+     *     around even if there are no items.
      */
     void clear_for_line(unsigned int line)
     {
         LOGGED_LOCK_CONTEXT_HINT;
         std::lock_guard<LoggedLock::Mutex> lk(lock_);
-        items_.clear();
-        items_segment_ = Segment(line, 0);
+        drop_cached_lines();
+        view_segment_ = Segment(line, 0);
+    }
+
+    /*!
+     * Relabel cached items after list invalidation with replacement.
+     */
+    void rekey(ID::List old_id, ID::List new_id)
+    {
+        LOGGED_LOCK_CONTEXT_HINT;
+        std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+        if(items_list_id_ == old_id)
+            items_list_id_ = new_id;
+    }
+
+  private:
+    template <typename FN>
+    void put_item(ID::List list_id, unsigned int line, const FN &mk_item)
+    {
+        if(list_id != items_list_id_ || !view_segment_.contains_line(line))
+        {
+            item_cache_->stash_if_missing(list_id, line, mk_item);
+            return;
+        }
+
+        auto &&is_cached(cached_lines_[line - view_segment_.line()]);
+
+        if(is_cached)
+            return;
+
+        item_cache_->ref_or_insert(list_id, line, mk_item);
+        is_cached = true;
     }
 };
 
@@ -306,6 +390,33 @@ class DBusListSegmentFetcher: public std::enable_shared_from_this<DBusListSegmen
     /* where to put the data */
     std::shared_ptr<DBusListViewport> list_viewport_;
 
+    /*!
+     * RNF operation of another fetcher which loads lines we need as well.
+     *
+     * This is set for as long as this fetcher is a follower of another
+     * fetcher, i.e., until the other fetcher's results have been put into
+     * our viewport.
+     */
+    std::shared_ptr<DBusRNF::GetRangeCallBase> leader_query_;
+
+    /*!
+     * Fetchers waiting for the results of our RNF operation.
+     */
+    std::vector<std::shared_ptr<DBusListSegmentFetcher>> followers_;
+
+    /*!
+     * Completion notification.
+     *
+     * This function is called by #List::DBusList after our own RNF operation
+     * (if any) and the leader's RNF operation (if any) have completed.
+     */
+    AsyncListIface::HintItemDoneNotification hinted_fn_;
+
+    /*!
+     * Result of the RNF operations completed so far.
+     */
+    AsyncListIface::OpResult result_;
+
   public:
     DBusListSegmentFetcher(const DBusListSegmentFetcher &) = delete;
     DBusListSegmentFetcher(DBusListSegmentFetcher &&) = delete;
@@ -321,12 +432,24 @@ class DBusListSegmentFetcher: public std::enable_shared_from_this<DBusListSegmen
      *     fetcher; this is supposed to be done by client code which can
      *     retrieve the viewport and the operation which contains the new data
      *     via #List::DBusListSegmentFetcher::take_rnf_call_and_viewport().
+     *
+     * \param hinted_fn
+     *     Completion notification, called when all RNF operations this
+     *     fetcher depends on have completed
+     *     (see #List::DBusListSegmentFetcher::part_done()).
      */
-    explicit DBusListSegmentFetcher(std::shared_ptr<DBusListViewport> list_viewport);
+    explicit DBusListSegmentFetcher(std::shared_ptr<DBusListViewport> list_viewport,
+                                    AsyncListIface::HintItemDoneNotification &&hinted_fn);
 
     /*!
      * Prepare the list segment fetcher by constructing a get-range query.
      *
+     * \param missing
+     *     The segment to be loaded. This is usually the segment missing from
+     *     the viewport (see #List::DBusListViewport::get_missing_segment()),
+     *     maybe trimmed to the part not loaded by the leader already (see
+     *     #List::DBusListSegmentFetcher::follow()).
+     *
      * \param mk_call
      *     Function which constructs a #DBusRNF::GetRangeCallBase object. The
      *     segment fetcher cannot do this on its own without giving up loose
@@ -337,7 +460,73 @@ class DBusListSegmentFetcher: public std::enable_shared_from_this<DBusListSegmen
      *     operation completes in \e any way, successful or not. This callback
      *     will be executed as deferred work in main context.
      */
-    void prepare(const MkGetRangeRNFCall &mk_call, DoneFn &&done_fn);
+    void prepare(Segment &&missing, const MkGetRangeRNFCall &mk_call,
+                 DoneFn &&done_fn);
+
+    /*!
+     * Wait for results of another fetcher loading the same lines.
+     *
+     * The leader's results are put into our viewport by #List::DBusList
+     * when they become available. In case only part of our missing lines are
+     * covered by the leader, this fetcher must be prepared for loading the
+     * remaining lines by its own RNF operation as well.
+     *
+     * \param leader
+     *     The fetcher whose RNF operation covers (part of) the lines missing
+     *     from our viewport.
+     */
+    void follow(DBusListSegmentFetcher &leader);
+
+    /*!
+     * Return RNF operation if this fetcher is currently loading something.
+     *
+     * Followers may attach to the returned operation.
+     */
+    std::shared_ptr<DBusRNF::GetRangeCallBase> get_query_in_flight() const;
+
+    bool has_followers() const
+    {
+        LOGGED_LOCK_CONTEXT_HINT;
+        std::lock_guard<LoggedLock::RecMutex> lock(lock_);
+        return !followers_.empty();
+    }
+
+    bool is_following() const
+    {
+        LOGGED_LOCK_CONTEXT_HINT;
+        std::lock_guard<LoggedLock::RecMutex> lock(lock_);
+        return leader_query_ != nullptr;
+    }
+
+    /*!
+     * Take followers of this fetcher for completing them.
+     */
+    auto take_followers()
+    {
+        LOGGED_LOCK_CONTEXT_HINT;
+        std::lock_guard<LoggedLock::RecMutex> lock(lock_);
+        return std::move(followers_);
+    }
+
+    const auto &get_viewport() const { return list_viewport_; }
+
+    /*!
+     * Called by #List::DBusList when one of our RNF operations is done.
+     *
+     * \param result
+     *     Result of the completed operation.
+     *
+     * \param is_leader_query
+     *     True if the leader's RNF operation has completed, false if our own
+     *     RNF operation has completed.
+     *
+     * \returns
+     *     The completion notification to be called and the combined result
+     *     of all operations in case there are no more operations to wait for.
+     *     Otherwise, the returned function is \c nullptr.
+     */
+    std::pair<AsyncListIface::HintItemDoneNotification, AsyncListIface::OpResult>
+    part_done(AsyncListIface::OpResult result, bool is_leader_query);
 
     /*!
      * Stop loading items.
@@ -348,7 +537,9 @@ class DBusListSegmentFetcher: public std::enable_shared_from_this<DBusListSegmen
         std::lock_guard<LoggedLock::RecMutex> lock(lock_);
 
         if(get_range_query_ == nullptr)
-            return DBus::CancelResult::NOT_RUNNING;
+            return leader_query_ != nullptr
+                ? DBus::CancelResult::CANCELED
+                : DBus::CancelResult::NOT_RUNNING;
 
         if(is_cancel_blocked_)
             return DBus::CancelResult::BLOCKED_RECURSIVE_CALL;
@@ -389,7 +580,9 @@ class DBusListSegmentFetcher: public std::enable_shared_from_this<DBusListSegmen
         msg_log_assert(get_range_query_ != nullptr);
         msg_log_assert(list_viewport_ != nullptr);
         return std::make_pair(std::move(get_range_query_),
-                              std::move(list_viewport_));
+                              leader_query_ != nullptr
+                              ? list_viewport_
+                              : std::move(list_viewport_));
     }
 
     auto query() const
@@ -414,6 +607,16 @@ class DBusListSegmentFetcher: public std::enable_shared_from_this<DBusListSegmen
         LOGGED_LOCK_CONTEXT_HINT;
         std::lock_guard<LoggedLock::RecMutex> lock(lock_);
 
+        if(leader_query_ != nullptr &&
+           leader_query_->loading_segment_.contains_line(line))
+        {
+            /* results are put into our viewport by the leader */
+            return {
+                DBusRNF::GetRangeCallBase::LoadingState::LOADING,
+                DBusRNF::GetRangeCallBase::LoadingState::LOADING
+            };
+        }
+
         if(get_range_query_ == nullptr)
             return {
                 DBusRNF::GetRangeCallBase::LoadingState::INACTIVE,
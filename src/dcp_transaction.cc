@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015, 2016, 2017, 2019  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015, 2016, 2017, 2019, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -24,20 +24,17 @@
 #endif /* HAVE_CONFIG_H */
 
 #include "dcp_transaction.hh"
+#include "gather_writer.hh"
 #include "messages.h"
 
-static void clear_stream(std::ostringstream &ss)
-{
-    ss.str("");
-    ss.clear();
-}
+#include <string>
 
 bool DCP::Transaction::start(bool force_async)
 {
     switch(state_)
     {
       case IDLE:
-        clear_stream(sstr_);
+        clear_buffer();
 
         if(force_async)
         {
@@ -68,39 +65,27 @@ static char nibble_to_char(uint8_t nibble)
         return 'a' + (nibble - 10);
 }
 
-static const char *to_ascii(const char *in)
+static std::string to_ascii(const char *in, size_t len)
 {
-    static char buffer[16 * 1024];
+    std::string result;
+    result.reserve(len);
 
-    buffer[0] = '\0';
-
-    for(size_t i = 0; i < sizeof(buffer); ++i, ++in)
+    for(size_t i = 0; i < len; ++i)
     {
-        const char ch = *in;
-
-        if(ch == '\0')
-        {
-            buffer[i] = '\0';
-            break;
-        }
+        const char ch = in[i];
 
         if(isascii(ch) && isprint(ch))
-            buffer[i] = ch;
+            result.push_back(ch);
         else
         {
-            buffer[i + 0] = '{';
-            buffer[i + 1] = '0';
-            buffer[i + 2] = 'x';
-            buffer[i + 3] = nibble_to_char((ch >> 4) & 0x0f);
-            buffer[i + 4] = nibble_to_char(ch & 0x0f);
-            buffer[i + 5] = '}';
-            i += 5;
+            result.append("{0x");
+            result.push_back(nibble_to_char((ch >> 4) & 0x0f));
+            result.push_back(nibble_to_char(ch & 0x0f));
+            result.push_back('}');
         }
     }
 
-    buffer[sizeof(buffer) - 1] = '\0';
-
-    return buffer;
+    return result;
 }
 
 bool DCP::Transaction::commit()
@@ -116,7 +101,7 @@ bool DCP::Transaction::commit()
         return false;
     }
 
-    if(!sstr_.str().empty())
+    if(!buffer_.empty())
     {
         if(os_ != nullptr)
         {
@@ -124,19 +109,39 @@ bool DCP::Transaction::commit()
             {
                 /* check above avoids expensive call of #to_ascii() */
                 msg_vinfo(MESSAGE_LEVEL_TRACE, "DRC XML: %s",
-                          to_ascii(sstr_.str().c_str()));
+                          to_ascii(buffer_.data(), buffer_.size()).c_str());
             }
 
             /* the header should be written atomically to reduce confusion in
              * the read code in dcpd */
             char header[32];
-            snprintf(header, sizeof(header), "Size: %zu\n", sstr_.str().length());
+            const int header_length =
+                snprintf(header, sizeof(header), "Size: %zu\n", buffer_.size());
+
+            auto *gw = dynamic_cast<GatherWriter *>(os_->rdbuf());
+
+            if(gw != nullptr)
+            {
+                /* header and XML data in a single system call */
+                const struct iovec iov[] =
+                {
+                    { header, size_t(header_length), },
+                    { const_cast<char *>(buffer_.data()), buffer_.size(), },
+                };
+
+                if(!gw->write_gathered(iov, sizeof(iov) / sizeof(iov[0])))
+                    os_->setstate(std::ios_base::badbit);
+            }
+            else
+            {
+                os_->write(header, header_length);
+                os_->write(buffer_.data(), buffer_.size());
+            }
 
-            *os_ << header << sstr_.str();
             os_->flush();
         }
 
-        clear_stream(sstr_);
+        clear_buffer();
     }
 
     set_state(WAIT_FOR_ANSWER);
@@ -157,7 +162,7 @@ bool DCP::Transaction::done()
         return false;
     }
 
-    clear_stream(sstr_);
+    clear_buffer();
     set_state(IDLE);
 
     return true;
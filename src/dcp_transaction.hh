@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015, 2016, 2017, 2019  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015, 2016, 2017, 2019, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -22,8 +22,9 @@
 #ifndef DCP_TRANSACTION_HH
 #define DCP_TRANSACTION_HH
 
+#include "dcp_xml_buffer.hh"
+
 #include <ostream>
-#include <sstream>
 #include <functional>
 
 namespace DCP
@@ -46,7 +47,8 @@ class Transaction
   private:
     const std::function<void(state)> observer_;
     std::ostream *os_;
-    std::ostringstream sstr_;
+    XmlBuffer buffer_;
+    std::ostream buffer_stream_;
     state state_;
 
   public:
@@ -65,6 +67,7 @@ class Transaction
     explicit Transaction(const std::function<void(state)> &observer):
         observer_(observer),
         os_(nullptr),
+        buffer_stream_(&buffer_),
         state_(IDLE)
     {}
 
@@ -75,7 +78,7 @@ class Transaction
 
     std::ostream *stream()
     {
-        return state_ == WAIT_FOR_COMMIT ? &sstr_ : nullptr;
+        return state_ == WAIT_FOR_COMMIT ? &buffer_stream_ : nullptr;
     }
 
     bool is_in_progress() const
@@ -135,6 +138,12 @@ class Transaction
     bool abort();
 
   private:
+    void clear_buffer()
+    {
+        buffer_.clear();
+        buffer_stream_.clear();
+    }
+
     void set_state(state s)
     {
         state_ = s;
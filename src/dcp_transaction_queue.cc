@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016, 2017, 2019, 2020, 2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2016, 2017, 2019, 2020, 2022, 2026  T+A elektroakustik GmbH & Co. KG
  * Copyright (C) 2023  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
@@ -142,7 +142,14 @@ bool DCP::Queue::process()
 
         if(active_.data_->view_->write_whole_xml(*active_.dcpd_.stream(),
                                                  *active_.data_))
-            return active_.dcpd_.commit();
+        {
+            if(active_.dcpd_.commit())
+                return true;
+
+            /* the view must not assume that DCPD shows what it has written */
+            active_.data_->view_->xml_transaction_failed();
+            return false;
+        }
         else
         {
             (void)active_.dcpd_.abort();
@@ -175,6 +182,9 @@ bool DCP::Queue::finish_transaction(DCP::Transaction::Result result)
         MSG_BUG("Failed closing successful transaction, trying to abort");
     }
 
+    if(active_.data_ != nullptr)
+        active_.data_->view_->xml_transaction_failed();
+
     active_.data_.reset();
 
     if(!active_.dcpd_.abort())
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#ifndef DCP_XML_BUFFER_HH
+#define DCP_XML_BUFFER_HH
+
+#include <streambuf>
+#include <string>
+
+namespace DCP
+{
+
+/*!
+ * Stream buffer for composing DCP XML documents.
+ *
+ * In contrast to \c std::stringbuf, this buffer keeps its allocated memory
+ * when it is cleared, and its content is accessible without copying. Thus,
+ * after the first few transactions, serializing a view does not allocate any
+ * memory anymore.
+ */
+class XmlBuffer: public std::streambuf
+{
+  public:
+    /*!
+     * Initial capacity, sufficient for typical full list views.
+     */
+    static constexpr size_t DEFAULT_CAPACITY = 8 * 1024;
+
+  private:
+    std::string buffer_;
+
+  public:
+    XmlBuffer(const XmlBuffer &) = delete;
+    XmlBuffer &operator=(const XmlBuffer &) = delete;
+
+    explicit XmlBuffer(size_t capacity = DEFAULT_CAPACITY)
+    {
+        buffer_.reserve(capacity);
+    }
+
+    virtual ~XmlBuffer() {}
+
+    const char *data() const { return buffer_.data(); }
+    size_t size() const { return buffer_.size(); }
+    bool empty() const { return buffer_.empty(); }
+
+    /*!
+     * Remove content, keep allocated memory.
+     */
+    void clear() { buffer_.clear(); }
+
+  protected:
+    std::streamsize xsputn(const char_type *s, std::streamsize count) override
+    {
+        buffer_.append(s, count);
+        return count;
+    }
+
+    int_type overflow(int_type ch) override
+    {
+        if(!traits_type::eq_int_type(ch, traits_type::eof()))
+            buffer_.push_back(traits_type::to_char_type(ch));
+
+        return traits_type::not_eof(ch);
+    }
+};
+
+}
+
+#endif /* !DCP_XML_BUFFER_HH */
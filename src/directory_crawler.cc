@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016--2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2016--2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -47,6 +47,21 @@ Playlist::Crawler::DirectoryCrawler::set_cursor(const CursorBase &cursor)
     return *this;
 }
 
+bool Playlist::Crawler::DirectoryCrawler::toggle_shuffle_mode()
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lock(lock_);
+
+    is_shuffle_enabled_ = !is_shuffle_enabled_;
+
+    if(is_shuffle_enabled_)
+        shuffle_seed_ = (uint64_t(g_random_int()) << 32) | g_random_int();
+
+    msg_info("Shuffle mode %s", is_shuffle_enabled_ ? "enabled" : "disabled");
+
+    return is_shuffle_enabled_;
+}
+
 void Playlist::Crawler::DirectoryCrawler::deactivated(std::shared_ptr<CursorBase> cursor)
 {
     stop_cache_enforcer();
@@ -59,6 +74,8 @@ bool Playlist::Crawler::DirectoryCrawler::list_invalidate(ID::List list_id, ID::
 
     msg_log_assert(list_id.is_valid());
 
+    tree_cache_.list_invalidate(list_id, replacement_id);
+
     if(DerivedCrawlerFuns::reference_point(*this) == nullptr)
         return false;
 
@@ -113,6 +130,97 @@ Playlist::Crawler::DirectoryCrawler::Cursor::hint_planned_access(
                                         std::move(hinted_fn));
 }
 
+uint64_t
+Playlist::Crawler::DirectoryCrawler::Cursor::get_shuffle_seed_for_depth(unsigned int directory_depth) const
+{
+    /* nested lists are shuffled depending on their position in the parent
+     * list so that sibling directories are shuffled differently */
+    if(!shuffle_levels_.empty() &&
+       shuffle_levels_.back().directory_depth_ + 1 == directory_depth)
+        return ShufflePermutation::derive_seed(shuffle_levels_.back().seed_,
+                                               shuffle_levels_.back().get_line());
+
+    return ShufflePermutation::derive_seed(shuffle_seed_, directory_depth);
+}
+
+Playlist::Crawler::DirectoryCrawler::Cursor::ShuffleLevel &
+Playlist::Crawler::DirectoryCrawler::Cursor::sync_shuffle_level()
+{
+    const unsigned int size = nav_.get_total_number_of_visible_items();
+    const unsigned int line = nav_.get_cursor_unchecked();
+
+    while(!shuffle_levels_.empty() &&
+          shuffle_levels_.back().directory_depth_ > directory_depth_)
+        shuffle_levels_.pop_back();
+
+    if(!shuffle_levels_.empty() &&
+       shuffle_levels_.back().directory_depth_ == directory_depth_)
+    {
+        auto &level(shuffle_levels_.back());
+
+        if(level.size_ == size && level.get_line() == line)
+            return level;
+
+        /* cursor has been moved behind our back, or the list has changed */
+        shuffle_levels_.pop_back();
+    }
+
+    const uint64_t seed = get_shuffle_seed_for_depth(directory_depth_);
+    shuffle_levels_.emplace_back(directory_depth_, seed, size,
+                                 ShufflePermutation(size, seed).inverse(line));
+
+    return shuffle_levels_.back();
+}
+
+bool Playlist::Crawler::DirectoryCrawler::Cursor::advance_shuffled(Direction direction)
+{
+    auto &level(sync_shuffle_level());
+
+    switch(direction)
+    {
+      case Direction::FORWARD:
+        if(level.position_ + 1 >= level.size_)
+            return false;
+
+        ++level.position_;
+        break;
+
+      case Direction::BACKWARD:
+        if(level.position_ == 0 || level.position_ >= level.size_)
+            return false;
+
+        --level.position_;
+        break;
+
+      case Direction::NONE:
+        return false;
+    }
+
+    nav_.set_cursor_by_line_number(level.get_line());
+
+    return true;
+}
+
+void Playlist::Crawler::DirectoryCrawler::Cursor::shuffle_entered_list(bool forward)
+{
+    if(!is_shuffled_)
+        return;
+
+    while(!shuffle_levels_.empty() &&
+          shuffle_levels_.back().directory_depth_ >= directory_depth_)
+        shuffle_levels_.pop_back();
+
+    const unsigned int size = nav_.get_total_number_of_visible_items();
+
+    if(size == 0)
+        return;
+
+    shuffle_levels_.emplace_back(directory_depth_,
+                                 get_shuffle_seed_for_depth(directory_depth_),
+                                 size, forward ? 0 : size - 1);
+    nav_.set_cursor_by_line_number(shuffle_levels_.back().get_line());
+}
+
 std::string Playlist::Crawler::DirectoryCrawler::Cursor::get_description(bool full) const
 {
     std::ostringstream os;
@@ -127,6 +235,9 @@ std::string Playlist::Crawler::DirectoryCrawler::Cursor::get_description(bool fu
           << "]; " << nav_.get_total_number_of_visible_items()
           << " visible items";
 
+    if(full && is_shuffled_)
+        os << "; shuffled at " << shuffle_levels_.size() << " levels";
+
     return os.str();
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016, 2017, 2019--2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2016, 2017, 2019--2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -29,6 +29,10 @@
 #include "airable_links.hh"
 #include "rnfcall_get_uris.hh"
 #include "rnfcall_get_ranked_stream_links.hh"
+#include "shuffle_permutation.hh"
+#include "directory_tree_cache.hh"
+
+#include <vector>
 
 namespace ViewFileBrowser { class FileItem; }
 
@@ -57,6 +61,32 @@ class DirectoryCrawler: public Iface, public PublicIface
         friend DirectoryCrawler;
 
       private:
+        /*!
+         * Position in shuffled sequence of a list on the path to the cursor.
+         */
+        struct ShuffleLevel
+        {
+            unsigned int directory_depth_;
+            uint64_t seed_;
+            unsigned int size_;
+            unsigned int position_;
+
+            explicit ShuffleLevel(unsigned int directory_depth, uint64_t seed,
+                                  unsigned int size, unsigned int position):
+                directory_depth_(directory_depth),
+                seed_(seed),
+                size_(size),
+                position_(position)
+            {}
+
+            ShufflePermutation permutation() const
+            {
+                return ShufflePermutation(size_, seed_);
+            }
+
+            unsigned int get_line() const { return permutation()(position_); }
+        };
+
         ID::List list_id_;
         List::Nav nav_;
         unsigned int directory_depth_;
@@ -64,6 +94,18 @@ class DirectoryCrawler: public Iface, public PublicIface
         ID::List requested_list_id_;
         unsigned int requested_line_;
 
+        bool is_shuffled_;
+        uint64_t shuffle_seed_;
+
+        /*!
+         * Shuffle state of the lists between root and cursor.
+         *
+         * There is at most one entry per directory depth, so the memory
+         * required for shuffling is proportional to the directory depth, not
+         * to the number of items in the directory hierarchy.
+         */
+        std::vector<ShuffleLevel> shuffle_levels_;
+
         explicit Cursor(unsigned int max_display_lines,
                         List::NavItemFilterIface &filter, ID::List list_id,
                         ID::List req_list, unsigned int req_line,
@@ -72,7 +114,9 @@ class DirectoryCrawler: public Iface, public PublicIface
             nav_(max_display_lines, List::Nav::WrapMode::NO_WRAP, filter),
             directory_depth_(directory_depth),
             requested_list_id_(req_list),
-            requested_line_(req_line)
+            requested_line_(req_line),
+            is_shuffled_(false),
+            shuffle_seed_(0)
         {
             nav_.set_cursor_by_line_number(req_line);
         }
@@ -88,7 +132,11 @@ class DirectoryCrawler: public Iface, public PublicIface
             Cursor(max_display_lines, filter,
                    src.list_id_, src.requested_list_id_,
                    src.requested_line_, src.directory_depth_)
-        {}
+        {
+            is_shuffled_ = src.is_shuffled_;
+            shuffle_seed_ = src.shuffle_seed_;
+            shuffle_levels_ = src.shuffle_levels_;
+        }
 
         Cursor(const Cursor &) = default;
 
@@ -99,11 +147,17 @@ class DirectoryCrawler: public Iface, public PublicIface
             directory_depth_ = src.directory_depth_;
             requested_list_id_ = src.requested_list_id_;
             requested_line_ = src.requested_line_;
+            is_shuffled_ = src.is_shuffled_;
+            shuffle_seed_ = src.shuffle_seed_;
+            shuffle_levels_ = src.shuffle_levels_;
             return *this;
         }
 
         bool advance(Direction direction) final override
         {
+            if(is_shuffled_)
+                return advance_shuffled(direction);
+
             switch(direction)
             {
               case Direction::FORWARD:
@@ -137,9 +191,48 @@ class DirectoryCrawler: public Iface, public PublicIface
             directory_depth_ = 0;
             requested_list_id_ = ID::List();
             requested_line_ = 0;
+            shuffle_levels_.clear();
             nav_.set_cursor_by_line_number(0);
         }
 
+        /*!
+         * Enable or disable shuffled traversal.
+         *
+         * In shuffle mode, the items of each list are visited in the order
+         * defined by a #Playlist::Crawler::ShufflePermutation seeded from
+         * \p seed and the path to the list, starting with the item the cursor
+         * is pointing to. Given the same seed, the order is reproducible.
+         */
+        void set_shuffle_mode(bool enable, uint64_t seed)
+        {
+            is_shuffled_ = enable;
+            shuffle_seed_ = seed;
+            shuffle_levels_.clear();
+        }
+
+        bool is_shuffled() const { return is_shuffled_; }
+
+        /*!
+         * Position of the cursor in the traversal order of the current list.
+         *
+         * This is the line number in normal mode, and the position in the
+         * shuffled sequence in shuffle mode.
+         */
+        unsigned int get_traversal_position()
+        {
+            return is_shuffled_
+                ? sync_shuffle_level().position_
+                : nav_.get_cursor();
+        }
+
+        /*!
+         * Move cursor to the first item to be visited in a freshly entered
+         * list, taking shuffle mode into account.
+         *
+         * This function does nothing in normal mode.
+         */
+        void shuffle_entered_list(bool forward);
+
         std::unique_ptr<CursorBase> clone() const final override
         {
             return std::make_unique<Cursor>(*this);
@@ -188,6 +281,11 @@ class DirectoryCrawler: public Iface, public PublicIface
         {
             return std::static_pointer_cast<List::DBusListViewport>(nav_.get_viewport());
         }
+
+      private:
+        bool advance_shuffled(Direction direction);
+        ShuffleLevel &sync_shuffle_level();
+        uint64_t get_shuffle_seed_for_depth(unsigned int directory_depth) const;
     };
 
     class FindNextOp: public FindNextOpBase
@@ -210,6 +308,7 @@ class DirectoryCrawler: public Iface, public PublicIface
         static constexpr unsigned int MAX_DIRECTORY_DEPTH = 100;
 
         List::DBusList &dbus_list_;
+        DirectoryTreeCache &tree_cache_;
         std::unique_ptr<Cursor> position_;
         I18n::String root_list_title_;
 
@@ -217,6 +316,16 @@ class DirectoryCrawler: public Iface, public PublicIface
         bool is_waiting_for_item_hint_;
         bool has_skipped_first_;
 
+        /*!
+         * Set while entering a list whose ID has been taken from
+         * #Playlist::Crawler::DirectoryCrawler::FindNextOp::tree_cache_.
+         */
+        bool is_entering_cached_list_;
+
+        /*! Parent list and line while descending into a child list. */
+        ID::List descend_from_list_id_;
+        unsigned int descend_from_line_;
+
         const ViewFileBrowser::FileItem *file_item_;
 
       public:
@@ -225,6 +334,7 @@ class DirectoryCrawler: public Iface, public PublicIface
 
         explicit FindNextOp(std::string &&debug_description, Tag tag,
                             List::DBusList &dbus_list,
+                            DirectoryTreeCache &tree_cache,
                             CompletionCallback &&completion_callback,
                             CompletionCallbackFilter filter,
                             RecursiveMode recursive_mode, Direction direction,
@@ -236,6 +346,7 @@ class DirectoryCrawler: public Iface, public PublicIface
                            position->get_directory_depth(), find_mode),
             tag_(tag),
             dbus_list_(dbus_list),
+            tree_cache_(tree_cache),
             position_(std::move(position)),
             root_list_title_(std::move(root_list_title)),
             entering_list_caller_id_(direction == Direction::NONE
@@ -243,6 +354,8 @@ class DirectoryCrawler: public Iface, public PublicIface
                 : List::QueryContextEnterList::CallerID::CRAWLER_FIRST_ENTRY),
             is_waiting_for_item_hint_(false),
             has_skipped_first_(false),
+            is_entering_cached_list_(false),
+            descend_from_line_(0),
             file_item_(nullptr)
         {
             msg_log_assert(position_ != nullptr);
@@ -282,6 +395,7 @@ class DirectoryCrawler: public Iface, public PublicIface
         void run_as_far_as_possible();
         Continue finish_with_current_item_or_continue();
         Continue continue_search();
+        Continue ascend_to_parent(bool may_use_cache);
     };
 
     class GetURIsOp: public GetURIsOpBase
@@ -361,6 +475,12 @@ class DirectoryCrawler: public Iface, public PublicIface
 
     std::unique_ptr<CacheEnforcer> cache_enforcer_;
 
+    /* directory structure seen while crawling */
+    DirectoryTreeCache tree_cache_;
+
+    bool is_shuffle_enabled_;
+    uint64_t shuffle_seed_;
+
   public:
     DirectoryCrawler (const DirectoryCrawler &) = delete;
     DirectoryCrawler &operator=(const DirectoryCrawler &) = delete;
@@ -374,7 +494,9 @@ class DirectoryCrawler: public Iface, public PublicIface
         traversal_list_("crawler traversal", cm, dbus_listnav_proxy,
                         list_contexts, new_item_fn),
         traversal_item_filter_(traversal_list_.mk_viewport(1, "traversal"),
-                               &traversal_list_)
+                               &traversal_list_),
+        is_shuffle_enabled_(false),
+        shuffle_seed_(0)
     {}
 
     void init_dbus_list_watcher();
@@ -392,8 +514,36 @@ class DirectoryCrawler: public Iface, public PublicIface
      */
     Cursor mk_cursor(ID::List list_id, unsigned int line, unsigned int depth)
     {
-        return Cursor(traversal_item_filter_.get_viewport()->get_default_view_size(),
-                      traversal_item_filter_, list_id, list_id, line, depth);
+        Cursor c(traversal_item_filter_.get_viewport()->get_default_view_size(),
+                 traversal_item_filter_, list_id, list_id, line, depth);
+
+        if(is_shuffle_enabled_)
+            c.set_shuffle_mode(true, shuffle_seed_);
+
+        return c;
+    }
+
+    /*!
+     * Switch shuffle mode on or off for all cursors created from now on.
+     *
+     * A new seed is chosen each time shuffle mode is enabled. Cursors which
+     * already exist must be updated by the caller via
+     * #Playlist::Crawler::DirectoryCrawler::apply_shuffle_mode().
+     *
+     * \returns
+     *     The new shuffle mode.
+     */
+    bool toggle_shuffle_mode();
+
+    bool is_shuffle_enabled() const { return is_shuffle_enabled_; }
+
+    /*!
+     * Put existing cursor into current shuffle mode.
+     */
+    void apply_shuffle_mode(Cursor &c) const
+    {
+        if(c.is_shuffled() != is_shuffle_enabled_)
+            c.set_shuffle_mode(is_shuffle_enabled_, shuffle_seed_);
     }
 
     /* regular version including a completion callback */
@@ -410,7 +560,7 @@ class DirectoryCrawler: public Iface, public PublicIface
         msg_log_assert(completion_notification != nullptr);
 
         return std::make_shared<FindNextOp>(
-                    std::move(debug_description), tag, traversal_list_,
+                    std::move(debug_description), tag, traversal_list_, tree_cache_,
                     std::move(completion_notification), filter,
                     recursive_mode, direction, std::move(position),
                     std::move(list_title), find_mode);
@@ -426,7 +576,7 @@ class DirectoryCrawler: public Iface, public PublicIface
         msg_log_assert(position != nullptr);
 
         return std::make_shared<FindNextOp>(
-                    std::move(debug_description), tag, traversal_list_,
+                    std::move(debug_description), tag, traversal_list_, tree_cache_,
                     nullptr, OperationBase::CompletionCallbackFilter::NONE,
                     recursive_mode, direction, std::move(position),
                     std::move(list_title),
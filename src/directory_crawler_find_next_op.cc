@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2019, 2020, 2021, 2022, 2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2019, 2020, 2021, 2022, 2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -29,6 +29,8 @@
 #include "view_play.hh"
 #include "dump_enum_value.hh"
 
+#include <sstream>
+
 static const char skip_message_fmt[] = "Skipping directory \"%s\" (%s)";
 
 /* just in case we need a hook for the debugger */
@@ -175,9 +177,9 @@ static void fill_in_meta_data(MetaData::Set &md,
 
     const auto &pl(file_item->get_preloaded_meta_data());
 
-    md.add(MetaData::Set::ARTIST, pl.artist_.c_str());
-    md.add(MetaData::Set::ALBUM,  pl.album_.c_str());
-    md.add(MetaData::Set::TITLE,  pl.title_.c_str());
+    md.add(MetaData::Set::ARTIST, pl.artist_);
+    md.add(MetaData::Set::ALBUM,  pl.album_);
+    md.add(MetaData::Set::TITLE,  pl.title_);
     md.add(MetaData::Set::INTERNAL_DRCPD_TITLE, file_item->get_text());
 }
 
@@ -194,7 +196,7 @@ Playlist::Crawler::DirectoryCrawler::FindNextOp::finish_with_current_item_or_con
 
       case Direction::FORWARD:
         if(!has_skipped_first_ &&
-           (position_->nav_.get_cursor() >= position_->nav_.get_total_number_of_visible_items() ||
+           (position_->get_traversal_position() >= position_->nav_.get_total_number_of_visible_items() ||
             entering_list_caller_id_ == List::QueryContextEnterList::CallerID::CRAWLER_ASCEND))
         {
             if(entering_list_caller_id_ == List::QueryContextEnterList::CallerID::CRAWLER_ASCEND)
@@ -207,7 +209,7 @@ Playlist::Crawler::DirectoryCrawler::FindNextOp::finish_with_current_item_or_con
 
       case Direction::BACKWARD:
         if(!has_skipped_first_ &&
-           (position_->nav_.get_cursor() == 0 ||
+           (position_->get_traversal_position() == 0 ||
             entering_list_caller_id_ == List::QueryContextEnterList::CallerID::CRAWLER_ASCEND))
         {
             if(entering_list_caller_id_ == List::QueryContextEnterList::CallerID::CRAWLER_ASCEND)
@@ -315,21 +317,46 @@ Playlist::Crawler::DirectoryCrawler::FindNextOp::finish_with_current_item_or_con
         return continue_search();
     }
 
-    bool is_hard_error;
-    const auto list_id =
-        get_child_id_for_enter(dbus_list_, position_->nav_, *file_item_, is_hard_error);
+    const ID::List parent_list_id = dbus_list_.get_list_id();
+    const unsigned int parent_line = position_->nav_.get_cursor();
+    DirectoryTreeCache::Child cached_child;
+    ID::List list_id;
 
-    if(!list_id.is_valid())
+    if(tree_cache_.lookup_child(parent_list_id, parent_line, cached_child))
     {
-        if(is_hard_error)
-            return fail_here();
+        if(cached_child.is_size_known_ && cached_child.number_of_items_ == 0)
+        {
+            msg_info(skip_message_fmt, file_item_->get_text(), "empty directory");
+            ++directories_skipped_;
+            return continue_search();
+        }
 
-        ++directories_skipped_;
-        return continue_search();
+        list_id = cached_child.list_id_;
+        is_entering_cached_list_ = true;
+    }
+    else
+    {
+        bool is_hard_error;
+        list_id = get_child_id_for_enter(dbus_list_, position_->nav_,
+                                         *file_item_, is_hard_error);
+
+        if(!list_id.is_valid())
+        {
+            if(is_hard_error)
+                return fail_here();
+
+            ++directories_skipped_;
+            return continue_search();
+        }
+
+        tree_cache_.put_child(parent_list_id, parent_line, list_id);
+        is_entering_cached_list_ = false;
     }
 
     msg_info("Found directory \"%s\", entering", file_item_->get_text());
 
+    descend_from_list_id_ = parent_list_id;
+    descend_from_line_ = parent_line;
     entering_list_caller_id_ = List::QueryContextEnterList::CallerID::CRAWLER_DESCEND;
     position_->requested_list_id_ = list_id;
     position_->requested_line_ = 0;
@@ -397,24 +424,41 @@ Playlist::Crawler::DirectoryCrawler::FindNextOp::continue_search()
     }
 
     /* end of nested directory, back to parent */
+    return ascend_to_parent(true);
+}
+
+Playlist::Crawler::DirectoryCrawler::FindNextOp::Continue
+Playlist::Crawler::DirectoryCrawler::FindNextOp::ascend_to_parent(bool may_use_cache)
+{
+    const ID::List child_list_id = dbus_list_.get_list_id();
     unsigned int item_id;
     ID::List list_id;
 
-    try
-    {
-        std::string list_title;
-        list_id = ViewFileBrowser::Utils::get_parent_link_id(dbus_list_,
-                                                             dbus_list_.get_list_id(),
-                                                             item_id, list_title);
-    }
-    catch(const List::DBusListException &e)
+    if(may_use_cache &&
+       tree_cache_.lookup_parent(child_list_id, list_id, item_id))
+        is_entering_cached_list_ = true;
+    else
     {
-        /* leave #list_id invalid, fail below */
-        msg_error(0, LOG_NOTICE, "Failed going back to parent directory: %s", e.what());
-    }
+        is_entering_cached_list_ = false;
 
-    if(!list_id.is_valid())
-        return fail_here();
+        try
+        {
+            std::string list_title;
+            list_id = ViewFileBrowser::Utils::get_parent_link_id(dbus_list_,
+                                                                 child_list_id,
+                                                                 item_id, list_title);
+        }
+        catch(const List::DBusListException &e)
+        {
+            /* leave #list_id invalid, fail below */
+            msg_error(0, LOG_NOTICE, "Failed going back to parent directory: %s", e.what());
+        }
+
+        if(!list_id.is_valid())
+            return fail_here();
+
+        tree_cache_.put_child(list_id, item_id, child_list_id);
+    }
 
     entering_list_caller_id_ = List::QueryContextEnterList::CallerID::CRAWLER_ASCEND;
     position_->requested_list_id_ = list_id;
@@ -616,12 +660,26 @@ void Playlist::Crawler::DirectoryCrawler::FindNextOp::enter_list_event(
         break;
 
       case List::QueryContextEnterList::CallerID::CRAWLER_DESCEND:
+        if(!has_succeeded && is_entering_cached_list_)
+        {
+            /* cached list ID has probably expired, try again without cache */
+            msg_info("Failed entering cached child list %u, retrying",
+                     ctx.parameters_.list_id_.get_raw_id());
+            is_entering_cached_list_ = false;
+            tree_cache_.forget_child(descend_from_list_id_, descend_from_line_);
+            run_as_far_as_possible();
+            break;
+        }
+
         if(has_succeeded)
         {
+            tree_cache_.put_size(dbus_list_.get_list_id(),
+                                 position_->nav_.get_total_number_of_visible_items());
             ++directory_depth_;
             ++directories_entered_;
             has_skipped_first_ = false;
             position_->sync_list_id_with_request(directory_depth_);
+            position_->shuffle_entered_list(is_forward_direction(direction_));
         }
 
         if((!has_succeeded || position_->is_list_empty()) &&
@@ -632,6 +690,16 @@ void Playlist::Crawler::DirectoryCrawler::FindNextOp::enter_list_event(
         break;
 
       case List::QueryContextEnterList::CallerID::CRAWLER_ASCEND:
+        if(!has_succeeded && is_entering_cached_list_)
+        {
+            /* cached list ID has probably expired, try again without cache */
+            msg_info("Failed entering cached parent list %u, retrying",
+                     ctx.parameters_.list_id_.get_raw_id());
+            tree_cache_.list_invalidate(ctx.parameters_.list_id_, ID::List());
+            finish_op_if_possible(ascend_to_parent(false));
+            return;
+        }
+
         if(!has_succeeded)
         {
             finish_op_if_possible(fail_here());
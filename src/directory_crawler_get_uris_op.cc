@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2019, 2020, 2021  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2019, 2020, 2021, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -61,7 +61,7 @@ bool Playlist::Crawler::DirectoryCrawler::GetURIsOp::do_start()
                 cm_, proxy_, pos.list_id_, pos.nav_.get_cursor_unchecked(),
                 std::move(cc), nullptr);
 
-        return !state_is_failure(get_ranked_uris_call_->request());
+        return !state_is_failure(get_ranked_uris_call_->request_async());
     }
     else
     {
@@ -93,7 +93,7 @@ bool Playlist::Crawler::DirectoryCrawler::GetURIsOp::do_start()
                 cm_, proxy_, pos.list_id_, pos.nav_.get_cursor_unchecked(),
                 std::move(cc), nullptr);
 
-        return !state_is_failure(get_simple_uris_call_->request());
+        return !state_is_failure(get_simple_uris_call_->request_async());
     }
 }
 
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "directory_tree_cache.hh"
+
+#include <iterator>
+
+Playlist::Crawler::DirectoryTreeCache::DirectoryTreeCache(size_t max_entries):
+    max_entries_(max_entries)
+{
+    LoggedLock::configure(lock_, "DirectoryTreeCache", MESSAGE_LEVEL_DEBUG);
+}
+
+void Playlist::Crawler::DirectoryTreeCache::erase(Entries::iterator it)
+{
+    by_parent_.erase(Key(it->parent_, it->line_));
+    by_child_.erase(it->child_.list_id_);
+    entries_.erase(it);
+}
+
+void Playlist::Crawler::DirectoryTreeCache::touch(Entries::iterator it) const
+{
+    entries_.splice(entries_.begin(), entries_, it);
+}
+
+void Playlist::Crawler::DirectoryTreeCache::put_child(ID::List parent,
+                                                      unsigned int line,
+                                                      ID::List child)
+{
+    if(!parent.is_valid() || !child.is_valid() || max_entries_ == 0)
+        return;
+
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    const auto by_parent(by_parent_.find(Key(parent, line)));
+
+    if(by_parent != by_parent_.end())
+    {
+        if(by_parent->second->child_.list_id_ == child)
+        {
+            touch(by_parent->second);
+            return;
+        }
+
+        erase(by_parent->second);
+    }
+
+    /* a list has a single parent */
+    const auto by_child(by_child_.find(child));
+
+    if(by_child != by_child_.end())
+        erase(by_child->second);
+
+    while(entries_.size() >= max_entries_)
+        erase(std::prev(entries_.end()));
+
+    entries_.emplace_front(parent, line, child);
+    by_parent_[Key(parent, line)] = entries_.begin();
+    by_child_[child] = entries_.begin();
+}
+
+void Playlist::Crawler::DirectoryTreeCache::put_size(ID::List child,
+                                                     unsigned int number_of_items)
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    const auto it(by_child_.find(child));
+
+    if(it == by_child_.end())
+        return;
+
+    it->second->child_.is_size_known_ = true;
+    it->second->child_.number_of_items_ = number_of_items;
+}
+
+bool Playlist::Crawler::DirectoryTreeCache::lookup_child(ID::List parent,
+                                                         unsigned int line,
+                                                         Child &child) const
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    const auto it(by_parent_.find(Key(parent, line)));
+
+    if(it == by_parent_.end())
+        return false;
+
+    touch(it->second);
+    child = it->second->child_;
+
+    return true;
+}
+
+bool Playlist::Crawler::DirectoryTreeCache::lookup_parent(ID::List child,
+                                                          ID::List &parent,
+                                                          unsigned int &line) const
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    const auto it(by_child_.find(child));
+
+    if(it == by_child_.end())
+        return false;
+
+    touch(it->second);
+    parent = it->second->parent_;
+    line = it->second->line_;
+
+    return true;
+}
+
+void Playlist::Crawler::DirectoryTreeCache::forget_child(ID::List parent,
+                                                         unsigned int line)
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    const auto it(by_parent_.find(Key(parent, line)));
+
+    if(it != by_parent_.end())
+        erase(it->second);
+}
+
+void Playlist::Crawler::DirectoryTreeCache::list_invalidate(ID::List list_id,
+                                                            ID::List replacement_id)
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    for(auto it = entries_.begin(); it != entries_.end(); /* nothing */)
+    {
+        if(it->parent_ != list_id && it->child_.list_id_ != list_id)
+        {
+            ++it;
+            continue;
+        }
+
+        const auto next(std::next(it));
+
+        if(!replacement_id.is_valid())
+        {
+            erase(it);
+            it = next;
+            continue;
+        }
+
+        by_parent_.erase(Key(it->parent_, it->line_));
+        by_child_.erase(it->child_.list_id_);
+
+        if(it->parent_ == list_id)
+            it->parent_ = replacement_id;
+
+        if(it->child_.list_id_ == list_id)
+            it->child_.list_id_ = replacement_id;
+
+        by_parent_[Key(it->parent_, it->line_)] = it;
+        by_child_[it->child_.list_id_] = it;
+
+        it = next;
+    }
+}
+
+void Playlist::Crawler::DirectoryTreeCache::clear()
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    by_parent_.clear();
+    by_child_.clear();
+    entries_.clear();
+}
+
+size_t Playlist::Crawler::DirectoryTreeCache::size() const
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+    return entries_.size();
+}
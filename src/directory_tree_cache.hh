@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#ifndef DIRECTORY_TREE_CACHE_HH
+#define DIRECTORY_TREE_CACHE_HH
+
+#include "idtypes.hh"
+#include "logged_lock.hh"
+
+#include <map>
+#include <list>
+
+namespace Playlist
+{
+
+namespace Crawler
+{
+
+/*!
+ * Cache of parent/child relations between lists visited by the crawler.
+ *
+ * Each entry links a line in a parent list to the ID of the child list the
+ * line refers to, and optionally the number of items in the child list. This
+ * allows the crawler to descend into and ascend from directories it has
+ * visited before without asking the list broker for the list IDs again,
+ * which makes skipping back and forth over directory boundaries cheap.
+ *
+ * The cache is bounded, least recently used entries are evicted first. It
+ * must be kept in sync with the list broker by passing list invalidation
+ * events to #Playlist::Crawler::DirectoryTreeCache::list_invalidate().
+ *
+ * This class is thread-safe.
+ */
+class DirectoryTreeCache
+{
+  public:
+    /*!
+     * Default maximum number of parent/child relations kept in cache.
+     */
+    static constexpr size_t DEFAULT_MAX_ENTRIES = 256;
+
+    struct Child
+    {
+        ID::List list_id_;
+        bool is_size_known_;
+        unsigned int number_of_items_;
+
+        explicit Child():
+            is_size_known_(false),
+            number_of_items_(0)
+        {}
+    };
+
+  private:
+    struct Entry
+    {
+        ID::List parent_;
+        unsigned int line_;
+        Child child_;
+
+        explicit Entry(ID::List parent, unsigned int line, ID::List child):
+            parent_(parent),
+            line_(line)
+        {
+            child_.list_id_ = child;
+        }
+    };
+
+    using Entries = std::list<Entry>;
+    using Key = std::pair<ID::List, unsigned int>;
+
+    mutable LoggedLock::Mutex lock_;
+
+    const size_t max_entries_;
+
+    /*! Most recently used entries first. */
+    mutable Entries entries_;
+
+    std::map<Key, Entries::iterator> by_parent_;
+    std::map<ID::List, Entries::iterator> by_child_;
+
+  public:
+    DirectoryTreeCache(const DirectoryTreeCache &) = delete;
+    DirectoryTreeCache(DirectoryTreeCache &&) = delete;
+    DirectoryTreeCache &operator=(const DirectoryTreeCache &) = delete;
+    DirectoryTreeCache &operator=(DirectoryTreeCache &&) = delete;
+
+    explicit DirectoryTreeCache(size_t max_entries = DEFAULT_MAX_ENTRIES);
+
+    /*!
+     * Store child list ID of given line in parent list.
+     */
+    void put_child(ID::List parent, unsigned int line, ID::List child);
+
+    /*!
+     * Store number of items in a child list stored earlier.
+     */
+    void put_size(ID::List child, unsigned int number_of_items);
+
+    /*!
+     * Look up child list of given line in parent list.
+     */
+    bool lookup_child(ID::List parent, unsigned int line, Child &child) const;
+
+    /*!
+     * Look up parent list and line a child list has been entered from.
+     */
+    bool lookup_parent(ID::List child, ID::List &parent, unsigned int &line) const;
+
+    /*!
+     * Remove relation between given line in parent list and its child.
+     */
+    void forget_child(ID::List parent, unsigned int line);
+
+    /*!
+     * Update or remove entries referring to an invalidated list.
+     *
+     * \param list_id
+     *     The invalidated list.
+     *
+     * \param replacement_id
+     *     The list replacing \p list_id, having the same content. If invalid,
+     *     all entries referring to \p list_id are removed.
+     */
+    void list_invalidate(ID::List list_id, ID::List replacement_id);
+
+    void clear();
+
+    size_t size() const;
+
+  private:
+    void erase(Entries::iterator it);
+    void touch(Entries::iterator it) const;
+};
+
+}
+
+}
+
+#endif /* !DIRECTORY_TREE_CACHE_HH */
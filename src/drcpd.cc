@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015--2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015--2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -43,6 +43,8 @@
 #include "view_manager.hh"
 #include "view_play.hh"
 #include "view_search.hh"
+#include "xml_fragments.hh"
+#include "boot_timeline.hh"
 #include "dbus_iface.hh"
 #include "dbus_handlers.hh"
 #include "busy.hh"
@@ -238,6 +240,8 @@ static void timeout_config(bool start_timeout_timer,
 static int setup(const Parameters &parameters,
                  DCPFIFODispatchData &dispatch_data, GMainLoop **loop)
 {
+    BootTimeline::Phase phase("setup");
+
     msg_enable_syslog(!parameters.run_in_foreground);
     msg_enable_glib_message_redirection();
     msg_set_verbose_level(parameters.verbose_level);
@@ -259,6 +263,7 @@ static int setup(const Parameters &parameters,
 
     I18n::init();
     ViewFileBrowser::init_i18n();
+    XmlFragments::init_i18n();
 
     msg_vinfo(MESSAGE_LEVEL_DEBUG, "Attempting to open named pipes");
 
@@ -501,11 +506,19 @@ static void language_changed(const I18nConfigMgr &config_manager,
         I18n::switch_language(lang_id);
 }
 
+static bool init_view(ViewIface &view)
+{
+    BootTimeline::Phase phase("init", view.name_);
+    return view.init();
+}
+
 static void connect_everything(ViewManager::Manager &views,
                                DBus::SignalData &dbus_data,
                                const Configuration::DrcpdValues &config,
                                I18nConfigMgr &i18n_config_manager)
 {
+    BootTimeline::Phase phase("connect_everything");
+
     static ViewErrorSink::View error_sink(N_("Error"), views);
     static ViewInactive::View inactive("Inactive", views);
     static ViewFileBrowser::View fs(
@@ -550,31 +563,31 @@ static void connect_everything(ViewManager::Manager &views,
     views.add_view(play);
     views.add_view(search);
 
-    if(!error_sink.init())
+    if(!init_view(error_sink))
         return;
 
-    if(!fs.init())
+    if(!init_view(fs))
         return;
 
-    if(!airable.init())
+    if(!init_view(airable))
         return;
 
-    if(!upnp.init())
+    if(!init_view(upnp))
         return;
 
-    if(!app.init())
+    if(!init_view(app))
         return;
 
-    if(!rest.init())
+    if(!init_view(rest))
         return;
 
-    if(!roon.init())
+    if(!init_view(roon))
         return;
 
-    if(!play.init())
+    if(!init_view(play))
         return;
 
-    if(!search.init())
+    if(!init_view(search))
         return;
 
     if(!views.invoke_late_init_functions())
@@ -635,12 +648,18 @@ int main(int argc, char *argv[])
     static const Configuration::DrcpdValues default_drcpd_settings(0);
     ViewManager::Manager::ConfigMgr
         drcpd_config_manager(configuration_file_name, default_drcpd_settings);
-    drcpd_config_manager.load();
+    {
+        BootTimeline::Phase phase("load configuration");
+        drcpd_config_manager.load();
+    }
 
     static const Configuration::I18nValues
         default_i18n_settings(std::string("en"), std::string("US"));
     I18nConfigMgr i18n_config_manager(configuration_file_name, default_i18n_settings);
-    i18n_config_manager.load();
+    {
+        BootTimeline::Phase phase("load i18n configuration");
+        i18n_config_manager.load();
+    }
 
     static UI::EventQueue ui_event_queue(
         [] { defer_ui_event_processing(ui_events_processing_data); });
@@ -675,6 +694,8 @@ int main(int argc, char *argv[])
     connect_everything(view_manager, dbus_signal_data,
                        drcpd_config_manager.values(), i18n_config_manager);
 
+    BootTimeline::startup_completed();
+
     g_main_loop_run(loop);
 
     msg_vinfo(MESSAGE_LEVEL_IMPORTANT, "Shutting down");
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015, 2019  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015, 2019, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -24,6 +24,7 @@
 
 #include <streambuf>
 
+#include "gather_writer.hh"
 #include "named_pipe.h"
 #include "messages.h"
 
@@ -38,7 +39,7 @@
  * fd_out << "Hello world!" << std::endl;
  * \endcode
  */
-class FdStreambuf: public std::streambuf
+class FdStreambuf: public std::streambuf, public GatherWriter
 {
   private:
     int fd_;
@@ -69,6 +70,18 @@ class FdStreambuf: public std::streambuf
     {
         fd_ = (fd >= 0) ? fd : -1;
     }
+
+  protected:
+    ssize_t write_some(const struct iovec *iov, size_t count) override
+    {
+        if(fd_ >= 0)
+            return fifo_try_write_from_iovec(iov, count, fd_);
+
+        msg_error(EINVAL, LOG_CRIT,
+                  "Attempted to write %zu buffers, but fd not set", count);
+
+        return -1;
+    }
 };
 
 #endif /* !FDSTREAMBUF_HH */
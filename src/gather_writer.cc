@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <algorithm>
+#include <cstdint>
+
+#include "gather_writer.hh"
+#include "messages.h"
+
+bool GatherWriter::write_gathered(const struct iovec *iov, size_t count)
+{
+    struct iovec vec[8];
+    size_t n = 0;
+
+    while(true)
+    {
+        /* fill up pending buffers, skipping empty ones */
+        for(/* nothing */; count > 0 && n < sizeof(vec) / sizeof(vec[0]);
+            ++iov, --count)
+        {
+            if(iov->iov_len > 0)
+                vec[n++] = *iov;
+        }
+
+        if(n == 0)
+            return true;
+
+        const ssize_t len = write_some(vec, n);
+
+        if(len < 0)
+            return false;
+
+        if(len == 0)
+        {
+            msg_error(0, LOG_ERR, "Failed writing gathered data, no progress");
+            return false;
+        }
+
+        /* skip over what has been written */
+        size_t remaining = len;
+        size_t done = 0;
+
+        for(/* nothing */; done < n && remaining >= vec[done].iov_len; ++done)
+            remaining -= vec[done].iov_len;
+
+        if(done < n)
+        {
+            vec[done].iov_base = static_cast<uint8_t *>(vec[done].iov_base) + remaining;
+            vec[done].iov_len -= remaining;
+        }
+        else if(remaining > 0)
+        {
+            MSG_BUG("Wrote %zu bytes more than requested", remaining);
+            return false;
+        }
+
+        std::move(vec + done, vec + n, vec);
+        n -= done;
+    }
+}
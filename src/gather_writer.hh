@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#ifndef GATHER_WRITER_HH
+#define GATHER_WRITER_HH
+
+#include <sys/uio.h>
+
+/*!
+ * Interface for stream buffers which can write several buffers at once.
+ *
+ * Stream buffers may implement this interface in addition to
+ * \c std::streambuf so that users can pass multiple memory regions to the
+ * underlying file descriptor in a single system call, avoiding intermediate
+ * copies.
+ */
+class GatherWriter
+{
+  protected:
+    explicit GatherWriter() {}
+
+  public:
+    GatherWriter(const GatherWriter &) = delete;
+    GatherWriter &operator=(const GatherWriter &) = delete;
+
+    virtual ~GatherWriter() {}
+
+    /*!
+     * Write all given buffers in order.
+     *
+     * Partial writes are continued until all data has been written. A write
+     * which makes no progress is treated as error.
+     *
+     * \returns
+     *     True on success, false on error.
+     */
+    bool write_gathered(const struct iovec *iov, size_t count);
+
+  protected:
+    /*!
+     * Write as much of the given buffers as possible in a single attempt.
+     *
+     * \returns
+     *     Number of bytes written, or -1 on error. Implementations are
+     *     expected to log their errors.
+     */
+    virtual ssize_t write_some(const struct iovec *iov, size_t count) = 0;
+};
+
+#endif /* !GATHER_WRITER_HH */
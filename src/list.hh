@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015--2020, 2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015--2020, 2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -35,6 +35,8 @@
  */
 /*!@{*/
 
+namespace Search { class Key; }
+
 namespace List
 {
 
@@ -127,25 +129,94 @@ class TextItem: virtual public Item
   protected:
     I18n::String text_;
 
+    /*!
+     * Text owned by someone else, used instead of #List::TextItem::text_.
+     *
+     * Derived classes which use this must make sure that the text outlives
+     * the item.
+     */
+    const char *borrowed_text_;
+    bool borrowed_text_is_translatable_;
+
   public:
+    struct BorrowText {};
+
     TextItem(const TextItem &) = delete;
     TextItem &operator=(const TextItem &) = delete;
     explicit TextItem(TextItem &&) = default;
 
     explicit TextItem(unsigned int flags):
         Item(flags),
-        text_(false)
+        text_(false),
+        borrowed_text_(nullptr),
+        borrowed_text_is_translatable_(false)
     {}
 
     explicit TextItem(const char *text, bool text_is_translatable,
                       unsigned int flags):
         Item(flags),
-        text_(text_is_translatable, text)
+        text_(text_is_translatable, text),
+        borrowed_text_(nullptr),
+        borrowed_text_is_translatable_(false)
     {}
 
-    const char *get_text() const { return text_.get_text(); }
+    /*!
+     * Construct text item which refers to text stored elsewhere.
+     *
+     * The text is not copied.
+     */
+    explicit TextItem(BorrowText, const char *text, bool text_is_translatable,
+                      unsigned int flags):
+        Item(flags),
+        text_(false),
+        borrowed_text_(text != nullptr ? text : ""),
+        borrowed_text_is_translatable_(text_is_translatable)
+    {}
+
+    const char *get_text() const
+    {
+        if(borrowed_text_ == nullptr)
+            return text_.get_text();
+
+        if(borrowed_text_[0] == '\0')
+            return "";
+
+        return borrowed_text_is_translatable_ ? _(borrowed_text_) : borrowed_text_;
+    }
 
-    void update(I18n::String &&text) { text_ = std::move(text); }
+    void update(I18n::String &&text)
+    {
+        text_ = std::move(text);
+        borrowed_text_ = nullptr;
+    }
+};
+
+/*!
+ * A list item which can be found by searching in sorted lists.
+ *
+ * Searches compare casefolded item texts. Items derived from this class
+ * provide their search key directly so that list code does not need to know
+ * the concrete item type, and so that the key does not need to be computed
+ * again for each search.
+ *
+ * Derived classes will want to mix this class with #List::TextItem.
+ */
+class SearchableItem: virtual public Item
+{
+  protected:
+    explicit SearchableItem(unsigned int flags):
+        Item(flags)
+    {}
+
+  public:
+    SearchableItem(const SearchableItem &) = delete;
+    SearchableItem &operator=(const SearchableItem &) = delete;
+    explicit SearchableItem(SearchableItem &&) = default;
+
+    /*!
+     * Casefolded item text for comparison during searches.
+     */
+    virtual const Search::Key &get_search_key() const = 0;
 };
 
 class ListViewportBase
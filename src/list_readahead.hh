@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#ifndef LIST_READAHEAD_HH
+#define LIST_READAHEAD_HH
+
+#include "cache_segment.hh"
+
+#include <algorithm>
+
+/*!
+ * \addtogroup list_navigation
+ */
+/*!@{*/
+
+namespace List
+{
+
+/*!
+ * Direction-aware read-ahead policy for list browsing.
+ *
+ * An object of this class is fed with the cursor position and the first line
+ * displayed on screen each time the screen content is about to be updated.
+ * From the cursor movements, it derives the direction the user is scrolling
+ * into and how fast, and suggests a segment of the list which is likely to
+ * become visible soon.
+ *
+ * Initially, nothing is suggested. As soon as the cursor moves, the page
+ * next to the displayed page in moving direction is suggested. The further
+ * the cursor keeps moving into the same direction, the more pages are
+ * suggested, up to a configurable maximum. Jumping over whole pages (as in
+ * case of \c NAV_SCROLL_PAGES) widens the suggestion by the number of pages
+ * jumped. Changing direction starts over with a single page.
+ *
+ * This class does not know anything about list contents; it only computes
+ * line numbers.
+ */
+class ReadAheadPolicy
+{
+  public:
+    /*!
+     * Default maximum number of pages to read ahead.
+     */
+    static constexpr unsigned int DEFAULT_MAX_PAGES = 3;
+
+  private:
+    const unsigned int max_pages_;
+
+    bool have_cursor_;
+    unsigned int last_cursor_;
+
+    /*! Positive when scrolling down, negative when scrolling up. */
+    int direction_;
+
+    /*! Number of pages to read ahead in current direction. */
+    unsigned int pages_;
+
+  public:
+    ReadAheadPolicy(const ReadAheadPolicy &) = delete;
+    ReadAheadPolicy &operator=(const ReadAheadPolicy &) = delete;
+
+    explicit ReadAheadPolicy(unsigned int max_pages = DEFAULT_MAX_PAGES):
+        max_pages_(max_pages),
+        have_cursor_(false),
+        last_cursor_(0),
+        direction_(0),
+        pages_(0)
+    {}
+
+    unsigned int get_max_pages() const { return max_pages_; }
+
+    /*!
+     * Forget about previous movements, e.g., after entering another list.
+     */
+    void reset()
+    {
+        have_cursor_ = false;
+        direction_ = 0;
+        pages_ = 0;
+    }
+
+    /*!
+     * Take note of current position, compute segment to read ahead.
+     *
+     * \param cursor
+     *     Current cursor position in the list.
+     *
+     * \param first_displayed_line
+     *     The first line visible on screen.
+     *
+     * \param page_size
+     *     Number of lines visible on one screen.
+     *
+     * \param total_number_of_lines
+     *     Total number of lines in the list.
+     *
+     * \returns
+     *     The segment which should be loaded in background. The segment is
+     *     empty if there is nothing to read ahead.
+     */
+    Segment update(unsigned int cursor, unsigned int first_displayed_line,
+                   unsigned int page_size, unsigned int total_number_of_lines)
+    {
+        if(have_cursor_ && cursor != last_cursor_)
+        {
+            const int direction = cursor > last_cursor_ ? 1 : -1;
+            const unsigned int distance = (direction > 0
+                                           ? cursor - last_cursor_
+                                           : last_cursor_ - cursor);
+            const unsigned int step =
+                page_size > 0 ? (distance + page_size - 1) / page_size : 1;
+
+            if(direction == direction_)
+                pages_ = std::min(max_pages_, pages_ + step);
+            else
+                pages_ = std::min(max_pages_, step);
+
+            direction_ = direction;
+        }
+
+        have_cursor_ = true;
+        last_cursor_ = cursor;
+
+        if(direction_ == 0 || pages_ == 0 || page_size == 0 ||
+           first_displayed_line >= total_number_of_lines)
+            return Segment();
+
+        const unsigned int lines = pages_ * page_size;
+
+        if(direction_ > 0)
+        {
+            const unsigned int begin =
+                std::min(first_displayed_line + page_size, total_number_of_lines);
+            return Segment(begin,
+                           std::min(lines, total_number_of_lines - begin));
+        }
+        else
+        {
+            const unsigned int begin =
+                first_displayed_line > lines ? first_displayed_line - lines : 0;
+            return Segment(begin, first_displayed_line - begin);
+        }
+    }
+};
+
+}
+
+/*!@}*/
+
+#endif /* !LIST_READAHEAD_HH */
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015, 2016, 2017, 2019  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015, 2016, 2017, 2019, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -22,8 +22,6 @@
 #ifndef METADATA_PRELOADED_HH
 #define METADATA_PRELOADED_HH
 
-#include <string>
-
 /*!
  * \addtogroup metadata
  */
@@ -42,15 +40,23 @@ namespace MetaData
  * This is often the case with streams from TIDAL or Deezer played over
  * Airable. In this setting, the streams frequently do not contain any useful
  * meta data, but these data can be extracted from the Airable directory.
+ *
+ * The strings are not copied, but borrowed from the data the list item has
+ * been constructed from. The list item must keep these data alive for as long
+ * as it exists (see #ViewFileBrowser::FileItem).
  */
 class PreloadedSet
 {
   public:
-    const std::string artist_;
-    const std::string album_;
-    const std::string title_;
+    const char *const artist_;
+    const char *const album_;
+    const char *const title_;
 
-    explicit PreloadedSet() {}
+    explicit PreloadedSet():
+        artist_(""),
+        album_(""),
+        title_("")
+    {}
 
     explicit PreloadedSet(const char *artist, const char *album,
                           const char *title):
@@ -59,32 +65,9 @@ class PreloadedSet
         title_(title != nullptr ? title : "")
     {}
 
-    explicit PreloadedSet(const std::string &artist, const std::string &album,
-                          const std::string &title):
-        artist_(artist),
-        album_(album),
-        title_(title)
-    {}
-
     bool have_anything() const
     {
-        return !artist_.empty() || !album_.empty() || !title_.empty();
-    }
-
-    /* For special purposes: Like operator=(), but more explicit. */
-    void copy_from(const PreloadedSet &src)
-    {
-        const_cast<std::string &>(artist_) = src.artist_;
-        const_cast<std::string &>(album_) = src.album_;
-        const_cast<std::string &>(title_) = src.title_;
-    }
-
-    /* For special purposes: Clear all strings. */
-    void clear_individual_copy()
-    {
-        const_cast<std::string &>(artist_).clear();
-        const_cast<std::string &>(album_).clear();
-        const_cast<std::string &>(title_).clear();
+        return artist_[0] != '\0' || album_[0] != '\0' || title_[0] != '\0';
     }
 };
 
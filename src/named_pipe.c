@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015, 2016, 2019, 2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015, 2016, 2019, 2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -27,6 +27,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/uio.h>
 #include <errno.h>
 
 #include "named_pipe.h"
@@ -114,6 +115,19 @@ int fifo_write_from_buffer(const uint8_t *src, size_t count, int fd)
     return 0;
 }
 
+ssize_t fifo_try_write_from_iovec(const struct iovec *iov, size_t count, int fd)
+{
+    ssize_t len;
+
+    while((len = writev(fd, iov, count)) < 0 && errno == EINTR)
+        ;
+
+    if(len < 0)
+        msg_error(errno, LOG_ERR, "Failed writing to fd %d", fd);
+
+    return len;
+}
+
 int fifo_try_read_to_buffer(uint8_t *dest, size_t count, size_t *dest_pos,
                             int fd)
 {
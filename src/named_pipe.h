@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015, 2019  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015, 2019, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -25,6 +25,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <unistd.h>
+#include <sys/uio.h>
 
 struct fifo_pair
 {
@@ -42,6 +43,7 @@ void fifo_close_and_delete(int *fd, const char *devname);
 void fifo_close(int *fd);
 bool fifo_reopen(int *fd, const char *devname, bool write_not_read);
 int fifo_write_from_buffer(const uint8_t *src, size_t count, int fd);
+ssize_t fifo_try_write_from_iovec(const struct iovec *iov, size_t count, int fd);
 int fifo_try_read_to_buffer(uint8_t *dest, size_t count,
                             size_t *dest_pos, int fd);
 
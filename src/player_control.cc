@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2016--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -24,9 +24,12 @@
 #endif /* HAVE_CONFIG_H */
 
 #include <cstring>
+#include <array>
+#include <algorithm>
 
 #include "player_control.hh"
 #include "player_stopped_reason.hh"
+#include "player_push_batch.hh"
 #include "directory_crawler.hh"
 #include "audiosource.hh"
 #include "dbus_iface_proxies.hh"
@@ -194,6 +197,7 @@ void Player::Control::plug(const LocalPermissionsIface &permissions)
     skip_requests_.reset(nullptr);
     prefetch_next_item_op_ = nullptr;
     prefetch_uris_op_ = nullptr;
+    lookahead_uris_ops_.clear();
     retry_data_.reset();
 }
 
@@ -245,6 +249,8 @@ static bool invalidate_prefetched_uris(Player::AudioSource *asrc,
 
 void Player::Control::forget_queued_and_playing()
 {
+    cancel_pending_pushes();
+
     if(player_data_ != nullptr)
     {
         invalidate_prefetched_uris(audio_source_, *player_data_);
@@ -259,6 +265,7 @@ void Player::Control::forget_queued_and_playing()
 static void cancel_prefetch_ops(
         std::shared_ptr<Playlist::Crawler::FindNextOpBase> find_next,
         std::shared_ptr<Playlist::Crawler::GetURIsOpBase> get_uris,
+        std::deque<Player::Control::LookaheadURIsOp> &lookahead_uris,
         Playlist::Crawler::Handle &ch)
 {
     if(find_next != nullptr)
@@ -273,6 +280,11 @@ static void cancel_prefetch_ops(
         get_uris = nullptr;
     }
 
+    for(auto &l : lookahead_uris)
+        l.op_->cancel();
+
+    lookahead_uris.clear();
+
     if(ch != nullptr)
         ch->clear_bookmark(Playlist::Crawler::Bookmark::PREFETCH_CURSOR);
 }
@@ -302,7 +314,8 @@ void Player::Control::unplug(bool is_complete_unplug)
     prefetch_direction_after_failure_ = Playlist::Crawler::Direction::FORWARD;
 
     cancel_prefetch_ops(std::move(prefetch_next_item_op_),
-                        std::move(prefetch_uris_op_), crawler_handle_);
+                        std::move(prefetch_uris_op_),
+                        lookahead_uris_ops_, crawler_handle_);
 
     if(is_complete_unplug)
     {
@@ -451,29 +464,25 @@ void Player::Control::repeat_mode_toggle_request() const
                                                   nullptr, nullptr, nullptr);
 }
 
-void Player::Control::shuffle_mode_toggle_request() const
+bool Player::Control::shuffle_mode_toggle_request()
 {
     if(permissions_ != nullptr && !permissions_->can_toggle_shuffle())
     {
         msg_error(EPERM, LOG_NOTICE, "Ignoring shuffle mode toggle request");
-        return;
+        return false;
     }
 
     if(crawler_handle_ != nullptr)
-    {
-        msg_error(ENOSYS, LOG_NOTICE,
-                  "Shuffle mode not implemented yet (see tickets #27, #40, #80)");
-        return;
-    }
+        return toggle_crawler_shuffle_mode();
 
     if(audio_source_ == nullptr)
-        return;
+        return false;
 
     switch(audio_source_->get_state())
     {
       case AudioSourceState::DESELECTED:
       case AudioSourceState::REQUESTED:
-        return;
+        return false;
 
       case AudioSourceState::SELECTED:
         break;
@@ -484,6 +493,47 @@ void Player::Control::shuffle_mode_toggle_request() const
     if(proxy != nullptr)
         tdbus_splay_playback_call_set_shuffle_mode(proxy, "toggle",
                                                    nullptr, nullptr, nullptr);
+
+    return false;
+}
+
+bool Player::Control::toggle_crawler_shuffle_mode()
+{
+    using DirCursor = Playlist::Crawler::DirectoryCrawler::Cursor;
+
+    auto &crawler(Playlist::Crawler::DirectoryCrawler::get_crawler(*crawler_handle_));
+    const bool is_enabled = crawler.toggle_shuffle_mode();
+
+    /* the item queued in the player already is not affected, but all
+     * subsequent items are found from the updated cursors */
+    static const std::array<Playlist::Crawler::Bookmark, 4> bookmarks
+    {
+        Playlist::Crawler::Bookmark::ABOUT_TO_PLAY,
+        Playlist::Crawler::Bookmark::CURRENTLY_PLAYING,
+        Playlist::Crawler::Bookmark::PREFETCH_CURSOR,
+        Playlist::Crawler::Bookmark::SKIP_CURSOR,
+    };
+
+    for(const auto bm : bookmarks)
+    {
+        const auto *const c = crawler_handle_->get_bookmark(bm);
+
+        if(c == nullptr)
+            continue;
+
+        auto pos(c->clone_as<DirCursor>());
+        crawler.apply_shuffle_mode(*pos);
+        crawler_handle_->bookmark(bm, std::move(pos));
+    }
+
+    if(player_data_ == nullptr)
+        return false;
+
+    return player_data_->set_reported_playback_state(
+                player_data_->get_repeat_mode(),
+                is_enabled
+                ? DBus::ReportedShuffleMode::ON
+                : DBus::ReportedShuffleMode::OFF);
 }
 
 static void not_attached_bug(const char *what, bool and_crawler = false)
@@ -678,24 +728,7 @@ bool Player::Control::found_item_uris_for_playing(
     if(op.is_op_failure() || op.has_no_uris())
     {
         /* skip this one, maybe the next one will work */
-        if(permissions_->can_skip_on_error())
-        {
-            switch(from_direction)
-            {
-              case Playlist::Crawler::Direction::FORWARD:
-                skip_forward_request();
-                return true;
-
-              case Playlist::Crawler::Direction::BACKWARD:
-                skip_backward_request();
-                return true;
-
-              case Playlist::Crawler::Direction::NONE:
-                break;
-            }
-        }
-
-        return false;
+        return skip_unplayable_stream(from_direction);
     }
 
     switch(player_data_->get_intention())
@@ -715,7 +748,9 @@ bool Player::Control::found_item_uris_for_playing(
       case UserIntention::PAUSING:
         if(queue_item_from_op(op, from_direction,
                               InsertMode::REPLACE_ALL,
-                              PlayNewMode::SEND_PAUSE_COMMAND_IF_IDLE))
+                              PlayNewMode::SEND_PAUSE_COMMAND_IF_IDLE,
+                              [this, from_direction]
+                              { skip_unplayable_stream(from_direction); }))
         {
             start_prefetch_next_item("found URIs for first stream",
                                      Playlist::Crawler::Bookmark::ABOUT_TO_PLAY,
@@ -736,7 +771,38 @@ bool Player::Control::found_item_uris_for_playing(
       case UserIntention::LISTENING:
         return queue_item_from_op(op, from_direction,
                                   InsertMode::REPLACE_ALL,
-                                  PlayNewMode::SEND_PLAY_COMMAND_IF_IDLE);
+                                  PlayNewMode::SEND_PLAY_COMMAND_IF_IDLE,
+                                  [this, from_direction]
+                                  { skip_unplayable_stream(from_direction); });
+    }
+
+    return false;
+}
+
+/*!
+ * Skip over a stream which cannot be played, if permitted.
+ *
+ * 
+eturns
+ *     True if a skip request has been started, false otherwise.
+ */
+bool Player::Control::skip_unplayable_stream(Playlist::Crawler::Direction from_direction)
+{
+    if(permissions_ == nullptr || !permissions_->can_skip_on_error())
+        return false;
+
+    switch(from_direction)
+    {
+      case Playlist::Crawler::Direction::FORWARD:
+        skip_forward_request();
+        return true;
+
+      case Playlist::Crawler::Direction::BACKWARD:
+        skip_backward_request();
+        return true;
+
+      case Playlist::Crawler::Direction::NONE:
+        break;
     }
 
     return false;
@@ -1104,7 +1170,8 @@ bool Player::Control::skip_request_prepare(
             const auto lock_ctrl(lock());
 
             cancel_prefetch_ops(std::move(prefetch_next_item_op_),
-                                std::move(prefetch_uris_op_), crawler_handle_);
+                                std::move(prefetch_uris_op_),
+                                lookahead_uris_ops_, crawler_handle_);
 
             if(crawler_handle_ == nullptr)
                 return nullptr;
@@ -1590,6 +1657,7 @@ Player::Control::stop_notification_ok(ID::Stream stream_id)
     retry_data_.reset();
 
     if(prefetch_next_item_op_ == nullptr && prefetch_uris_op_ == nullptr &&
+       lookahead_uris_ops_.empty() &&
        (!player_data_->queued_streams_get().is_player_queue_filled() ||
         expected != StreamExpected::OURS_WRONG_ID))
     {
@@ -1628,16 +1696,314 @@ static GVariant *to_gvariant(const MetaData::Set &md)
     return g_variant_builder_end(&builder);
 }
 
+class Player::Control::PendingPush
+{
+  public:
+    /*!
+     * Passed as user data to the D-Bus push call.
+     */
+    struct Token
+    {
+        std::shared_ptr<PendingPush> push_;
+        const size_t index_;
+        const ID::OurStream stream_id_;
+
+        explicit Token(std::shared_ptr<PendingPush> push, size_t index,
+                       ID::OurStream stream_id):
+            push_(std::move(push)),
+            index_(index),
+            stream_id_(stream_id)
+        {}
+    };
+
+  private:
+    Control *control_;
+    GCancellable *const cancellable_;
+    PushBatch batch_;
+
+  public:
+    const AudioSource &audio_source_;
+
+  private:
+    PlayNewMode play_new_mode_;
+    std::string reason_;
+
+  public:
+    PendingPush(const PendingPush &) = delete;
+    PendingPush &operator=(const PendingPush &) = delete;
+
+    explicit PendingPush(Control &control, const AudioSource &asrc):
+        control_(&control),
+        cancellable_(g_cancellable_new()),
+        audio_source_(asrc),
+        play_new_mode_(PlayNewMode::KEEP)
+    {}
+
+    ~PendingPush() { g_object_unref(cancellable_); }
+
+    const PushBatch &get_batch() const { return batch_; }
+
+    /*!
+     * Do not process the answers to the pushes in this batch.
+     *
+     * The pushes themselves cannot be taken back. Their answers are ignored.
+     */
+    void cancel()
+    {
+        control_ = nullptr;
+        g_cancellable_cancel(cancellable_);
+    }
+
+    static void push(Control &control, ID::OurStream stream_id,
+                     const GVariantWrapper &stream_key,
+                     const MetaData::Set &meta_data, gint16 keep_first_n,
+                     PlayNewMode play_new_mode, GVariantWrapper &&uris,
+                     const AudioSource &asrc, std::string &&reason,
+                     std::function<void()> &&rejected_fn);
+
+    static void seal(Control &control, const std::shared_ptr<PendingPush> &push);
+
+  private:
+    static void push_done(GObject *source_object, GAsyncResult *res,
+                          gpointer user_data);
+
+    static void process_completed_batches(Control &control);
+
+    void process_result(Data &player);
+};
+
+static void start_playback_done(GObject *source_object, GAsyncResult *res,
+                                gpointer user_data)
+{
+    GErrorWrapper error;
+    tdbus_splay_playback_call_start_finish(TDBUS_SPLAY_PLAYBACK(source_object),
+                                           res, error.await());
+
+    if(error.log_failure("Start playback"))
+        msg_error(0, LOG_NOTICE, "Failed sending start playback message");
+}
+
+static void pause_playback_done(GObject *source_object, GAsyncResult *res,
+                                gpointer user_data)
+{
+    GErrorWrapper error;
+    tdbus_splay_playback_call_pause_finish(TDBUS_SPLAY_PLAYBACK(source_object),
+                                           res, error.await());
+
+    if(error.log_failure("Pause playback"))
+        msg_error(0, LOG_NOTICE, "Failed sending pause playback message");
+}
+
+/*!
+ * Send stream to the stream player, collect it in current batch.
+ *
+ * If the player control is collecting pushes (see
+ * #Player::Control::begin_push_batch()), then the stream is added to the open
+ * batch. A push which manipulates the URL FIFO other than by appending to it
+ * starts a new batch because the streams it drops must be known before the
+ * streams pushed after it can be evaluated. If the player control is not
+ * collecting pushes, then the stream forms a batch of its own.
+ */
+void Player::Control::PendingPush::push(
+        Control &control, ID::OurStream stream_id,
+        const GVariantWrapper &stream_key, const MetaData::Set &meta_data,
+        gint16 keep_first_n, PlayNewMode play_new_mode, GVariantWrapper &&uris,
+        const AudioSource &asrc, std::string &&reason,
+        std::function<void()> &&rejected_fn)
+{
+    auto &open_batch(control.open_push_batch_);
+
+    if(open_batch != nullptr &&
+       (&open_batch->audio_source_ != &asrc || keep_first_n != -1))
+    {
+        auto previous(std::move(open_batch));
+        open_batch = nullptr;
+        seal(control, previous);
+    }
+
+    std::shared_ptr<PendingPush> push;
+
+    if(open_batch != nullptr)
+        push = open_batch;
+    else
+    {
+        push = std::make_shared<PendingPush>(control, asrc);
+        control.pending_pushes_.push_back(push);
+
+        if(control.push_batch_nesting_ > 0)
+            open_batch = push;
+    }
+
+    const size_t idx = push->batch_.add(stream_id, std::move(rejected_fn));
+
+    if(play_new_mode != PlayNewMode::KEEP &&
+       push->play_new_mode_ == PlayNewMode::KEEP)
+    {
+        push->play_new_mode_ = play_new_mode;
+        push->reason_ = std::move(reason);
+    }
+
+    auto *urlfifo_proxy = asrc.get_urlfifo_proxy();
+
+    if(urlfifo_proxy == nullptr)
+        push->batch_.answer(idx, PushBatch::Answer(false, false, {}));
+    else
+        tdbus_splay_urlfifo_call_push(
+            urlfifo_proxy, stream_id.get().get_raw_id(),
+            GVariantWrapper::move(uris), GVariantWrapper::get(stream_key),
+            0, "ms", 0, "ms", keep_first_n, to_gvariant(meta_data),
+            push->cancellable_, push_done, new Token(push, idx, stream_id));
+
+    if(push != open_batch)
+        seal(control, push);
+}
+
+void Player::Control::PendingPush::seal(Control &control,
+                                        const std::shared_ptr<PendingPush> &push)
+{
+    if(push->batch_.seal())
+        process_completed_batches(control);
+}
+
+void Player::Control::PendingPush::push_done(GObject *source_object,
+                                             GAsyncResult *res,
+                                             gpointer user_data)
+{
+    std::unique_ptr<Token> token(static_cast<Token *>(user_data));
+    PendingPush &push(*token->push_);
+
+    gboolean fifo_overflow = FALSE;
+    gboolean is_playing = FALSE;
+    GVariant *raw_dropped_ids_before = nullptr;
+    GVariant *raw_dropped_ids_now = nullptr;
+    GErrorWrapper error;
+
+    tdbus_splay_urlfifo_call_push_finish(TDBUS_SPLAY_URLFIFO(source_object),
+                                         &fifo_overflow, &is_playing,
+                                         &raw_dropped_ids_before,
+                                         &raw_dropped_ids_now,
+                                         res, error.await());
+
+    GVariantWrapper dropped_before(raw_dropped_ids_before,
+                                   GVariantWrapper::Transfer::JUST_MOVE);
+    GVariantWrapper dropped_now(raw_dropped_ids_now,
+                                GVariantWrapper::Transfer::JUST_MOVE);
+
+    if(push.control_ == nullptr)
+    {
+        error.noticed();
+        return;
+    }
+
+    Control &control(*push.control_);
+    auto locks(control.lock());
+
+    PushBatch::Answer answer;
+
+    if(error.log_failure("Push stream"))
+        msg_error(0, LOG_NOTICE, "Failed queuing URI to streamplayer");
+    else
+    {
+        if(fifo_overflow)
+            MSG_BUG("URL FIFO overflow, losing item %u",
+                    token->stream_id_.get().get_raw_id());
+
+        std::vector<ID::Stream> dropped_ids_vec;
+        move_gvariant_ids_to_vector(std::move(dropped_before), dropped_ids_vec);
+        move_gvariant_ids_to_vector(std::move(dropped_now), dropped_ids_vec);
+        answer = PushBatch::Answer(fifo_overflow, is_playing,
+                                   std::move(dropped_ids_vec));
+    }
+
+    if(push.batch_.answer(token->index_, std::move(answer)))
+        process_completed_batches(control);
+}
+
+/*!
+ * Process complete batches in push order.
+ *
+ * Batches may complete out of order, e.g., if they have been sent to
+ * different audio sources or if there is no URL FIFO to send them to. A
+ * complete batch is kept back until all batches pushed before it have been
+ * processed.
+ */
+void Player::Control::PendingPush::process_completed_batches(Control &control)
+{
+    auto &pending(control.pending_pushes_);
+
+    while(!pending.empty() && pending.front()->batch_.is_complete())
+    {
+        auto push(std::move(pending.front()));
+        pending.pop_front();
+
+        if(control.player_data_ != nullptr)
+            push->process_result(*control.player_data_);
+    }
+}
+
+/*!
+ * Evaluate stream player's answers to a batch, start playing if requested.
+ *
+ * Rejected streams are removed from the queue. In case any of them has been
+ * pushed with a rejection handler, then these handlers are called instead of
+ * sending the play or pause command because they decide how to go on.
+ */
+void Player::Control::PendingPush::process_result(Data &player)
+{
+    const auto result(batch_.take_result());
+
+    player.player_dropped_from_queue(result.dropped_);
+
+    for(const auto &id : result.rejected_)
+        player.queued_stream_remove(id);
+
+    for(const auto &id : result.accepted_)
+        player.queued_stream_sent_to_player(id);
+
+    if(!result.rejected_fns_.empty())
+    {
+        for(const auto &fn : result.rejected_fns_)
+            fn();
+
+        return;
+    }
+
+    if(result.is_playing_ || result.accepted_.empty())
+        return;
+
+    switch(play_new_mode_)
+    {
+      case Player::Control::PlayNewMode::KEEP:
+        break;
+
+      case Player::Control::PlayNewMode::SEND_PLAY_COMMAND_IF_IDLE:
+        if(auto *proxy = audio_source_.get_playback_proxy())
+            tdbus_splay_playback_call_start(proxy, reason_.c_str(), nullptr,
+                                            start_playback_done, nullptr);
+        break;
+
+      case Player::Control::PlayNewMode::SEND_PAUSE_COMMAND_IF_IDLE:
+        if(auto *proxy = audio_source_.get_playback_proxy())
+            tdbus_splay_playback_call_pause(proxy, reason_.c_str(), nullptr,
+                                            pause_playback_done, nullptr);
+        break;
+    }
+}
+
 /*!
  * Try to fill up the streamplayer FIFO.
  *
- * The function sends the given URI to the stream player's queue.
+ * The function sends the given URI to the stream player's queue. The push is
+ * done asynchronously, see #Player::Control::PendingPush. The answer is
+ * processed when all answers of the batch the push belongs to have been
+ * received, which is also when the play or pause command is sent if
+ * requested.
  *
  * No exception thrown in here because the caller needs to react to specific
  * situations.
  *
- * \param player
- *     Player data containing the queue.
+ * \param control
+ *     The player control which keeps track of pending pushes.
  *
  * \param stream_id
  *     Internal ID of the stream for mapping it to extra information maintained
@@ -1669,24 +2035,28 @@ static GVariant *to_gvariant(const MetaData::Set &md)
  *     String which describes in which contexts the URI is sent to the player.
  *     It is sent along with the play or pause request to the player.
  *
+ * \param rejected_fn
+ *     Called if the stream player rejects the stream, after the stream has
+ *     been removed from the player data. May be \c nullptr.
+ *
  * \returns
- *     True in case of success, false otherwise.
+ *     True in case the push has been sent, false otherwise. Note that a push
+ *     which has been sent may still fail, in which case the stream is removed
+ *     from the player data and \p rejected_fn is called when the failure is
+ *     noticed.
  */
 static bool send_selected_file_uri_to_streamplayer(
-        Player::Data &player, ID::OurStream stream_id,
+        Player::Control &control, ID::OurStream stream_id,
         const GVariantWrapper &stream_key,
         const MetaData::Set &meta_data,
         Player::Control::InsertMode insert_mode,
         Player::Control::PlayNewMode play_new_mode,
         GVariantWrapper &&uris, const Player::AudioSource &asrc,
-        std::string &&reason)
+        std::string &&reason, std::function<void()> &&rejected_fn)
 {
     if(g_variant_n_children(GVariantWrapper::get(uris)) == 0)
         return false;
 
-    gboolean fifo_overflow = FALSE;
-    gboolean is_playing = FALSE;
-
     gint16 keep_first_n = -1;
 
     switch(insert_mode)
@@ -1703,81 +2073,20 @@ static bool send_selected_file_uri_to_streamplayer(
         break;
     }
 
-    auto *urlfifo_proxy = asrc.get_urlfifo_proxy();
-
-    if(urlfifo_proxy != nullptr)
-    {
-        GVariant *raw_dropped_ids_before = nullptr;
-        GVariant *raw_dropped_ids_now = nullptr;
-        GErrorWrapper error;
-        tdbus_splay_urlfifo_call_push_sync(
-            urlfifo_proxy, stream_id.get().get_raw_id(),
-            GVariantWrapper::move(uris), GVariantWrapper::get(stream_key),
-            0, "ms", 0, "ms", keep_first_n, to_gvariant(meta_data),
-            &fifo_overflow, &is_playing, &raw_dropped_ids_before,
-            &raw_dropped_ids_now, nullptr, error.await());
-
-        if(error.log_failure("Push stream"))
-        {
-            msg_error(0, LOG_NOTICE, "Failed queuing URI to streamplayer");
-            return false;
-        }
-
-        std::vector<ID::Stream> dropped_ids_vec;
-        move_gvariant_ids_to_vector(
-                        GVariantWrapper(raw_dropped_ids_before,
-                                        GVariantWrapper::Transfer::JUST_MOVE),
-                        dropped_ids_vec);
-        move_gvariant_ids_to_vector(
-                        GVariantWrapper(raw_dropped_ids_now,
-                                        GVariantWrapper::Transfer::JUST_MOVE),
-                        dropped_ids_vec);
-        player.player_dropped_from_queue(dropped_ids_vec);
-    }
-
-    if(fifo_overflow)
-    {
-        MSG_BUG("URL FIFO overflow, losing item %u", stream_id.get().get_raw_id());
-        return false;
-    }
-
-    player.queued_stream_sent_to_player(stream_id);
-
-    if(is_playing)
-        return true;
-
-    switch(play_new_mode)
-    {
-      case Player::Control::PlayNewMode::KEEP:
-        break;
-
-      case Player::Control::PlayNewMode::SEND_PLAY_COMMAND_IF_IDLE:
-        if(!send_play_command(&asrc, std::move(reason)))
-        {
-            msg_error(0, LOG_NOTICE, "Failed sending start playback message");
-            return false;
-        }
-
-        break;
-
-      case Player::Control::PlayNewMode::SEND_PAUSE_COMMAND_IF_IDLE:
-        if(!send_pause_command(&asrc, std::move(reason)))
-        {
-            msg_error(0, LOG_NOTICE, "Failed sending pause playback message");
-            return false;
-        }
-
-        break;
-    }
-
+    Player::Control::PendingPush::push(control, stream_id, stream_key,
+                                       meta_data, keep_first_n, play_new_mode,
+                                       std::move(uris), asrc, std::move(reason),
+                                       std::move(rejected_fn));
     return true;
 }
 
 static bool
-queue_stream_or_forget(Player::Data &player, ID::OurStream stream_id,
+queue_stream_or_forget(Player::Control &control, Player::Data &player,
+                       ID::OurStream stream_id,
                        Player::Control::InsertMode insert_mode,
                        Player::Control::PlayNewMode play_new_mode,
-                       const Player::AudioSource *asrc, std::string &&reason)
+                       const Player::AudioSource *asrc, std::string &&reason,
+                       std::function<void()> &&rejected_fn = nullptr)
 {
     const GVariantWrapper *stream_key;
     GVariantWrapper uris(player.mk_stream_uris_for_player(stream_id, stream_key));
@@ -1789,11 +2098,12 @@ queue_stream_or_forget(Player::Data &player, ID::OurStream stream_id,
         const auto &meta_data(player.get_queued_meta_data(stream_id));
         reason += ", ID " + std::to_string(stream_id.get().get_raw_id());
         failed =
-            !send_selected_file_uri_to_streamplayer(player, stream_id,
+            !send_selected_file_uri_to_streamplayer(control, stream_id,
                                                     *stream_key, meta_data,
                                                     insert_mode, play_new_mode,
                                                     std::move(uris), *asrc,
-                                                    std::move(reason));
+                                                    std::move(reason),
+                                                    std::move(rejected_fn));
     }
 
     if(failed)
@@ -1802,6 +2112,49 @@ queue_stream_or_forget(Player::Data &player, ID::OurStream stream_id,
     return !failed;
 }
 
+void Player::Control::begin_push_batch()
+{
+    ++push_batch_nesting_;
+}
+
+void Player::Control::end_push_batch()
+{
+    msg_log_assert(push_batch_nesting_ > 0);
+
+    if(--push_batch_nesting_ > 0 || open_push_batch_ == nullptr)
+        return;
+
+    auto push(std::move(open_push_batch_));
+    open_push_batch_ = nullptr;
+    PendingPush::seal(*this, push);
+}
+
+void Player::Control::cancel_pending_pushes()
+{
+    for(auto &push : pending_pushes_)
+    {
+        /* answers still outstanding are going to be ignored, so only the
+         * streams the stream player has confirmed are known to be queued;
+         * all other streams are treated like failed pushes */
+        if(player_data_ != nullptr)
+        {
+            const auto &batch(push->get_batch());
+
+            batch.for_each_accepted(
+                [this] (ID::OurStream stream_id)
+                { player_data_->queued_stream_sent_to_player(stream_id); });
+            batch.for_each_not_accepted(
+                [this] (ID::OurStream stream_id)
+                { player_data_->queued_stream_remove(stream_id); });
+        }
+
+        push->cancel();
+    }
+
+    pending_pushes_.clear();
+    open_push_batch_ = nullptr;
+}
+
 static bool bookmark_about_to_play_next(const Player::Data &data,
                                         Playlist::Crawler::Handle &crawler_handle)
 {
@@ -2057,7 +2410,14 @@ void Player::Control::start_prefetch_next_item(
     if(skip_requests_.is_active())
         return;
 
-    if(player_data_->queued_streams_get().is_full(permissions_->maximum_number_of_prefetched_streams()))
+    /* items being resolved count as queued */
+    const size_t max_streams = permissions_->maximum_number_of_prefetched_streams();
+    const size_t in_flight = lookahead_uris_ops_.size();
+
+    if(in_flight >= MAX_CONCURRENT_LOOKAHEAD_OPS ||
+       player_data_->queued_streams_get().is_full(max_streams > in_flight
+                                                  ? max_streams - in_flight
+                                                  : 0))
         return;
 
     const Playlist::Crawler::CursorBase *from_pos = nullptr;
@@ -2199,7 +2559,8 @@ bool Player::Control::found_prefetched_item(Playlist::Crawler::FindNextOpBase &o
             MSG_BUG_IF(finished_notification_ == nullptr,
                        "No finished playing notification function");
 
-            if(finished_notification_ != nullptr)
+            /* not finished yet if there are still items being resolved */
+            if(finished_notification_ != nullptr && lookahead_uris_ops_.empty())
                 finished_notification_(FinishedWith::PREFETCHING);
 
             return true;
@@ -2226,36 +2587,46 @@ bool Player::Control::found_prefetched_item(Playlist::Crawler::FindNextOpBase &o
 
     //if(crawler.retrieve_item_information(
     //        [this] (auto &c, auto r) { async_stream_details_prefetched(c, r); }))
-    prefetch_uris_op_ =
+    auto uris_op =
         Playlist::Crawler::DirectoryCrawler::get_crawler(*crawler_handle_)
         .mk_op_get_uris(
             "Prefetch next item's URIs for gapless playback",
             std::move(pos), std::move(op.result_.meta_data_),
-            [this, d = op.direction_, force_play_uri_when_available] (auto &op_inner)
-            { return found_prefetched_item_uris(op_inner, d, force_play_uri_when_available); },
+            [this] (auto &op_inner) { return found_prefetched_item_uris(op_inner); },
             Playlist::Crawler::OperationBase::CompletionCallbackFilter::SUPPRESS_CANCELED);
 
-    if(!crawler_handle_->run(prefetch_uris_op_))
+    lookahead_uris_ops_.emplace_back(uris_op, op.direction_,
+                                     force_play_uri_when_available);
+
+    if(!crawler_handle_->run(uris_op))
     {
         MSG_BUG("Failed running prefetch URIs for gapless playback");
+        lookahead_uris_ops_.pop_back();
         return false;
     }
 
+    /* search for the next item while this item's URIs are being retrieved */
+    start_prefetch_next_item("pipelined lookahead",
+                             Playlist::Crawler::Bookmark::PREFETCH_CURSOR,
+                             prefetch_direction_after_failure_, false,
+                             Execution::NOW);
+
     return true;
 }
 
-bool Player::Control::found_prefetched_item_uris(
-        Playlist::Crawler::GetURIsOpBase &op,
-        Playlist::Crawler::Direction from_direction,
-        bool force_play_uri_when_available)
+bool Player::Control::found_prefetched_item_uris(Playlist::Crawler::GetURIsOpBase &op)
 {
     auto locks(lock());
 
     if(op.is_op_canceled())
         return false;
 
-    if(&op == prefetch_uris_op_.get())
-        prefetch_uris_op_ = nullptr;
+    if(std::none_of(lookahead_uris_ops_.begin(), lookahead_uris_ops_.end(),
+                    [&op] (const auto &l) { return l.op_.get() == &op; }))
+    {
+        /* processed already while draining the queue, or forgotten */
+        return false;
+    }
 
     if(player_data_ == nullptr)
     {
@@ -2263,6 +2634,39 @@ bool Player::Control::found_prefetched_item_uris(
         return false;
     }
 
+    /* process all finished operations up to the first one still running,
+     * push their streams in one batch */
+    bool result = false;
+
+    begin_push_batch();
+
+    while(!lookahead_uris_ops_.empty())
+    {
+        const auto &front(lookahead_uris_ops_.front());
+
+        if(!front.op_->is_op_canceled() &&
+           !front.op_->is_op_successful() && !front.op_->is_op_failure())
+            break;
+
+        const auto l(std::move(lookahead_uris_ops_.front()));
+        lookahead_uris_ops_.pop_front();
+
+        if(!l.op_->is_op_canceled() &&
+           process_prefetched_item_uris(*l.op_, l.direction_,
+                                        l.force_play_uri_when_available_))
+            result = true;
+    }
+
+    end_push_batch();
+
+    return result;
+}
+
+bool Player::Control::process_prefetched_item_uris(
+        Playlist::Crawler::GetURIsOpBase &op,
+        Playlist::Crawler::Direction from_direction,
+        bool force_play_uri_when_available)
+{
     if(op.is_op_failure() || op.has_no_uris())
     {
         /* skip this one, maybe the next one will work */
@@ -2320,7 +2724,8 @@ bool Player::Control::found_prefetched_item_uris(
 bool
 Player::Control::queue_item_from_op(Playlist::Crawler::GetURIsOpBase &op,
                                     Playlist::Crawler::Direction direction,
-                                    InsertMode insert_mode, PlayNewMode play_new_mode)
+                                    InsertMode insert_mode, PlayNewMode play_new_mode,
+                                    std::function<void()> &&rejected_fn)
 {
     using DirCursor = Playlist::Crawler::DirectoryCrawler::Cursor;
 
@@ -2382,9 +2787,9 @@ Player::Control::queue_item_from_op(Playlist::Crawler::GetURIsOpBase &op,
     if(!stream_id.get().is_valid())
         return false;
 
-    return queue_stream_or_forget(*player_data_, stream_id, insert_mode,
-                                  play_new_mode, audio_source_,
-                                  "have stream URLs");
+    return queue_stream_or_forget(*this, *player_data_, stream_id,
+                                  insert_mode, play_new_mode, audio_source_,
+                                  "have stream URLs", std::move(rejected_fn));
 }
 
 Player::Control::ReplayResult
@@ -2405,22 +2810,43 @@ Player::Control::replay(ID::OurStream stream_id, bool is_retry,
         msg_info("Retry stream %u", stream_id.get().get_raw_id());
 
     player_data_->prepare_stream_for_recovery(stream_id);
+
+    begin_push_batch();
+
+    /* a retry which fails only when the stream player answers is treated
+     * like one which fails right here: give up, the player has stopped */
     const bool is_queued =
-        queue_stream_or_forget(*player_data_, stream_id,
+        queue_stream_or_forget(*this, *player_data_, stream_id,
                                InsertMode::REPLACE_ALL, play_new_mode,
-                               audio_source_, "replay stream");
+                               audio_source_, "replay stream",
+                               is_retry
+                               ? std::function<void()>(
+                                    [this, stream_id]
+                                    {
+                                        msg_info("Retry of stream %u rejected",
+                                                 stream_id.get().get_raw_id());
+
+                                        if(finished_notification_ != nullptr)
+                                            finished_notification_(FinishedWith::PLAYING);
+                                    })
+                               : nullptr);
 
     if(!is_queued && is_retry)
+    {
+        end_push_batch();
         return ReplayResult::RETRY_FAILED_HARD;
+    }
 
     const auto queued_ids(player_data_->copy_all_queued_streams_for_recovery());
 
     for(const auto id : queued_ids)
         if(id != stream_id)
-            queue_stream_or_forget(*player_data_, id,
+            queue_stream_or_forget(*this, *player_data_, id,
                                    InsertMode::APPEND, PlayNewMode::KEEP,
                                    audio_source_, "replay queued stream");
 
+    end_push_batch();
+
     msg_info("Queued %zu streams once again", queued_ids.size());
 
     return queued_ids.empty() ? ReplayResult::EMPTY_QUEUE : ReplayResult::OK;
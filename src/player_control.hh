@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2016--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -25,6 +25,8 @@
 #include "player_control_skipper.hh"
 #include "player_permissions.hh"
 
+#include <deque>
+
 namespace Player
 {
 
@@ -77,6 +79,29 @@ class Control
         PLAYING,
     };
 
+    /*!
+     * Operation for getting details of an item found by lookahead.
+     */
+    struct LookaheadURIsOp
+    {
+        std::shared_ptr<Playlist::Crawler::GetURIsOpBase> op_;
+        Playlist::Crawler::Direction direction_;
+        bool force_play_uri_when_available_;
+
+        explicit LookaheadURIsOp(std::shared_ptr<Playlist::Crawler::GetURIsOpBase> op,
+                                 Playlist::Crawler::Direction direction,
+                                 bool force_play_uri_when_available):
+            op_(std::move(op)),
+            direction_(direction),
+            force_play_uri_when_available_(force_play_uri_when_available)
+        {}
+    };
+
+    /*!
+     * Stream pushed to the stream player's URL FIFO, waiting for the answer.
+     */
+    class PendingPush;
+
   private:
     LoggedLock::RecMutex lock_;
 
@@ -130,6 +155,44 @@ class Control
      */
     std::shared_ptr<Playlist::Crawler::GetURIsOpBase> prefetch_uris_op_;
 
+    /*!
+     * Maximum number of items whose details are retrieved concurrently.
+     */
+    static constexpr size_t MAX_CONCURRENT_LOOKAHEAD_OPS = 3;
+
+    /*!
+     * Operations for getting details of prefetched items, in list order.
+     *
+     * The next item is searched for while the details of previously found
+     * items are still being retrieved, so that several items are resolved
+     * concurrently. Results are processed strictly in the order of this queue
+     * so that streams are queued in list order.
+     */
+    std::deque<LookaheadURIsOp> lookahead_uris_ops_;
+
+    /*!
+     * Pushes to the stream player's URL FIFO still in flight, in push order.
+     *
+     * Streams are pushed asynchronously so that the main loop is not blocked
+     * while the stream player is processing the request, and so that further
+     * streams can be pushed before the previous push has been answered. The
+     * answers are processed in the order the pushes were made, and the play
+     * or pause command is sent, if requested, when the answer to the push has
+     * been received.
+     */
+    std::deque<std::shared_ptr<PendingPush>> pending_pushes_;
+
+    /*!
+     * Batch new pushes are added to, if any.
+     *
+     * Streams pushed between #Player::Control::begin_push_batch() and
+     * #Player::Control::end_push_batch() are collected in a batch. The
+     * answers to the pushes of a batch are evaluated in one go (see
+     * #Player::PushBatch).
+     */
+    std::shared_ptr<PendingPush> open_push_batch_;
+    unsigned int push_batch_nesting_;
+
     /* simple function which tells us whether or not we can play a stream at
      * given bit rate */
     const std::function<bool(uint32_t)> bitrate_limiter_;
@@ -207,6 +270,7 @@ class Control
         player_data_(nullptr),
         permissions_(nullptr),
         prefetch_direction_after_failure_(Playlist::Crawler::Direction::FORWARD),
+        push_batch_nesting_(0),
         bitrate_limiter_(std::move(bitrate_limiter))
     {
         LoggedLock::configure(lock_, "Player::Control", MESSAGE_LEVEL_DEBUG);
@@ -272,7 +336,15 @@ class Control
     bool source_deselected_notification(const std::string *audio_source_id);
 
     void repeat_mode_toggle_request() const;
-    void shuffle_mode_toggle_request() const;
+
+    /*!
+     * Toggle shuffle mode in player, or in crawler if there is any.
+     *
+     * \returns
+     *     True if the shuffle mode reported to the user has changed and the
+     *     display should be updated, false otherwise.
+     */
+    bool shuffle_mode_toggle_request();
 
     /* functions below are called as a result of user actions that are supposed
      * to take direct, immediate influence on playback, so they impose requests
@@ -313,6 +385,8 @@ class Control
     void bring_forward_delayed_prefetch();
 
   private:
+    bool toggle_crawler_shuffle_mode();
+
     /* skip request handling */
     bool skip_request_prepare(UserIntention previous_intention,
                               Skipper::RunNewFindNextOp &run_new_find_next_fn,
@@ -326,13 +400,16 @@ class Control
     /* prefetch handling (play when possible) */
     bool found_prefetched_item(Playlist::Crawler::FindNextOpBase &op,
                                bool force_play_uri_when_available);
-    bool found_prefetched_item_uris(Playlist::Crawler::GetURIsOpBase &op,
-                                    Playlist::Crawler::Direction from_direction,
-                                    bool force_play_uri_when_available);
+    bool found_prefetched_item_uris(Playlist::Crawler::GetURIsOpBase &op);
+    bool process_prefetched_item_uris(Playlist::Crawler::GetURIsOpBase &op,
+                                      Playlist::Crawler::Direction from_direction,
+                                      bool force_play_uri_when_available);
 
     bool queue_item_from_op(Playlist::Crawler::GetURIsOpBase &op,
                             Playlist::Crawler::Direction direction,
-                            InsertMode insert_mode, PlayNewMode play_new_mode);
+                            InsertMode insert_mode, PlayNewMode play_new_mode,
+                            std::function<void()> &&rejected_fn = nullptr);
+    bool skip_unplayable_stream(Playlist::Crawler::Direction from_direction);
 
     enum class ReplayResult
     {
@@ -346,6 +423,9 @@ class Control
                         PlayNewMode play_new_mode);
 
     void forget_queued_and_playing();
+    void begin_push_batch();
+    void end_push_batch();
+    void cancel_pending_pushes();
 };
 
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016, 2017, 2019--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2016, 2017, 2019--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -30,6 +30,7 @@
 #include "error_thrower.hh"
 
 #include <algorithm>
+#include <sstream>
 
 namespace std
 {
@@ -498,31 +499,6 @@ const MetaData::Set &Player::NowPlayingInfo::get_meta_data(ID::Stream stream_id)
     return meta_data_or_empty_ref(meta_data_.get());
 }
 
-static void ref_list_id(std::map<ID::List, size_t> &list_refcounts,
-                        ID::List list_id)
-{
-    auto item = list_refcounts.find(list_id);
-
-    if(item != list_refcounts.end())
-        ++item->second;
-    else
-        list_refcounts[list_id] = 1;
-}
-
-static void unref_list_id(std::map<ID::List, size_t> &list_refcounts,
-                          ID::List list_id)
-{
-    auto item = list_refcounts.find(list_id);
-
-    if(item == list_refcounts.end())
-        return;
-
-    msg_log_assert(item->second > 0);
-
-    if(--item->second == 0)
-        list_refcounts.erase(list_id);
-}
-
 ID::OurStream Player::Data::queued_stream_append(
         const GVariantWrapper &stream_key, std::unique_ptr<MetaData::Set> meta_data,
         std::vector<std::string> &&uris, Airable::SortedLinks &&airable_links,
@@ -538,7 +514,7 @@ ID::OurStream Player::Data::queued_stream_append(
                                list_id, std::move(originating_cursor));
 
     if(id.get().is_valid())
-        ref_list_id(referenced_lists_, list_id);
+        referenced_lists_.ref(list_id);
 
     return id;
 }
@@ -575,9 +551,9 @@ std::vector<ID::OurStream> Player::Data::copy_all_queued_streams_for_recovery()
 }
 
 void Player::Data::remove_data_for_stream(const QueuedStream &qs,
-                                          std::map<ID::List, size_t> &referenced_lists)
+                                          List::ReferencedLists &referenced_lists)
 {
-    unref_list_id(referenced_lists, qs.list_id_);
+    referenced_lists.unref(qs.list_id_);
 }
 
 void Player::Data::queued_stream_remove(ID::OurStream stream_id)
@@ -926,15 +902,6 @@ bool Player::Data::update_playback_speed(const ID::Stream &stream_id,
     return retval;
 }
 
-void Player::Data::append_referenced_lists(std::vector<ID::List> &list_ids) const
-{
-    for(const auto &it : referenced_lists_)
-    {
-        if(it.second > 0)
-            list_ids.push_back(it.first);
-    }
-}
-
 void Player::Data::list_replaced_notification(ID::List old_id, ID::List new_id) const
 {
     MSG_NOT_IMPLEMENTED();
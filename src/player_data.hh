@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016, 2017, 2019--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2016, 2017, 2019--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -31,6 +31,7 @@
 #include "logged_lock.hh"
 #include "dbus_iface_proxies.hh"
 #include "gvariantwrapper.hh"
+#include "referenced_lists.hh"
 
 #include <map>
 #include <deque>
@@ -592,7 +593,10 @@ class Data
      */
     QueuedStreams queued_streams_;
 
-    std::map<ID::List, size_t> referenced_lists_;
+    /*!
+     * Lists referenced by queued streams.
+     */
+    List::ReferencedLists referenced_lists_;
 
     UserIntention intention_;
     PlayerState player_state_;
@@ -812,14 +816,14 @@ class Data
                             const std::chrono::milliseconds &duration);
     bool update_playback_speed(const ID::Stream &stream_id, double speed);
 
-    void append_referenced_lists(std::vector<ID::List> &list_ids) const;
+    const List::ReferencedLists &get_referenced_lists() const { return referenced_lists_; }
 
     // cppcheck-suppress functionStatic
     void list_replaced_notification(ID::List old_id, ID::List new_id) const;
 
   private:
     static void remove_data_for_stream(const QueuedStream &qs,
-                                       std::map<ID::List, size_t> &referenced_lists);
+                                       List::ReferencedLists &referenced_lists);
 };
 
 }
@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#ifndef PLAYER_PUSH_BATCH_HH
+#define PLAYER_PUSH_BATCH_HH
+
+#include "idtypes.hh"
+#include "messages.h"
+
+#include <vector>
+#include <functional>
+
+namespace Player
+{
+
+/*!
+ * Bookkeeping for several streams pushed to the stream player in one go.
+ *
+ * The streams of a batch are pushed to the stream player back to back,
+ * without waiting for the answers in between. The answers are collected in
+ * objects of this class, and evaluated all at once as soon as the last answer
+ * has been received. This way, the streams dropped by the stream player are
+ * processed in a single step, and at most one play or pause command is sent
+ * for the whole batch.
+ *
+ * Streams may be added along with a function to be called if the stream
+ * player rejects them, so that the caller can react to failed pushes although
+ * it does not wait for the answers.
+ *
+ * This class only manages the answers. It does not know anything about
+ * D-Bus.
+ */
+class PushBatch
+{
+  public:
+    /*!
+     * Stream player's answer to a single push.
+     */
+    struct Answer
+    {
+        bool is_failed_;
+        bool is_overflow_;
+        bool is_playing_;
+        std::vector<ID::Stream> dropped_;
+
+        explicit Answer(): is_failed_(true), is_overflow_(false), is_playing_(false) {}
+
+        explicit Answer(bool is_overflow, bool is_playing,
+                        std::vector<ID::Stream> &&dropped):
+            is_failed_(false),
+            is_overflow_(is_overflow),
+            is_playing_(is_playing),
+            dropped_(std::move(dropped))
+        {}
+    };
+
+    /*!
+     * Merged answers of all pushes.
+     */
+    struct Result
+    {
+        /*! Streams dropped by the stream player, in push order. */
+        std::vector<ID::Stream> dropped_;
+
+        /*! Streams accepted by the stream player, in push order. */
+        std::vector<ID::OurStream> accepted_;
+
+        /*! Streams not accepted by the stream player, in push order. */
+        std::vector<ID::OurStream> rejected_;
+
+        /*! Functions registered for rejected streams, in push order. */
+        std::vector<std::function<void()>> rejected_fns_;
+
+        /*! True if any answer reported that the player is playing. */
+        bool is_playing_;
+
+        explicit Result(): is_playing_(false) {}
+    };
+
+  private:
+    struct Entry
+    {
+        ID::OurStream stream_id_;
+        std::function<void()> rejected_fn_;
+        bool is_answered_;
+        Answer answer_;
+
+        explicit Entry(ID::OurStream stream_id,
+                       std::function<void()> &&rejected_fn):
+            stream_id_(stream_id),
+            rejected_fn_(std::move(rejected_fn)),
+            is_answered_(false)
+        {}
+    };
+
+    std::vector<Entry> entries_;
+    size_t number_of_answers_;
+    bool is_sealed_;
+
+  public:
+    PushBatch(const PushBatch &) = delete;
+    PushBatch &operator=(const PushBatch &) = delete;
+
+    explicit PushBatch():
+        number_of_answers_(0),
+        is_sealed_(false)
+    {}
+
+    bool empty() const { return entries_.empty(); }
+    size_t size() const { return entries_.size(); }
+
+    /*!
+     * Take note of a stream about to be pushed.
+     *
+     * \param stream_id
+     *     The stream to be pushed.
+     *
+     * \param rejected_fn
+     *     Function to be returned in #Player::PushBatch::Result::rejected_fns_
+     *     in case the stream is rejected. May be \c nullptr.
+     *
+     * \returns
+     *     Index to be passed to #Player::PushBatch::answer().
+     */
+    size_t add(ID::OurStream stream_id,
+               std::function<void()> &&rejected_fn = nullptr)
+    {
+        msg_log_assert(!is_sealed_);
+        entries_.emplace_back(stream_id, std::move(rejected_fn));
+        return entries_.size() - 1;
+    }
+
+    /*!
+     * No more streams are going to be added.
+     *
+     * \returns
+     *     True if the batch is complete, i.e., all answers have been
+     *     received already.
+     */
+    bool seal()
+    {
+        is_sealed_ = true;
+        return is_complete();
+    }
+
+    /*!
+     * Store answer to the push with given index.
+     *
+     * \returns
+     *     True if the batch is complete.
+     */
+    bool answer(size_t idx, Answer &&a)
+    {
+        msg_log_assert(idx < entries_.size());
+
+        auto &e(entries_[idx]);
+
+        if(e.is_answered_)
+            MSG_BUG("Stream %u answered twice", e.stream_id_.get().get_raw_id());
+        else
+        {
+            e.is_answered_ = true;
+            e.answer_ = std::move(a);
+            ++number_of_answers_;
+        }
+
+        return is_complete();
+    }
+
+    bool is_complete() const
+    {
+        return is_sealed_ && number_of_answers_ == entries_.size();
+    }
+
+    /*!
+     * Merge all answers.
+     *
+     * Must be called for complete batches only.
+     */
+    Result take_result()
+    {
+        msg_log_assert(is_complete());
+
+        Result result;
+
+        for(auto &e : entries_)
+        {
+            auto &a(e.answer_);
+
+            result.dropped_.insert(result.dropped_.end(),
+                                   a.dropped_.begin(), a.dropped_.end());
+            a.dropped_.clear();
+
+            if(a.is_failed_ || a.is_overflow_)
+            {
+                result.rejected_.push_back(e.stream_id_);
+
+                if(e.rejected_fn_ != nullptr)
+                    result.rejected_fns_.emplace_back(std::move(e.rejected_fn_));
+            }
+            else
+            {
+                result.accepted_.push_back(e.stream_id_);
+
+                if(a.is_playing_)
+                    result.is_playing_ = true;
+            }
+        }
+
+        return result;
+    }
+
+    /*!
+     * Call function for all streams accepted by the stream player so far.
+     */
+    void for_each_accepted(const std::function<void(ID::OurStream)> &fn) const
+    {
+        for(const auto &e : entries_)
+            if(e.is_answered_ &&
+               !e.answer_.is_failed_ && !e.answer_.is_overflow_)
+                fn(e.stream_id_);
+    }
+
+    /*!
+     * Call function for all streams rejected or not answered so far.
+     */
+    void for_each_not_accepted(const std::function<void(ID::OurStream)> &fn) const
+    {
+        for(const auto &e : entries_)
+            if(!e.is_answered_ ||
+               e.answer_.is_failed_ || e.answer_.is_overflow_)
+                fn(e.stream_id_);
+    }
+};
+
+}
+
+#endif /* !PLAYER_PUSH_BATCH_HH */
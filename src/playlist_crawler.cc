@@ -27,6 +27,8 @@
 #include "ui_parameters_predefined.hh"
 #include "dump_enum_value.hh"
 
+#include <sstream>
+
 class InvalidIface: public Playlist::Crawler::PublicIface
 {
   public:
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#ifndef REFERENCED_LISTS_HH
+#define REFERENCED_LISTS_HH
+
+#include "idtypes.hh"
+#include "messages.h"
+
+#include <map>
+
+/*!
+ * \addtogroup list_navigation
+ */
+/*!@{*/
+
+namespace List
+{
+
+/*!
+ * Reference counted set of IDs of lists which must be kept alive.
+ *
+ * Client code references lists as soon as they are used and unreferences them
+ * when they are not needed anymore, so that the set of lists to be kept alive
+ * is known at any time. There is no need to collect the list IDs from all
+ * places they are stored at each time a keep-alive message is going to be
+ * sent.
+ *
+ * The generation number is changed whenever a list ID is added to or removed
+ * from the set, so that client code can cache data derived from the set.
+ */
+class ReferencedLists
+{
+  private:
+    std::map<ID::List, size_t> refcounts_;
+    unsigned int generation_;
+
+  public:
+    ReferencedLists(const ReferencedLists &) = delete;
+    ReferencedLists &operator=(const ReferencedLists &) = delete;
+
+    explicit ReferencedLists():
+        generation_(0)
+    {}
+
+    void ref(ID::List list_id)
+    {
+        if(!list_id.is_valid())
+            return;
+
+        auto item = refcounts_.find(list_id);
+
+        if(item != refcounts_.end())
+            ++item->second;
+        else
+        {
+            refcounts_[list_id] = 1;
+            ++generation_;
+        }
+    }
+
+    void unref(ID::List list_id)
+    {
+        auto item = refcounts_.find(list_id);
+
+        if(item == refcounts_.end())
+            return;
+
+        msg_log_assert(item->second > 0);
+
+        if(--item->second == 0)
+        {
+            refcounts_.erase(item);
+            ++generation_;
+        }
+    }
+
+    /*!
+     * Drop reference to \p old_id, take reference to \p new_id.
+     */
+    void exchange(ID::List old_id, ID::List new_id)
+    {
+        if(old_id == new_id)
+            return;
+
+        ref(new_id);
+        unref(old_id);
+    }
+
+    void clear()
+    {
+        if(refcounts_.empty())
+            return;
+
+        refcounts_.clear();
+        ++generation_;
+    }
+
+    bool empty() const { return refcounts_.empty(); }
+    size_t size() const { return refcounts_.size(); }
+
+    bool contains(ID::List list_id) const
+    {
+        return refcounts_.find(list_id) != refcounts_.end();
+    }
+
+    unsigned int get_generation() const { return generation_; }
+
+    template <typename F>
+    void for_each(const F &fn) const
+    {
+        for(const auto &it : refcounts_)
+            fn(it.first);
+    }
+};
+
+}
+
+/*!@}*/
+
+#endif /* !REFERENCED_LISTS_HH */
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "render_trace.hh"
+#include "logged_lock.hh"
+#include "messages.h"
+
+#include <cstdio>
+#include <string>
+
+static constexpr size_t TRACE_RING_SIZE = 512;
+
+static const char *what_to_string(RenderTrace::What what)
+{
+    switch(what)
+    {
+      case RenderTrace::What::SCREEN_BEGIN:
+        return "begin";
+
+      case RenderTrace::What::LINE:
+        return "line";
+
+      case RenderTrace::What::LINE_MISSING:
+        return "missing";
+
+      case RenderTrace::What::SCREEN_CACHE_HIT:
+        return "unchanged";
+
+      case RenderTrace::What::SCREEN_CACHE_MISS:
+        return "changed";
+
+      case RenderTrace::What::BYTES_EMITTED:
+        return "emitted";
+
+      case RenderTrace::What::MESSAGE:
+        return "message";
+    }
+
+    return "???";
+}
+
+class GlobalTrace
+{
+  private:
+    LoggedLock::Mutex lock_;
+    RenderTrace::Ring<TRACE_RING_SIZE> ring_;
+
+  public:
+    GlobalTrace(const GlobalTrace &) = delete;
+    GlobalTrace &operator=(const GlobalTrace &) = delete;
+
+    explicit GlobalTrace()
+    {
+        LoggedLock::configure(lock_, "RenderTrace", MESSAGE_LEVEL_DEBUG);
+    }
+
+    void add(const char *view_name, RenderTrace::What what,
+             uint32_t a, uint32_t b, const char *flags)
+    {
+        LOGGED_LOCK_CONTEXT_HINT;
+        std::lock_guard<LoggedLock::Mutex> lock(lock_);
+        ring_.add(view_name, what, a, b, flags);
+    }
+
+    /*!
+     * Return all stored events as human-readable text, remove them.
+     */
+    std::string dump()
+    {
+        LOGGED_LOCK_CONTEXT_HINT;
+        std::lock_guard<LoggedLock::Mutex> lock(lock_);
+
+        char buffer[256];
+
+        snprintf(buffer, sizeof(buffer), "Render trace: %zu events\n",
+                 ring_.size());
+
+        std::string report(buffer);
+        const auto now = std::chrono::steady_clock::now();
+
+        ring_.for_each(
+            [&now, &buffer, &report] (const RenderTrace::Event &ev)
+            {
+                const auto age =
+                    std::chrono::duration_cast<std::chrono::microseconds>(now - ev.when_);
+
+                snprintf(buffer, sizeof(buffer), "  -%lld us %s %s a=%u b=%u %s\n",
+                         static_cast<long long>(age.count()),
+                         ev.view_name_ != nullptr ? ev.view_name_ : "(none)",
+                         what_to_string(ev.what_), ev.a_, ev.b_, ev.flags_);
+                report += buffer;
+            });
+
+        ring_.clear();
+
+        return report;
+    }
+};
+
+static GlobalTrace global_trace;
+
+bool RenderTrace::is_enabled()
+{
+    return msg_is_verbose(MESSAGE_LEVEL_DEBUG);
+}
+
+void RenderTrace::record(const char *view_name, What what,
+                         uint32_t a, uint32_t b, const char *flags)
+{
+    global_trace.add(view_name, what, a, b, flags);
+}
+
+std::string RenderTrace::dump()
+{
+    return global_trace.dump();
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#ifndef RENDER_TRACE_HH
+#define RENDER_TRACE_HH
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/*!
+ * \addtogroup render_trace Trace of view serialization
+ *
+ * Structured, in-memory record of what the views have sent to DCPD.
+ *
+ * Recording is enabled only at verbosity level #MESSAGE_LEVEL_DEBUG or
+ * higher, and is reduced to a single comparison otherwise. Recorded events
+ * are kept in a fixed-size ring, so that only the most recent events are
+ * retained. The ring can be dumped to the log on demand by passing
+ * #RenderTrace::DUMP_REQUEST as level name to the \c DebugLevel method of
+ * the \c de.tahifi.Debug.Logging D-Bus interface.
+ */
+/*!@{*/
+
+namespace RenderTrace
+{
+
+/*!
+ * Pseudo level name for requesting a dump of the render trace.
+ */
+static constexpr const char *DUMP_REQUEST = "dump-render-trace";
+
+enum class What : uint8_t
+{
+    /*! Start of list rendering (a: number of items, b: cursor position) */
+    SCREEN_BEGIN,
+
+    /*! Rendered list line (a: line on screen, b: item in list) */
+    LINE,
+
+    /*! No item available for line (a: line on screen, b: item in list) */
+    LINE_MISSING,
+
+    /*! Screen identical to last one sent, transaction skipped */
+    SCREEN_CACHE_HIT,
+
+    /*! Screen differs from last one sent (a: changed lines, b: all lines) */
+    SCREEN_CACHE_MISS,
+
+    /*! XML written (a: number of bytes, b: 1 for full view, 0 for update) */
+    BYTES_EMITTED,
+
+    /*! View rendered as message (a: view-specific write flags) */
+    MESSAGE,
+};
+
+struct Event
+{
+    std::chrono::steady_clock::time_point when_;
+    const char *view_name_;
+    What what_;
+    char flags_[7];
+    uint32_t a_;
+    uint32_t b_;
+
+    void set(const char *view_name, What what, uint32_t a, uint32_t b,
+             const char *flags)
+    {
+        when_ = std::chrono::steady_clock::now();
+        view_name_ = view_name;
+        what_ = what;
+        a_ = a;
+        b_ = b;
+
+        if(flags != nullptr)
+        {
+            std::strncpy(flags_, flags, sizeof(flags_) - 1);
+            flags_[sizeof(flags_) - 1] = '\0';
+        }
+        else
+            flags_[0] = '\0';
+    }
+};
+
+/*!
+ * Fixed-size ring of trace events, oldest events are overwritten.
+ *
+ * This class is not thread-safe.
+ */
+template <size_t N>
+class Ring
+{
+  private:
+    std::array<Event, N> events_;
+    size_t next_;
+    size_t count_;
+
+  public:
+    Ring(const Ring &) = delete;
+    Ring &operator=(const Ring &) = delete;
+
+    explicit Ring(): next_(0), count_(0) {}
+
+    static constexpr size_t capacity() { return N; }
+
+    size_t size() const { return count_; }
+
+    void clear() { next_ = count_ = 0; }
+
+    void add(const char *view_name, What what, uint32_t a, uint32_t b,
+             const char *flags)
+    {
+        events_[next_].set(view_name, what, a, b, flags);
+        next_ = (next_ + 1) % N;
+
+        if(count_ < N)
+            ++count_;
+    }
+
+    /*!
+     * Call \p fn for each stored event, oldest event first.
+     */
+    template <typename F>
+    void for_each(const F &fn) const
+    {
+        size_t idx = (next_ + N - count_) % N;
+
+        for(size_t i = 0; i < count_; ++i)
+        {
+            fn(events_[idx]);
+            idx = (idx + 1) % N;
+        }
+    }
+};
+
+/*!
+ * Whether or not render events should be recorded.
+ *
+ * Client code should check this before computing any trace data.
+ */
+bool is_enabled();
+
+/*!
+ * Store event in global trace ring.
+ *
+ * \param view_name
+ *     Name of the view, must remain valid for the lifetime of the program.
+ * \param what
+ *     What has happened.
+ * \param a, b
+ *     Event-specific data, see #RenderTrace::What.
+ * \param flags
+ *     Optional flags string, truncated to six characters.
+ */
+void record(const char *view_name, What what,
+            uint32_t a = 0, uint32_t b = 0, const char *flags = nullptr);
+
+/*!
+ * Return all events in global trace ring as human-readable text, one event
+ * per line, then clear the ring.
+ */
+std::string dump();
+
+}
+
+/*!@}*/
+
+#endif /* !RENDER_TRACE_HH */
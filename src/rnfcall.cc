@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2019, 2020, 2021, 2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2019, 2020, 2021, 2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -47,9 +47,19 @@ bool DBusRNF::CallBase::abort_request_internal(bool suppress_errors)
     {
       case CallState::INITIALIZED:
       case CallState::WAIT_FOR_NOTIFICATION:
-      case CallState::READY_TO_FETCH:
         break;
 
+      case CallState::READY_TO_FETCH:
+        if(!is_fetching_async_)
+            break;
+
+        /* the cookie is being redeemed already, nothing to abort on list
+         * broker side */
+        cancel_async_fetch_unlocked();
+        clear_cookie();
+        set_state(CallState::ABORTED_BY_LIST_BROKER);
+        return true;
+
       case CallState::RESULT_FETCHED:
       case CallState::FAILED:
         if(was_aborted_after_done_)
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2019--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2019--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -190,6 +190,14 @@ class CallBase
     mutable LoggedLock::Mutex lock_;
     LoggedLock::ConditionVariable notified_;
 
+    /*!
+     * Set while the result is being fetched asynchronously.
+     *
+     * The object remains in state #DBusRNF::CallState::READY_TO_FETCH while
+     * this flag is set.
+     */
+    bool is_fetching_async_;
+
   private:
     uint32_t cookie_;
     uint32_t cleared_cookie_;
@@ -205,6 +213,7 @@ class CallBase
         state_(CallState::INITIALIZED),
         was_aborted_after_done_(false),
         detached_(false),
+        is_fetching_async_(false),
         cookie_(0),
         cleared_cookie_(0),
         abort_cookie_fn_(std::move(abort_cookie_fn)),
@@ -306,6 +315,14 @@ class CallBase
 
     bool abort_request_internal(bool suppress_errors);
 
+    /*!
+     * Cancel asynchronous fetch operation in progress.
+     *
+     * Called with the object lock held, and only if
+     * #DBusRNF::CallBase::is_fetching_async_ is set.
+     */
+    virtual void cancel_async_fetch_unlocked() {}
+
     /*!
      * Get name for debugging.
      *
@@ -476,14 +493,7 @@ class Call: public CallBase, public std::enable_shared_from_this<Call<RT, BS>>
         LOGGED_LOCK_CONTEXT_HINT;
         std::lock_guard<LoggedLock::Mutex> lock(lock_);
 
-        if(get_state() != CallState::INITIALIZED)
-        {
-            MSG_BUG("RNF request in state %u", int(get_state()));
-            throw BadStateError();
-        }
-
-        Busy::set(BS);
-        busy_source_set_ = true;
+        begin_request_unlocked();
 
         const auto t(this->shared_from_this());
 
@@ -522,23 +532,57 @@ class Call: public CallBase, public std::enable_shared_from_this<Call<RT, BS>>
         }
         catch(...)
         {
-            msg_error(0, LOG_NOTICE, "RNF request %s failed", name());
+            request_failed_unlocked();
+        }
 
-            try
-            {
-                promise_.set_exception(std::current_exception());
-            }
-            catch(...)
-            {
-                MSG_BUG("Double exception on RNF request failure");
-            }
+        return get_state();
+    }
 
-            set_state(CallState::FAILED);
+  protected:
+    /*!
+     * Check state and mark the object busy before sending a request.
+     *
+     * The caller of this function must hold the lock.
+     *
+     * \throws
+     *     #DBusRNF::BadStateError The object is in wrong state.
+     */
+    void begin_request_unlocked()
+    {
+        if(get_state() != CallState::INITIALIZED)
+        {
+            MSG_BUG("RNF request in state %u", int(get_state()));
+            throw BadStateError();
         }
 
-        return get_state();
+        Busy::set(BS);
+        busy_source_set_ = true;
     }
 
+    /*!
+     * Store exception currently being handled, enter failure state.
+     *
+     * Must be called from a \c catch block. The caller of this function must
+     * hold the lock.
+     */
+    void request_failed_unlocked()
+    {
+        msg_error(0, LOG_NOTICE, "RNF request %s failed", name());
+
+        try
+        {
+            promise_.set_exception(std::current_exception());
+        }
+        catch(...)
+        {
+            MSG_BUG("Double exception on RNF request failure");
+        }
+
+        set_state(CallState::FAILED);
+    }
+
+  public:
+
     /*!
      * Fetch results by cookie after ready notification was sent.
      *
@@ -592,7 +636,11 @@ class Call: public CallBase, public std::enable_shared_from_this<Call<RT, BS>>
         using namespace std::chrono_literals;
         while(!notified_.wait_for(
                 lock, 20s,
-                [this] { return get_state() != CallState::WAIT_FOR_NOTIFICATION; }))
+                [this]
+                {
+                    return get_state() != CallState::WAIT_FOR_NOTIFICATION &&
+                           !is_fetching_async_;
+                }))
         {
             msg_error(ETIME, LOG_NOTICE,
                       "RNF call %p (%s) still waiting for notification in state %d",
@@ -613,7 +661,11 @@ class Call: public CallBase, public std::enable_shared_from_this<Call<RT, BS>>
         switch(get_state())
         {
           case CallState::READY_TO_FETCH:
-            break;
+            if(!is_fetching_async_)
+                break;
+
+            MSG_BUG("RNF fetch while fetching asynchronously");
+            throw BadStateError();
 
           case CallState::RESULT_FETCHED:
             return true;
@@ -630,9 +682,25 @@ class Call: public CallBase, public std::enable_shared_from_this<Call<RT, BS>>
             throw BadStateError();
         }
 
+        return put_fetched_result_unlocked(
+            [this, &do_fetch] (std::promise<ResultType> &result)
+            { do_fetch(get_cookie(), result); });
+    }
+
+    /*!
+     * Store fetched result or exception, enter corresponding state.
+     *
+     * The caller of this function must hold the lock.
+     *
+     * \param put_result
+     *     Function which places the result into the promise passed to it, or
+     *     throws an exception.
+     */
+    bool put_fetched_result_unlocked(const std::function<void(std::promise<ResultType> &)> &put_result)
+    {
         try
         {
-            do_fetch(get_cookie(), promise_);
+            put_result(promise_);
         }
         catch(...)
         {
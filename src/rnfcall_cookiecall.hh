@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2019, 2020, 2021  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2019, 2020, 2021, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -24,6 +24,9 @@
 
 #include "rnfcall.hh"
 #include "cookie_manager.hh"
+#include "rnfcall_fetch_batch.hh"
+
+#include <gio/gio.h>
 
 namespace DBusRNF
 {
@@ -46,6 +49,11 @@ namespace DBusRNF
  *
  * The complexities of having to manage cookies or even having to deal with a
  * cookie manager are therefore hidden as much as possible by this class.
+ *
+ * Requests may be sent synchronously by #DBusRNF::CookieCall::request() or
+ * asynchronously by #DBusRNF::CookieCall::request_async(). In the latter case,
+ * neither the request nor fetching its result by cookie block the calling
+ * thread.
  */
 template <typename RT, Busy::Source BS>
 class CookieCall: public Call<RT, BS>
@@ -54,20 +62,42 @@ class CookieCall: public Call<RT, BS>
     CookieManagerIface &cm_;
     ListError list_error_;
 
+  private:
+    bool is_async_;
+    bool is_request_in_flight_;
+    GCancellable *cancellable_;
+    FetchBatch *batch_;
+
+  protected:
     explicit CookieCall(CookieManagerIface &cm,
                         std::unique_ptr<ContextData> context_data,
                         StatusWatcher &&status_watcher):
         Call<RT, BS>(
             [this] (uint32_t c) { return cm_.abort_cookie(this->get_proxy_ptr(), c); },
             std::move(context_data), std::move(status_watcher)),
-        cm_(cm)
+        cm_(cm),
+        is_async_(false),
+        is_request_in_flight_(false),
+        cancellable_(nullptr),
+        batch_(nullptr)
     {}
 
   public:
     CookieCall(CookieCall &&) = default;
     CookieCall &operator=(CookieCall &&) = default;
 
+    virtual ~CookieCall()
+    {
+        if(cancellable_ != nullptr)
+            g_object_unref(G_OBJECT(cancellable_));
+    }
+
   private:
+    std::shared_ptr<CookieCall> self()
+    {
+        return std::static_pointer_cast<CookieCall>(this->shared_from_this());
+    }
+
     void fetch_and_notify_unlocked()
     {
         Call<RT, BS>::fetch_unlocked([this] (uint32_t c, auto &r) { do_fetch(c, r); });
@@ -76,6 +106,31 @@ class CookieCall: public Call<RT, BS>
             this->context_data_->notify(*this, this->get_state());
     }
 
+    void manage_cookie(uint32_t cookie)
+    {
+        cm_.set_pending_cookie(
+            get_proxy_ptr(), cookie,
+            // DBusRNF::CookieManagerIface::NotifyByCookieFn
+            [call = self()] (uint32_t c, const ListError &e) mutable
+            {
+                call->list_error_ = e;
+
+                if(e.failed())
+                    call->aborted_notification(c);
+                else
+                    call->result_available_notification(c);
+            },
+            // DBusRNF::CookieManagerIface::FetchByCookieFn
+            [call = self()] (uint32_t c, const ListError &e) mutable
+            {
+                if(call->is_async_ || FetchBatch::get_active() != nullptr)
+                    call->fetch_async_and_notify();
+                else
+                    call->fetch_and_notify_unlocked();
+            }
+        );
+    }
+
   public:
     CallState request()
     {
@@ -87,35 +142,67 @@ class CookieCall: public Call<RT, BS>
             [this] (auto &r) { return do_request(r); },
 
             // manage_cookie
-            [this] (uint32_t c)
-            {
-                cm_.set_pending_cookie(
-                    get_proxy_ptr(), c,
-                    // DBusRNF::CookieManagerIface::NotifyByCookieFn
-                    [call = std::move(std::static_pointer_cast<CookieCall>(this->shared_from_this()))]
-                    (uint32_t c2, const ListError &e) mutable
-                    {
-                        call->list_error_ = e;
-
-                        if(e.failed())
-                            call->aborted_notification(c2);
-                        else
-                            call->result_available_notification(c2);
-                    },
-                    // DBusRNF::CookieManagerIface::FetchByCookieFn
-                    [call = std::move(std::static_pointer_cast<CookieCall>(this->shared_from_this()))]
-                    (uint32_t c2, const ListError &e) mutable
-                    {
-                        call->fetch_and_notify_unlocked();
-                    }
-                );
-            },
+            [this] (uint32_t c) { manage_cookie(c); },
 
             // fast_path
             [this] { this->fetch_and_notify_unlocked(); }
         );
     }
 
+    /*!
+     * Send request without blocking the calling thread.
+     *
+     * Like #DBusRNF::CookieCall::request(), but the D-Bus method is called
+     * asynchronously. The answer is processed in the GLib main context of the
+     * calling thread. In case the list broker answers with a cookie, then the
+     * result will be fetched asynchronously as well.
+     *
+     * The object remains in state #DBusRNF::CallState::WAIT_FOR_NOTIFICATION
+     * while the answer is pending. Failed requests cannot be reported by the
+     * return value, so the context data are notified about them (in addition
+     * to the notifications also sent for synchronous requests).
+     *
+     * \note
+     *     Function #DBusRNF::CookieCall::fetch_blocking() must not be used
+     *     from the thread which runs the main context the request was sent
+     *     from because the answer could never be processed.
+     *
+     * \throws
+     *     #DBusRNF::BadStateError The object is in wrong state.
+     */
+    CallState request_async()
+    {
+        LOGGED_LOCK_CONTEXT_HINT;
+        std::lock_guard<LoggedLock::Mutex> lock(this->lock_);
+
+        this->begin_request_unlocked();
+        is_async_ = true;
+        is_request_in_flight_ = true;
+        this->set_state(CallState::WAIT_FOR_NOTIFICATION);
+
+        /* no cancelable here: if the request is aborted while in flight, we
+         * still need its answer to abort the cookie on list broker side */
+        cm_.async_request_started(get_proxy_ptr());
+        do_request_async(nullptr, request_ready,
+                         new std::shared_ptr<CookieCall>(self()));
+
+        return this->get_state();
+    }
+
+    /*!
+     * Whether or not the answer to #DBusRNF::CookieCall::request_async() is
+     * still outstanding.
+     *
+     * The answer may be a cookie, so the result need not be available once
+     * this function returns \c false.
+     */
+    bool is_request_in_flight() const
+    {
+        LOGGED_LOCK_CONTEXT_HINT;
+        std::lock_guard<LoggedLock::Mutex> lock(this->lock_);
+        return is_request_in_flight_;
+    }
+
     /*!
      * Fetch the results by cookie if necessary.
      *
@@ -145,10 +232,199 @@ class CookieCall: public Call<RT, BS>
 
     ListError get_list_error() const { return list_error_; }
 
+  private:
+    static void request_ready(GObject *source_object, GAsyncResult *res,
+                              gpointer user_data)
+    {
+        std::unique_ptr<std::shared_ptr<CookieCall>>
+            call(static_cast<std::shared_ptr<CookieCall> *>(user_data));
+        (*call)->request_done(res);
+    }
+
+    static void fetch_ready(GObject *source_object, GAsyncResult *res,
+                            gpointer user_data)
+    {
+        std::unique_ptr<std::shared_ptr<CookieCall>>
+            call(static_cast<std::shared_ptr<CookieCall> *>(user_data));
+        (*call)->fetch_done(res);
+    }
+
+    void request_done(GAsyncResult *res)
+    {
+        LOGGED_LOCK_CONTEXT_HINT;
+        LoggedLock::UniqueLock<LoggedLock::Mutex> lock(this->lock_);
+
+        uint32_t cookie = 0;
+
+        is_request_in_flight_ = false;
+
+        if(this->get_state() != CallState::WAIT_FOR_NOTIFICATION)
+        {
+            /* aborted while the request was in flight */
+            std::promise<RT> discarded;
+
+            try
+            {
+                cookie = do_request_finish(res, discarded);
+            }
+            catch(...)
+            {
+                /* nothing to abort */
+            }
+
+            lock.unlock();
+
+            if(cookie != 0)
+                cm_.abort_cookie(get_proxy_ptr(), cookie);
+
+            cm_.async_request_done(get_proxy_ptr());
+            return;
+        }
+
+        try
+        {
+            cookie = do_request_finish(res, this->promise_);
+        }
+        catch(...)
+        {
+            this->request_failed_unlocked();
+            lock.unlock();
+
+            cm_.async_request_done(get_proxy_ptr());
+
+            if(this->context_data_ != nullptr)
+                this->context_data_->notify(*this, CallState::FAILED);
+
+            return;
+        }
+
+        if(cookie == 0)
+        {
+            this->set_state(CallState::RESULT_FETCHED);
+            fetch_and_notify_unlocked();
+            lock.unlock();
+
+            cm_.async_request_done(get_proxy_ptr());
+            return;
+        }
+
+        this->set_cookie(cookie);
+        this->detached();
+        lock.unlock();
+
+        /* may deliver notifications which have overtaken the answer */
+        manage_cookie(cookie);
+        cm_.async_request_done(get_proxy_ptr());
+    }
+
+    void fetch_async_and_notify()
+    {
+        {
+            LOGGED_LOCK_CONTEXT_HINT;
+            std::lock_guard<LoggedLock::Mutex> lock(this->lock_);
+
+            if(this->get_state() == CallState::READY_TO_FETCH)
+            {
+                if(cancellable_ == nullptr)
+                    cancellable_ = g_cancellable_new();
+
+                this->is_fetching_async_ = true;
+                batch_ = FetchBatch::get_active();
+
+                if(batch_ != nullptr)
+                    batch_->fetch_started();
+
+                do_fetch_async(this->get_cookie(), cancellable_, fetch_ready,
+                               new std::shared_ptr<CookieCall>(self()));
+                return;
+            }
+        }
+
+        /* aborted or failed, nothing to fetch */
+        fetch_and_notify_unlocked();
+    }
+
+    void fetch_done(GAsyncResult *res)
+    {
+        LOGGED_LOCK_CONTEXT_HINT;
+        LoggedLock::UniqueLock<LoggedLock::Mutex> lock(this->lock_);
+
+        this->is_fetching_async_ = false;
+
+        /* if aborted while fetching, then the result is simply freed along
+         * with \p res */
+        if(this->get_state() == CallState::READY_TO_FETCH)
+        {
+            const uint32_t cookie = this->get_cookie();
+            this->put_fetched_result_unlocked(
+                [this, cookie, res] (std::promise<RT> &result)
+                { do_fetch_finish(cookie, res, result); });
+        }
+
+        this->notified_.notify_all();
+
+        FetchBatch *const batch = batch_;
+        batch_ = nullptr;
+        lock.unlock();
+
+        if(batch != nullptr)
+            batch->fetch_done(
+                [call = self()]
+                {
+                    if(call->context_data_ != nullptr)
+                        call->context_data_->notify(*call, call->get_state());
+                });
+        else if(this->context_data_ != nullptr)
+            this->context_data_->notify(*this, this->get_state());
+    }
+
+    void cancel_async_fetch_unlocked() final override
+    {
+        if(cancellable_ != nullptr)
+            g_cancellable_cancel(cancellable_);
+    }
+
   protected:
     virtual const void *get_proxy_ptr() const = 0;
     virtual uint32_t do_request(std::promise<RT> &result) = 0;
     virtual void do_fetch(uint32_t cookie, std::promise<RT> &result) = 0;
+
+    /*!
+     * Start asynchronous variant of the request.
+     *
+     * Implementations call the D-Bus method's asynchronous variant with the
+     * parameters passed to this function.
+     */
+    virtual void do_request_async(GCancellable *cancellable,
+                                  GAsyncReadyCallback ready,
+                                  gpointer user_data) = 0;
+
+    /*!
+     * Finish asynchronous request.
+     *
+     * Same requirements as for #DBusRNF::CookieCall::do_request(), but the
+     * results are to be obtained from \p res by the D-Bus method's
+     * \c _finish() function.
+     */
+    virtual uint32_t do_request_finish(GAsyncResult *res,
+                                       std::promise<RT> &result) = 0;
+
+    /*!
+     * Start asynchronous variant of fetching by cookie.
+     */
+    virtual void do_fetch_async(uint32_t cookie, GCancellable *cancellable,
+                                GAsyncReadyCallback ready,
+                                gpointer user_data) = 0;
+
+    /*!
+     * Finish asynchronous fetch.
+     *
+     * Same requirements as for #DBusRNF::CookieCall::do_fetch(), but the
+     * results are to be obtained from \p res by the D-Bus method's
+     * \c _finish() function.
+     */
+    virtual void do_fetch_finish(uint32_t cookie, GAsyncResult *res,
+                                 std::promise<RT> &result) = 0;
 };
 
 }
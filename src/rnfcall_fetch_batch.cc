@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "rnfcall_fetch_batch.hh"
+#include "messages.h"
+
+static thread_local DBusRNF::FetchBatch *active_batch;
+
+DBusRNF::FetchBatch::FetchBatch():
+    ctx_(g_main_context_new()),
+    fetches_in_flight_(0)
+{
+    if(active_batch != nullptr)
+        MSG_BUG("Nested RNF fetch batch");
+
+    g_main_context_push_thread_default(ctx_);
+    active_batch = this;
+}
+
+DBusRNF::FetchBatch::~FetchBatch()
+{
+    finish();
+}
+
+void DBusRNF::FetchBatch::finish()
+{
+    if(ctx_ == nullptr)
+        return;
+
+    while(fetches_in_flight_ > 0)
+        g_main_context_iteration(ctx_, TRUE);
+
+    active_batch = nullptr;
+    g_main_context_pop_thread_default(ctx_);
+    g_main_context_unref(ctx_);
+    ctx_ = nullptr;
+
+    for(const auto &fn : deferred_notifications_)
+    {
+        try
+        {
+            fn();
+        }
+        catch(const std::exception &e)
+        {
+            MSG_BUG("Got exception while notifying batched fetch (%s)", e.what());
+        }
+        catch(...)
+        {
+            MSG_BUG("Got exception while notifying batched fetch");
+        }
+    }
+
+    deferred_notifications_.clear();
+}
+
+DBusRNF::FetchBatch *DBusRNF::FetchBatch::get_active()
+{
+    return active_batch;
+}
+
+void DBusRNF::FetchBatch::fetch_done(std::function<void()> &&notify)
+{
+    msg_log_assert(fetches_in_flight_ > 0);
+    --fetches_in_flight_;
+
+    if(notify != nullptr)
+        deferred_notifications_.emplace_back(std::move(notify));
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#ifndef RNFCALL_FETCH_BATCH_HH
+#define RNFCALL_FETCH_BATCH_HH
+
+#include <functional>
+#include <vector>
+
+#include <gio/gio.h>
+
+namespace DBusRNF
+{
+
+/*!
+ * Fetch results for several cookies in a single pipelined round.
+ *
+ * List brokers frequently report a whole bunch of cookies as ready in a single
+ * \c DataAvailable signal. Fetching their results one after the other costs
+ * one D-Bus round trip per cookie. While an object of this class exists, RNF
+ * calls fetch their results asynchronously instead, with the answers being
+ * dispatched to a private GLib main context. Function
+ * #DBusRNF::FetchBatch::finish() waits for all answers in that context, so
+ * that the calling thread blocks only as long as the slowest fetch takes.
+ *
+ * Notifications of the calls' context data are deferred until all answers
+ * have arrived and the private main context is gone. This way, any
+ * asynchronous operations started by client code from their notification
+ * functions are bound to the thread's regular main context.
+ *
+ * Objects of this class must be used from a single thread, and they cannot
+ * be nested.
+ */
+class FetchBatch
+{
+  private:
+    GMainContext *ctx_;
+    unsigned int fetches_in_flight_;
+    std::vector<std::function<void()>> deferred_notifications_;
+
+  public:
+    FetchBatch(const FetchBatch &) = delete;
+    FetchBatch(FetchBatch &&) = delete;
+    FetchBatch &operator=(const FetchBatch &) = delete;
+    FetchBatch &operator=(FetchBatch &&) = delete;
+
+    explicit FetchBatch();
+    ~FetchBatch();
+
+    /*!
+     * Wait for all fetches, then notify about their results.
+     *
+     * This function is called by the destructor if it has not been called
+     * explicitly. It does nothing when called a second time.
+     */
+    void finish();
+
+    /*!
+     * Batch active in the calling thread, if any.
+     */
+    static FetchBatch *get_active();
+
+    /*!
+     * An asynchronous fetch has been started in the private main context.
+     */
+    void fetch_started() { ++fetches_in_flight_; }
+
+    /*!
+     * An asynchronous fetch has finished, notification is deferred.
+     */
+    void fetch_done(std::function<void()> &&notify);
+};
+
+}
+
+#endif /* !RNFCALL_FETCH_BATCH_HH */
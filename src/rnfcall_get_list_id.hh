@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2019, 2020, 2021, 2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2019, 2020, 2021, 2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -105,6 +105,77 @@ class GetListIDCall final: public GetListIDCallBase
 
   protected:
     uint32_t do_request(std::promise<ResultType> &result) final override
+    {
+        return process_request_answer(
+            [this] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_list_id_sync(
+                    proxy_, list_id_.get_raw_id(), item_index_, out...,
+                    nullptr, error);
+            },
+            result);
+    }
+
+    void do_request_async(GCancellable *cancellable,
+                          GAsyncReadyCallback ready,
+                          gpointer user_data) final override
+    {
+        tdbus_lists_navigation_call_get_list_id(
+            proxy_, list_id_.get_raw_id(), item_index_, cancellable, ready,
+            user_data);
+    }
+
+    uint32_t do_request_finish(GAsyncResult *res,
+                               std::promise<ResultType> &result) final override
+    {
+        return process_request_answer(
+            [this, res] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_list_id_finish(
+                    proxy_, out..., res, error);
+            },
+            result);
+    }
+
+    void do_fetch(uint32_t cookie, std::promise<ResultType> &result) final override
+    {
+        process_fetch_answer(
+            cookie,
+            [this, cookie] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_list_id_by_cookie_sync(
+                    proxy_, cookie, out..., nullptr, error);
+            },
+            result);
+    }
+
+    void do_fetch_async(uint32_t cookie, GCancellable *cancellable,
+                        GAsyncReadyCallback ready,
+                        gpointer user_data) final override
+    {
+        tdbus_lists_navigation_call_get_list_id_by_cookie(
+            proxy_, cookie, cancellable, ready, user_data);
+    }
+
+    void do_fetch_finish(uint32_t cookie, GAsyncResult *res,
+                         std::promise<ResultType> &result) final override
+    {
+        process_fetch_answer(
+            cookie,
+            [this, res] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_list_id_by_cookie_finish(
+                    proxy_, out..., res, error);
+            },
+            result);
+    }
+
+    const char *name() const final override { return "GetListId"; }
+
+  private:
+    template <typename F>
+    uint32_t process_request_answer(F &&get_answer,
+                                    std::promise<ResultType> &result)
     {
         guint cookie;
         guchar error_code;
@@ -113,10 +184,8 @@ class GetListIDCall final: public GetListIDCallBase
         gboolean list_title_translatable = FALSE;
         GErrorWrapper error;
 
-        tdbus_lists_navigation_call_get_list_id_sync(
-            proxy_, list_id_.get_raw_id(), item_index_,
-            &cookie, &error_code, &requested_list_id, &list_title,
-            &list_title_translatable, nullptr, error.await());
+        get_answer(error.await(), &cookie, &error_code, &requested_list_id,
+                   &list_title, &list_title_translatable);
 
         if(error.log_failure("Get list ID"))
         {
@@ -136,7 +205,9 @@ class GetListIDCall final: public GetListIDCallBase
         return cookie;
     }
 
-    void do_fetch(uint32_t cookie, std::promise<ResultType> &result) final override
+    template <typename F>
+    void process_fetch_answer(uint32_t cookie, F &&get_answer,
+                              std::promise<ResultType> &result)
     {
         guchar error_code;
         guint requested_list_id;
@@ -144,9 +215,8 @@ class GetListIDCall final: public GetListIDCallBase
         gboolean list_title_translatable = FALSE;
         GErrorWrapper error;
 
-        tdbus_lists_navigation_call_get_list_id_by_cookie_sync(
-            proxy_, cookie, &error_code, &requested_list_id, &list_title,
-            &list_title_translatable, nullptr, error.await());
+        get_answer(error.await(), &error_code, &requested_list_id, &list_title,
+                   &list_title_translatable);
 
         if(error.log_failure("Get list ID by cookie"))
         {
@@ -164,8 +234,6 @@ class GetListIDCall final: public GetListIDCallBase
 
         g_free(list_title);
     }
-
-    const char *name() const final override { return "GetListId"; }
 };
 
 class GetParameterizedListIDCall final: public GetListIDCallBase
@@ -200,6 +268,77 @@ class GetParameterizedListIDCall final: public GetListIDCallBase
 
   protected:
     uint32_t do_request(std::promise<ResultType> &result) final override
+    {
+        return process_request_answer(
+            [this] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_parameterized_list_id_sync(
+                    proxy_, list_id_.get_raw_id(), item_index_,
+                    search_query_.c_str(), out..., nullptr, error);
+            },
+            result);
+    }
+
+    void do_request_async(GCancellable *cancellable,
+                          GAsyncReadyCallback ready,
+                          gpointer user_data) final override
+    {
+        tdbus_lists_navigation_call_get_parameterized_list_id(
+            proxy_, list_id_.get_raw_id(), item_index_, search_query_.c_str(),
+            cancellable, ready, user_data);
+    }
+
+    uint32_t do_request_finish(GAsyncResult *res,
+                               std::promise<ResultType> &result) final override
+    {
+        return process_request_answer(
+            [this, res] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_parameterized_list_id_finish(
+                    proxy_, out..., res, error);
+            },
+            result);
+    }
+
+    void do_fetch(uint32_t cookie, std::promise<ResultType> &result) final override
+    {
+        process_fetch_answer(
+            cookie,
+            [this, cookie] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_parameterized_list_id_by_cookie_sync(
+                    proxy_, cookie, out..., nullptr, error);
+            },
+            result);
+    }
+
+    void do_fetch_async(uint32_t cookie, GCancellable *cancellable,
+                        GAsyncReadyCallback ready,
+                        gpointer user_data) final override
+    {
+        tdbus_lists_navigation_call_get_parameterized_list_id_by_cookie(
+            proxy_, cookie, cancellable, ready, user_data);
+    }
+
+    void do_fetch_finish(uint32_t cookie, GAsyncResult *res,
+                         std::promise<ResultType> &result) final override
+    {
+        process_fetch_answer(
+            cookie,
+            [this, res] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_parameterized_list_id_by_cookie_finish(
+                    proxy_, out..., res, error);
+            },
+            result);
+    }
+
+    const char *name() const final override { return "GetParameterizedListId"; }
+
+  private:
+    template <typename F>
+    uint32_t process_request_answer(F &&get_answer,
+                                    std::promise<ResultType> &result)
     {
         guint cookie;
         guchar error_code;
@@ -208,10 +347,8 @@ class GetParameterizedListIDCall final: public GetListIDCallBase
         gboolean list_title_translatable = FALSE;
         GErrorWrapper error;
 
-        tdbus_lists_navigation_call_get_parameterized_list_id_sync(
-            proxy_, list_id_.get_raw_id(), item_index_, search_query_.c_str(),
-            &cookie, &error_code, &requested_list_id, &list_title,
-            &list_title_translatable, nullptr, error.await());
+        get_answer(error.await(), &cookie, &error_code, &requested_list_id,
+                   &list_title, &list_title_translatable);
 
         if(error.log_failure("Get parameterized list ID"))
         {
@@ -231,7 +368,9 @@ class GetParameterizedListIDCall final: public GetListIDCallBase
         return cookie;
     }
 
-    void do_fetch(uint32_t cookie, std::promise<ResultType> &result) final override
+    template <typename F>
+    void process_fetch_answer(uint32_t cookie, F &&get_answer,
+                              std::promise<ResultType> &result)
     {
         guchar error_code;
         guint requested_list_id;
@@ -239,9 +378,8 @@ class GetParameterizedListIDCall final: public GetListIDCallBase
         gboolean list_title_translatable = FALSE;
         GErrorWrapper error;
 
-        tdbus_lists_navigation_call_get_parameterized_list_id_by_cookie_sync(
-            proxy_, cookie, &error_code, &requested_list_id, &list_title,
-            &list_title_translatable, nullptr, error.await());
+        get_answer(error.await(), &error_code, &requested_list_id, &list_title,
+                   &list_title_translatable);
 
         if(error.log_failure("Get parameterized list ID by cookie"))
         {
@@ -260,8 +398,6 @@ class GetParameterizedListIDCall final: public GetListIDCallBase
 
         g_free(list_title);
     }
-
-    const char *name() const final override { return "GetParameterizedListId"; }
 };
 
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2019, 2020, 2021, 2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2019, 2020, 2021, 2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -65,16 +65,86 @@ class GetLocationTraceCall final:
     const void *get_proxy_ptr() const final override { return proxy_; }
 
     uint32_t do_request(std::promise<ResultType> &result) final override
+    {
+        return process_request_answer(
+            [this] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_location_trace_sync(
+                    proxy_, list_id_.get_raw_id(), item_index_,
+                    ref_list_id_.get_raw_id(), ref_item_index_, out...,
+                    nullptr, error);
+            },
+            result);
+    }
+
+    void do_request_async(GCancellable *cancellable,
+                          GAsyncReadyCallback ready,
+                          gpointer user_data) final override
+    {
+        tdbus_lists_navigation_call_get_location_trace(
+            proxy_, list_id_.get_raw_id(), item_index_,
+            ref_list_id_.get_raw_id(), ref_item_index_, cancellable, ready,
+            user_data);
+    }
+
+    uint32_t do_request_finish(GAsyncResult *res,
+                               std::promise<ResultType> &result) final override
+    {
+        return process_request_answer(
+            [this, res] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_location_trace_finish(
+                    proxy_, out..., res, error);
+            },
+            result);
+    }
+
+    void do_fetch(uint32_t cookie, std::promise<ResultType> &result) final override
+    {
+        process_fetch_answer(
+            cookie,
+            [this] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_location_trace_by_cookie_sync(
+                    proxy_, get_cookie(), out..., nullptr, error);
+            },
+            result);
+    }
+
+    void do_fetch_async(uint32_t cookie, GCancellable *cancellable,
+                        GAsyncReadyCallback ready,
+                        gpointer user_data) final override
+    {
+        tdbus_lists_navigation_call_get_location_trace_by_cookie(
+            proxy_, cookie, cancellable, ready, user_data);
+    }
+
+    void do_fetch_finish(uint32_t cookie, GAsyncResult *res,
+                         std::promise<ResultType> &result) final override
+    {
+        process_fetch_answer(
+            cookie,
+            [this, res] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_location_trace_by_cookie_finish(
+                    proxy_, out..., res, error);
+            },
+            result);
+    }
+
+    const char *name() const final override { return "GetLocationTrace"; }
+
+  private:
+    template <typename F>
+    uint32_t process_request_answer(F &&get_answer,
+                                    std::promise<ResultType> &result)
     {
         guint cookie;
         guchar error_code;
         gchar *location_url = nullptr;
         GErrorWrapper error;
 
-        tdbus_lists_navigation_call_get_location_trace_sync(
-                proxy_, list_id_.get_raw_id(), item_index_,
-                ref_list_id_.get_raw_id(), ref_item_index_,
-                &cookie, &error_code, &location_url, nullptr, error.await());
+        get_answer(error.await(), &cookie, &error_code, &location_url);
 
         if(error.log_failure("Get location trace"))
         {
@@ -95,15 +165,15 @@ class GetLocationTraceCall final:
         return cookie;
     }
 
-    void do_fetch(uint32_t cookie, std::promise<ResultType> &result) final override
+    template <typename F>
+    void process_fetch_answer(uint32_t cookie, F &&get_answer,
+                              std::promise<ResultType> &result)
     {
         guchar error_code;
         gchar *location_url = nullptr;
         GErrorWrapper error;
 
-        tdbus_lists_navigation_call_get_location_trace_by_cookie_sync(
-                proxy_, get_cookie(), &error_code, &location_url,
-                nullptr, error.await());
+        get_answer(error.await(), &error_code, &location_url);
 
         if(error.log_failure("Get location trace by cookie"))
         {
@@ -122,8 +192,6 @@ class GetLocationTraceCall final:
 
         g_free(location_url);
     }
-
-    const char *name() const final override { return "GetLocationTrace"; }
 };
 
 }
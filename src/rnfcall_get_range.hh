@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2019--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2019--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -239,6 +239,77 @@ class GetRangeCall final: public GetRangeCallBase
 
   protected:
     uint32_t do_request(std::promise<ResultType> &result) final override
+    {
+        return process_request_answer(
+            [this] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_range_sync(
+                    proxy_, list_id_.get_raw_id(), loading_segment_.line(),
+                    loading_segment_.size(), out..., nullptr, error);
+            },
+            result);
+    }
+
+    void do_request_async(GCancellable *cancellable,
+                          GAsyncReadyCallback ready,
+                          gpointer user_data) final override
+    {
+        tdbus_lists_navigation_call_get_range(
+            proxy_, list_id_.get_raw_id(), loading_segment_.line(),
+            loading_segment_.size(), cancellable, ready, user_data);
+    }
+
+    uint32_t do_request_finish(GAsyncResult *res,
+                               std::promise<ResultType> &result) final override
+    {
+        return process_request_answer(
+            [this, res] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_range_finish(
+                    proxy_, out..., res, error);
+            },
+            result);
+    }
+
+    void do_fetch(uint32_t cookie, std::promise<ResultType> &result) final override
+    {
+        process_fetch_answer(
+            cookie,
+            [this, cookie] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_range_by_cookie_sync(
+                    proxy_, cookie, out..., nullptr, error);
+            },
+            result);
+    }
+
+    void do_fetch_async(uint32_t cookie, GCancellable *cancellable,
+                        GAsyncReadyCallback ready,
+                        gpointer user_data) final override
+    {
+        tdbus_lists_navigation_call_get_range_by_cookie(
+            proxy_, cookie, cancellable, ready, user_data);
+    }
+
+    void do_fetch_finish(uint32_t cookie, GAsyncResult *res,
+                         std::promise<ResultType> &result) final override
+    {
+        process_fetch_answer(
+            cookie,
+            [this, res] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_range_by_cookie_finish(
+                    proxy_, out..., res, error);
+            },
+            result);
+    }
+
+    const char *name() const final override { return "GetRange"; }
+
+  private:
+    template <typename F>
+    uint32_t process_request_answer(F &&get_answer,
+                                    std::promise<ResultType> &result)
     {
         guint cookie;
         guchar error_code;
@@ -246,10 +317,8 @@ class GetRangeCall final: public GetRangeCallBase
         GVariant *out_list = nullptr;
         GErrorWrapper error;
 
-        tdbus_lists_navigation_call_get_range_sync(
-            proxy_, list_id_.get_raw_id(), loading_segment_.line(),
-            loading_segment_.size(), &cookie, &error_code,
-            &first_item_id, &out_list, nullptr, error.await());
+        get_answer(error.await(), &cookie, &error_code, &first_item_id,
+                   &out_list);
 
         if(error.log_failure("Get range"))
         {
@@ -282,16 +351,16 @@ class GetRangeCall final: public GetRangeCallBase
         return 0;
     }
 
-    void do_fetch(uint32_t cookie, std::promise<ResultType> &result) final override
+    template <typename F>
+    void process_fetch_answer(uint32_t cookie, F &&get_answer,
+                              std::promise<ResultType> &result)
     {
         guchar error_code;
         guint first_item_id;
         GVariant *out_list = nullptr;
         GErrorWrapper error;
 
-        tdbus_lists_navigation_call_get_range_by_cookie_sync(
-            proxy_, cookie, &error_code, &first_item_id, &out_list,
-            nullptr, error.await());
+        get_answer(error.await(), &error_code, &first_item_id, &out_list);
 
         if(error.log_failure("Get range by cookie"))
         {
@@ -321,8 +390,6 @@ class GetRangeCall final: public GetRangeCallBase
 
         result.set_value(GetRangeResult(first_item_id, std::move(list), false));
     }
-
-    const char *name() const final override { return "GetRange"; }
 };
 
 class GetRangeWithMetaDataCall final: public GetRangeCallBase
@@ -356,6 +423,77 @@ class GetRangeWithMetaDataCall final: public GetRangeCallBase
 
   protected:
     uint32_t do_request(std::promise<ResultType> &result) final override
+    {
+        return process_request_answer(
+            [this] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_range_with_meta_data_sync(
+                    proxy_, list_id_.get_raw_id(), loading_segment_.line(),
+                    loading_segment_.size(), out..., nullptr, error);
+            },
+            result);
+    }
+
+    void do_request_async(GCancellable *cancellable,
+                          GAsyncReadyCallback ready,
+                          gpointer user_data) final override
+    {
+        tdbus_lists_navigation_call_get_range_with_meta_data(
+            proxy_, list_id_.get_raw_id(), loading_segment_.line(),
+            loading_segment_.size(), cancellable, ready, user_data);
+    }
+
+    uint32_t do_request_finish(GAsyncResult *res,
+                               std::promise<ResultType> &result) final override
+    {
+        return process_request_answer(
+            [this, res] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_range_with_meta_data_finish(
+                    proxy_, out..., res, error);
+            },
+            result);
+    }
+
+    void do_fetch(uint32_t cookie, std::promise<ResultType> &result) final override
+    {
+        process_fetch_answer(
+            cookie,
+            [this, cookie] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_range_with_meta_data_by_cookie_sync(
+                    proxy_, cookie, out..., nullptr, error);
+            },
+            result);
+    }
+
+    void do_fetch_async(uint32_t cookie, GCancellable *cancellable,
+                        GAsyncReadyCallback ready,
+                        gpointer user_data) final override
+    {
+        tdbus_lists_navigation_call_get_range_with_meta_data_by_cookie(
+            proxy_, cookie, cancellable, ready, user_data);
+    }
+
+    void do_fetch_finish(uint32_t cookie, GAsyncResult *res,
+                         std::promise<ResultType> &result) final override
+    {
+        process_fetch_answer(
+            cookie,
+            [this, res] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_range_with_meta_data_by_cookie_finish(
+                    proxy_, out..., res, error);
+            },
+            result);
+    }
+
+    const char *name() const final override { return "GetRangeWithMetaData"; }
+
+  private:
+    template <typename F>
+    uint32_t process_request_answer(F &&get_answer,
+                                    std::promise<ResultType> &result)
     {
         guint cookie;
         guchar error_code;
@@ -363,10 +501,8 @@ class GetRangeWithMetaDataCall final: public GetRangeCallBase
         GVariant *out_list = nullptr;
         GErrorWrapper error;
 
-        tdbus_lists_navigation_call_get_range_with_meta_data_sync(
-            proxy_, list_id_.get_raw_id(), loading_segment_.line(),
-            loading_segment_.size(), &cookie, &error_code,
-            &first_item_id, &out_list, nullptr, error.await());
+        get_answer(error.await(), &cookie, &error_code, &first_item_id,
+                   &out_list);
 
         if(error.log_failure("Get range with meta data"))
         {
@@ -400,16 +536,16 @@ class GetRangeWithMetaDataCall final: public GetRangeCallBase
         return 0;
     }
 
-    void do_fetch(uint32_t cookie, std::promise<ResultType> &result) final override
+    template <typename F>
+    void process_fetch_answer(uint32_t cookie, F &&get_answer,
+                              std::promise<ResultType> &result)
     {
         guchar error_code;
         guint first_item_id;
         GVariant *out_list = nullptr;
         GErrorWrapper error;
 
-        tdbus_lists_navigation_call_get_range_with_meta_data_by_cookie_sync(
-            proxy_, cookie, &error_code, &first_item_id, &out_list,
-            nullptr, error.await());
+        get_answer(error.await(), &error_code, &first_item_id, &out_list);
 
         if(error.log_failure("Get range with meta data by cookie"))
         {
@@ -440,8 +576,6 @@ class GetRangeWithMetaDataCall final: public GetRangeCallBase
 
         result.set_value(GetRangeResult(first_item_id, std::move(list), true));
     }
-
-    const char *name() const final override { return "GetRangeWithMetaData"; }
 };
 
 }
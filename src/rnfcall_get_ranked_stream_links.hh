@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2019--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2019--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -81,6 +81,77 @@ class GetRankedStreamLinksCall final:
     const void *get_proxy_ptr() const final override { return proxy_; }
 
     uint32_t do_request(std::promise<ResultType> &result) final override
+    {
+        return process_request_answer(
+            [this] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_ranked_stream_links_sync(
+                    proxy_, list_id_.get_raw_id(), item_index_, out...,
+                    nullptr, error);
+            },
+            result);
+    }
+
+    void do_request_async(GCancellable *cancellable,
+                          GAsyncReadyCallback ready,
+                          gpointer user_data) final override
+    {
+        tdbus_lists_navigation_call_get_ranked_stream_links(
+            proxy_, list_id_.get_raw_id(), item_index_, cancellable, ready,
+            user_data);
+    }
+
+    uint32_t do_request_finish(GAsyncResult *res,
+                               std::promise<ResultType> &result) final override
+    {
+        return process_request_answer(
+            [this, res] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_ranked_stream_links_finish(
+                    proxy_, out..., res, error);
+            },
+            result);
+    }
+
+    void do_fetch(uint32_t cookie, std::promise<ResultType> &result) final override
+    {
+        process_fetch_answer(
+            cookie,
+            [this, cookie] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_ranked_stream_links_by_cookie_sync(
+                    proxy_, cookie, out..., nullptr, error);
+            },
+            result);
+    }
+
+    void do_fetch_async(uint32_t cookie, GCancellable *cancellable,
+                        GAsyncReadyCallback ready,
+                        gpointer user_data) final override
+    {
+        tdbus_lists_navigation_call_get_ranked_stream_links_by_cookie(
+            proxy_, cookie, cancellable, ready, user_data);
+    }
+
+    void do_fetch_finish(uint32_t cookie, GAsyncResult *res,
+                         std::promise<ResultType> &result) final override
+    {
+        process_fetch_answer(
+            cookie,
+            [this, res] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_ranked_stream_links_by_cookie_finish(
+                    proxy_, out..., res, error);
+            },
+            result);
+    }
+
+    const char *name() const final override { return "GetRankedStreamLinks"; }
+
+  private:
+    template <typename F>
+    uint32_t process_request_answer(F &&get_answer,
+                                    std::promise<ResultType> &result)
     {
         guint cookie;
         guchar error_code;
@@ -88,9 +159,8 @@ class GetRankedStreamLinksCall final:
         GVariant *image_stream_key = nullptr;
         GErrorWrapper error;
 
-        tdbus_lists_navigation_call_get_ranked_stream_links_sync(
-            proxy_, list_id_.get_raw_id(), item_index_, &cookie, &error_code,
-            &link_list, &image_stream_key, nullptr, error.await());
+        get_answer(error.await(), &cookie, &error_code, &link_list,
+                   &image_stream_key);
 
         if(error.log_failure("Get ranked stream links"))
         {
@@ -110,16 +180,16 @@ class GetRankedStreamLinksCall final:
         return cookie;
     }
 
-    void do_fetch(uint32_t cookie, std::promise<ResultType> &result) final override
+    template <typename F>
+    void process_fetch_answer(uint32_t cookie, F &&get_answer,
+                              std::promise<ResultType> &result)
     {
         guchar error_code;
         GVariant *link_list = nullptr;
         GVariant *image_stream_key = nullptr;
         GErrorWrapper error;
 
-        tdbus_lists_navigation_call_get_ranked_stream_links_by_cookie_sync(
-            proxy_, cookie, &error_code, &link_list, &image_stream_key,
-            nullptr, error.await());
+        get_answer(error.await(), &error_code, &link_list, &image_stream_key);
 
         if(error.log_failure("Get ranked stream links by cookie"))
         {
@@ -136,8 +206,6 @@ class GetRankedStreamLinksCall final:
             GVariantWrapper(link_list, GVariantWrapper::Transfer::JUST_MOVE),
             GVariantWrapper(image_stream_key, GVariantWrapper::Transfer::JUST_MOVE)));
     }
-
-    const char *name() const final override { return "GetRankedStreamLinks"; }
 };
 
 }
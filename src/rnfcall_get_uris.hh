@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2019, 2020, 2022, 2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2019, 2020, 2022, 2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -106,6 +106,77 @@ class GetURIsCall final:
     const void *get_proxy_ptr() const final override { return proxy_; }
 
     uint32_t do_request(std::promise<ResultType> &result) final override
+    {
+        return process_request_answer(
+            [this] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_uris_sync(
+                    proxy_, list_id_.get_raw_id(), item_index_, out...,
+                    nullptr, error);
+            },
+            result);
+    }
+
+    void do_request_async(GCancellable *cancellable,
+                          GAsyncReadyCallback ready,
+                          gpointer user_data) final override
+    {
+        tdbus_lists_navigation_call_get_uris(
+            proxy_, list_id_.get_raw_id(), item_index_, cancellable, ready,
+            user_data);
+    }
+
+    uint32_t do_request_finish(GAsyncResult *res,
+                               std::promise<ResultType> &result) final override
+    {
+        return process_request_answer(
+            [this, res] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_uris_finish(
+                    proxy_, out..., res, error);
+            },
+            result);
+    }
+
+    void do_fetch(uint32_t cookie, std::promise<ResultType> &result) final override
+    {
+        process_fetch_answer(
+            cookie,
+            [this, cookie] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_uris_by_cookie_sync(
+                    proxy_, cookie, out..., nullptr, error);
+            },
+            result);
+    }
+
+    void do_fetch_async(uint32_t cookie, GCancellable *cancellable,
+                        GAsyncReadyCallback ready,
+                        gpointer user_data) final override
+    {
+        tdbus_lists_navigation_call_get_uris_by_cookie(
+            proxy_, cookie, cancellable, ready, user_data);
+    }
+
+    void do_fetch_finish(uint32_t cookie, GAsyncResult *res,
+                         std::promise<ResultType> &result) final override
+    {
+        process_fetch_answer(
+            cookie,
+            [this, res] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_get_uris_by_cookie_finish(
+                    proxy_, out..., res, error);
+            },
+            result);
+    }
+
+    const char *name() const final override { return "GetURIs"; }
+
+  private:
+    template <typename F>
+    uint32_t process_request_answer(F &&get_answer,
+                                    std::promise<ResultType> &result)
     {
         guint cookie;
         guchar error_code;
@@ -113,9 +184,8 @@ class GetURIsCall final:
         GVariant *image_stream_key = nullptr;
         GErrorWrapper error;
 
-        tdbus_lists_navigation_call_get_uris_sync(
-            proxy_, list_id_.get_raw_id(), item_index_, &cookie, &error_code,
-            &uri_list, &image_stream_key, nullptr, error.await());
+        get_answer(error.await(), &cookie, &error_code, &uri_list,
+                   &image_stream_key);
 
         if(error.log_failure("Get URIs"))
         {
@@ -134,16 +204,16 @@ class GetURIsCall final:
         return cookie;
     }
 
-    void do_fetch(uint32_t cookie, std::promise<ResultType> &result) final override
+    template <typename F>
+    void process_fetch_answer(uint32_t cookie, F &&get_answer,
+                              std::promise<ResultType> &result)
     {
         guchar error_code;
         gchar **uri_list = nullptr;
         GVariant *image_stream_key = nullptr;
         GErrorWrapper error;
 
-        tdbus_lists_navigation_call_get_uris_by_cookie_sync(
-            proxy_, cookie, &error_code, &uri_list, &image_stream_key,
-            nullptr, error.await());
+        get_answer(error.await(), &error_code, &uri_list, &image_stream_key);
 
         if(error.log_failure("Get URIs by cookie"))
         {
@@ -159,8 +229,6 @@ class GetURIsCall final:
             ListError(error_code), uri_list,
             GVariantWrapper(image_stream_key, GVariantWrapper::Transfer::JUST_MOVE)));
     }
-
-    const char *name() const final override { return "GetURIs"; }
 };
 
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2019, 2020, 2021, 2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2019, 2020, 2021, 2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -90,14 +90,81 @@ class RealizeLocationCall final:
     const void *get_proxy_ptr() const final override { return proxy_; }
 
     uint32_t do_request(std::promise<ResultType> &result) final override
+    {
+        return process_request_answer(
+            [this] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_realize_location_sync(
+                    proxy_, url_.c_str(), out..., nullptr, error);
+            },
+            result);
+    }
+
+    void do_request_async(GCancellable *cancellable,
+                          GAsyncReadyCallback ready,
+                          gpointer user_data) final override
+    {
+        tdbus_lists_navigation_call_realize_location(
+            proxy_, url_.c_str(), cancellable, ready, user_data);
+    }
+
+    uint32_t do_request_finish(GAsyncResult *res,
+                               std::promise<ResultType> &result) final override
+    {
+        return process_request_answer(
+            [this, res] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_realize_location_finish(
+                    proxy_, out..., res, error);
+            },
+            result);
+    }
+
+    void do_fetch(uint32_t cookie, std::promise<ResultType> &result) final override
+    {
+        process_fetch_answer(
+            cookie,
+            [this, cookie] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_realize_location_by_cookie_sync(
+                    proxy_, cookie, out..., nullptr, error);
+            },
+            result);
+    }
+
+    void do_fetch_async(uint32_t cookie, GCancellable *cancellable,
+                        GAsyncReadyCallback ready,
+                        gpointer user_data) final override
+    {
+        tdbus_lists_navigation_call_realize_location_by_cookie(
+            proxy_, cookie, cancellable, ready, user_data);
+    }
+
+    void do_fetch_finish(uint32_t cookie, GAsyncResult *res,
+                         std::promise<ResultType> &result) final override
+    {
+        process_fetch_answer(
+            cookie,
+            [this, res] (GError **error, auto... out)
+            {
+                tdbus_lists_navigation_call_realize_location_by_cookie_finish(
+                    proxy_, out..., res, error);
+            },
+            result);
+    }
+
+    const char *name() const final override { return "RealizeLocation"; }
+
+  private:
+    template <typename F>
+    uint32_t process_request_answer(F &&get_answer,
+                                    std::promise<ResultType> &result)
     {
         guint cookie;
         guchar error_code;
         GErrorWrapper error;
 
-        tdbus_lists_navigation_call_realize_location_sync(
-            proxy_, url_.c_str(), &cookie, &error_code,
-            nullptr, error.await());
+        get_answer(error.await(), &cookie, &error_code);
 
         if(error.log_failure("Realize location"))
         {
@@ -113,7 +180,9 @@ class RealizeLocationCall final:
         return cookie;
     }
 
-    void do_fetch(uint32_t cookie, std::promise<ResultType> &result) final override
+    template <typename F>
+    void process_fetch_answer(uint32_t cookie, F &&get_answer,
+                              std::promise<ResultType> &result)
     {
         guchar error_code;
         guint list_id;
@@ -126,11 +195,9 @@ class RealizeLocationCall final:
         gboolean list_title_translatable;
         GErrorWrapper error;
 
-        tdbus_lists_navigation_call_realize_location_by_cookie_sync(
-            proxy_, cookie, &error_code, &list_id, &item_id,
-            &ref_list_id, &ref_item_id, &distance, &trace_length,
-            &list_title, &list_title_translatable,
-            nullptr, error.await());
+        get_answer(error.await(), &error_code, &list_id, &item_id,
+                   &ref_list_id, &ref_item_id, &distance, &trace_length,
+                   &list_title, &list_title_translatable);
 
         if(error.log_failure("Realize location by cookie"))
         {
@@ -149,8 +216,6 @@ class RealizeLocationCall final:
 
         g_free(list_title);
     }
-
-    const char *name() const final override { return "RealizeLocation"; }
 };
 
 }
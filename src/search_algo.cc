@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016, 2019, 2020, 2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2016, 2019, 2020, 2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -24,533 +24,238 @@
 #endif /* HAVE_CONFIG_H */
 
 #include "search_algo.hh"
+#include "search_key.hh"
 
 #include <glib.h>
-#include <string.h>
 
-/*!
- * RAII wrapper around string allocated by GLib.
- */
-class ComparedString
-{
-  private:
-    char *string_;
-    size_t number_of_utf8_chars_;
-
-  public:
-    ComparedString(const ComparedString &) = delete;
-    ComparedString &operator=(const ComparedString &) = delete;
-
-    explicit ComparedString() throw():
-        string_(nullptr),
-        number_of_utf8_chars_(0)
-    {}
-
-    explicit ComparedString(const char *string, size_t number_of_bytes) throw():
-        string_(nullptr)
-    {
-        set(string, number_of_bytes);
-    }
-
-    ~ComparedString() throw() { g_free(string_); }
-
-    void set(const char *string) throw() { set(string, strlen(string)); }
-
-    void set(const char *string, size_t number_of_bytes) throw()
-    {
-        const glong len = g_utf8_strlen(string, number_of_bytes);
-
-        g_free(string_);
-
-        if(len > 0)
-        {
-            string_ = g_utf8_casefold(string, number_of_bytes);
-            number_of_utf8_chars_ = len;
-        }
-        else
-        {
-            string_ = nullptr;
-            number_of_utf8_chars_ = 0;
-        }
-    }
-
-    const char *get() const throw() { return string_; }
-    size_t length() const throw() { return number_of_utf8_chars_; }
-
-    gunichar get_char_at(size_t idx) const throw()
-    {
-        msg_log_assert(idx < number_of_utf8_chars_);
-        return g_utf8_get_char(g_utf8_offset_to_pointer(string_, idx));
-    }
-};
+#include <map>
+#include <vector>
 
 /*!
- * Pull string from D-Bus list, convert for case-insensitive comparison.
+ * Casefolded list strings probed during a search.
+ *
+ * Probes are fetched in rounds, each taking about one D-Bus round trip. As
+ * long as the range of lines in question is large, a round samples
+ * #ProbeCache::NUMBER_OF_SAMPLES lines spread evenly across the range, all of
+ * them requested concurrently, so that each round narrows down the range to
+ * one of NUMBER_OF_SAMPLES + 1 sub-ranges. Once the range fits into
+ * #ProbeCache::WINDOW_SIZE lines, it is fetched as a whole by a single
+ * get-range request. The probes are kept for the whole search, so the
+ * searches for both partition boundaries and for all characters of the query
+ * share them.
  */
-static bool get_casefolded_string(List::DBusList &list,
-                                  std::shared_ptr<List::DBusListViewport> vp,
-                                  unsigned int position,
-                                  ComparedString &string)
+class ProbeCache
 {
-    const List::TextItem *const item =
-        dynamic_cast<const List::TextItem *>(list.get_item(vp, position));
-
-    if(item == nullptr)
-    {
-        MSG_BUG("List item %u does not exist", position);
-        return false;
-    }
-
-    const char *item_text = item->get_text();
-
-    if(item_text == nullptr)
-    {
-        MSG_BUG("List item %u contains nullptr text", position);
-        return false;
-    }
-
-    string.set(item_text);
+  public:
+    /*!
+     * Number of contiguous lines fetched with a single get-range request.
+     */
+    static constexpr unsigned int WINDOW_SIZE = 32;
 
-    return true;
-}
+    /*!
+     * Number of lines sampled concurrently in a single round.
+     */
+    static constexpr unsigned int NUMBER_OF_SAMPLES = 15;
 
-/*!
- * Simple iterator-like wrapper around a #ComparedString.
- */
-class Needle
-{
   private:
-    const ComparedString needle_;
-
-    size_t next_char_index_;
-    const char *next_char_;
+    List::DBusList &list_;
+    const std::shared_ptr<List::DBusListViewport> window_;
+    std::vector<std::shared_ptr<List::DBusListViewport>> samples_;
+    std::map<unsigned int, Search::Key> strings_;
+    size_t number_of_rounds_;
 
   public:
-    Needle(const Needle &) = delete;
-    Needle &operator=(const Needle &) = delete;
+    ProbeCache(const ProbeCache &) = delete;
+    ProbeCache &operator=(const ProbeCache &) = delete;
 
-    explicit Needle(const char *needle, size_t needle_bytes) throw():
-        needle_(needle, needle_bytes),
-        next_char_index_(0),
-        next_char_(needle_.get())
-    {}
-
-    const char *next_utf8_char() throw()
+    explicit ProbeCache(List::DBusList &list):
+        list_(list),
+        window_(list.mk_viewport(WINDOW_SIZE, "search window")),
+        number_of_rounds_(0)
     {
-        const char *ret = next_char_;
-
-        if(next_char_ != nullptr)
-        {
-            ++next_char_index_;
-
-            next_char_ = ((next_char_index_ < needle_.length())
-                          ? g_utf8_next_char(next_char_)
-                          : nullptr);
-        }
-
-        return ret;
+        for(unsigned int i = 0; i < NUMBER_OF_SAMPLES; ++i)
+            samples_.emplace_back(list.mk_viewport(1, "search sample"));
     }
-};
-
-/*!
- * How to compare strings that are proper prefixes of other strings.
- */
-struct ProperPrefixPolicy
-{
-    static inline bool proper_prefix_is_smaller_than_whole_string() { return true; }
-};
-
-/*!
- * How to search for the top-most boundary (first match) of the partition
- * defined by the search string.
- */
-struct TopMostBoundaryTraits
-{
-    constexpr static inline bool want_top_most_boundary() throw() { return true; }
 
-    /*!
-     * Whether or not the given character should be considered greater than the
-     * search key.
-     *
-     * \param key
-     *     The character we are trying to find the partition for.
-     *
-     * \param ch
-     *     The character within the string currently checked during the binary
-     *     search.
-     */
-    static inline bool is_utf8_character_greater(gunichar key, gunichar ch) throw()
+    ~ProbeCache()
     {
-        return key <= ch;
+        list_.detach_viewport(window_);
     }
-};
 
-/*!
- * How to search for the bottom-most boundary (last match) of the partition
- * defined by the search string.
- *
- * \see #TopMostBoundaryTraits
- */
-struct BottomMostBoundaryTraits
-{
-    constexpr static inline bool want_top_most_boundary() throw() { return false; }
-    static inline bool is_utf8_character_greater(gunichar key, gunichar ch) throw() { return key < ch; }
-};
+    size_t get_number_of_rounds() const { return number_of_rounds_; }
 
-/*!
- * Core implementation of binary search algorithm and search state.
- */
-class BSearchState
-{
-  public:
-    enum class Result
-    {
-        INTERNAL_FAILURE,
-        SEARCHING,
-        CHECKING_BOUNDARY,
-        FOUND_MATCH,
-        FOUND_APPROXIMATE,
-    };
+    const std::map<unsigned int, Search::Key> &get_strings() const { return strings_; }
 
-  private:
     /*!
-     * A partition used by the binary search algorithm.
+     * Fetch lines in given range for narrowing down the range.
+     *
+     * \param first, beyond
+     *     The range of lines in question. None of these lines must be in
+     *     cache yet.
+     *
+     * \returns
+     *     True if at least one line in the range has been fetched, false if
+     *     the list could not be read.
      */
-    struct Partition
+    bool fetch(unsigned int first, unsigned int beyond)
     {
-        unsigned int top_;
-        unsigned int bottom_;
-        unsigned int center_;
-
-        Partition(const Partition &) = delete;
-        Partition &operator=(const Partition &) = delete;
-
-        explicit Partition(): top_(UINT_MAX), bottom_(0), center_(0) {}
-
-        bool is_unique() const throw() { return top_ == bottom_; }
-        bool is_empty() const throw() { return top_ > bottom_; }
-        unsigned int size() const throw() { return bottom_ - top_ + 1; }
-
-        /*!
-         * Move center index one towards the beginning of the partition.
-         */
-        void step_center_up() throw()
-        {
-            msg_log_assert(center_ > top_);
-            --center_;
-        }
-
-        /*!
-         * Move center index one towards the end of the partition.
-         */
-        void step_center_down() throw()
-        {
-            msg_log_assert(center_ < bottom_);
-            ++center_;
-        }
-
-        /*!
-         * Bisect such that the top half is searched next.
-         */
-        Result pick_top_half(unsigned int sub) throw()
-        {
-            bottom_ = center_ - sub;
-            return update_center();
-        }
+        msg_log_assert(first < beyond);
 
-        /*!
-         * Bisect such that the bottom half is searched next.
-         */
-        Result pick_bottom_half(unsigned int add) throw()
-        {
-            top_ = center_ + add;
-            return update_center();
-        }
-
-        /*!
-         * Compute center index.
-         *
-         * Public function for speed in client code.
-         */
-        unsigned int compute_center() const throw()
-        {
-            return top_ + (bottom_ - top_) / 2;
-        }
-
-        /*!
-         * Declare center element the only element in the partition.
-         */
-        void lock_at_center() throw() { top_ = bottom_ = center_; }
-
-      private:
-        Result update_center() throw()
-        {
-            if(!is_unique())
-            {
-                center_ = compute_center();
-                return Result::SEARCHING;
-            }
-            else
-            {
-                center_ = top_;
-                return Result::CHECKING_BOUNDARY;
-            }
-        }
-    };
+        ++number_of_rounds_;
 
-    const std::shared_ptr<List::DBusListViewport> viewport_;
-
-    Partition upper_;
-    Partition lower_;
-
-    unsigned int all_top_;
-    unsigned int all_bottom_;
-    unsigned int bottom_candidate_;
-    gunichar utf8_key_;
-    size_t depth_;
+        if(beyond - first <= WINDOW_SIZE)
+            fetch_window(first);
+        else
+            fetch_samples(first, beyond);
 
-  public:
-    BSearchState(const BSearchState &) = delete;
-    BSearchState &operator=(const BSearchState &) = delete;
-
-    explicit BSearchState(const List::DBusList &list, unsigned int elements) throw():
-        viewport_(list.mk_viewport(1, "binary search")),
-        all_top_(elements > 0 ? 0 : UINT_MAX),
-        all_bottom_(elements > 0 ? elements - 1 : 0),
-        bottom_candidate_(UINT_MAX),
-        utf8_key_(0),
-        depth_(-1)
-    {
-        msg_vinfo(MESSAGE_LEVEL_DEBUG,
-                  "Starting binary search in partition [%u, %u]",
-                  all_top_, all_bottom_);
+        const auto it(strings_.lower_bound(first));
+        return it != strings_.end() && it->first < beyond;
     }
 
-    void prepare_next_iteration(const char *utf8_char) throw()
+  private:
+    void fetch_window(unsigned int first)
     {
-        upper_.top_ = lower_.top_ = all_top_;
-        upper_.bottom_ = lower_.bottom_ = all_bottom_;
-        upper_.center_ = lower_.center_ = upper_.compute_center();
-        bottom_candidate_ = UINT_MAX;
-        utf8_key_ = g_utf8_get_char(utf8_char);
-        ++depth_;
-
-        msg_vinfo(MESSAGE_LEVEL_DEBUG,
-                  "BSEARCH: ----------------------------------------");
-        msg_vinfo(MESSAGE_LEVEL_DEBUG,
-                  "BSEARCH: Partition [%u, %u], center %u, "
-                  "character U+%04" G_GINT32_MODIFIER "X at depth %zu",
-                  all_top_, all_bottom_, upper_.center_, utf8_key_, depth_);
-    }
+        if(list_.get_item(window_, first) == nullptr)
+            return;
 
-    ssize_t get_result() const throw()
-    {
-        return upper_.is_empty() ? -1 : upper_.top_;
-    }
+        const auto &view(window_->view_segment());
 
-    void prepare_for_next_character() throw()
-    {
-        all_top_ = upper_.top_;
-        all_bottom_ = lower_.bottom_;
+        for(unsigned int line = view.line(); line < view.beyond(); ++line)
+            store(line, window_->item_at(line).first);
     }
 
-    Result bsearch_top_most(List::DBusList &list, ComparedString &temp_string)
+    void fetch_samples(unsigned int first, unsigned int beyond)
     {
-        while(true)
-        {
-            if(!get_casefolded_string(list, viewport_, upper_.center_, temp_string))
-                return Result::INTERNAL_FAILURE;
-
-            dump_state("before iteration", true);
+        const uint64_t range = beyond - first;
+        std::vector<unsigned int> lines;
 
-            const Result result =
-                bsearch_boundary<TopMostBoundaryTraits, ProperPrefixPolicy>(temp_string);
+        for(unsigned int i = 1; i <= NUMBER_OF_SAMPLES; ++i)
+            lines.push_back(first + range * i / (NUMBER_OF_SAMPLES + 1));
 
-            dump_state("after iteration", true);
+        list_.get_items_concurrently(samples_, lines);
 
-            switch(result)
-            {
-              case Result::SEARCHING:
-              case Result::CHECKING_BOUNDARY:
-                break;
-
-              case Result::INTERNAL_FAILURE:
-              case Result::FOUND_MATCH:
-              case Result::FOUND_APPROXIMATE:
-                dump_state("determined upper boundary", true);
-                return result;
-            }
-        }
+        for(size_t i = 0; i < lines.size(); ++i)
+            store(lines[i], samples_[i]->item_at(lines[i]).first);
     }
 
-    Result bsearch_bottom_most(List::DBusList &list, ComparedString &temp_string)
+    void store(unsigned int line, const List::Item *it)
     {
-        while(true)
-        {
-            if(!get_casefolded_string(list, viewport_, lower_.center_, temp_string))
-                return Result::INTERNAL_FAILURE;
-
-            dump_state("before iteration", false);
-
-            const Result result =
-                bsearch_boundary<BottomMostBoundaryTraits, ProperPrefixPolicy>(temp_string);
-
-            dump_state("after iteration", false);
-
-            switch(result)
-            {
-              case Result::SEARCHING:
-              case Result::CHECKING_BOUNDARY:
-                break;
+        if(strings_.find(line) != strings_.end())
+            return;
 
-              case Result::INTERNAL_FAILURE:
-              case Result::FOUND_MATCH:
-                dump_state("determined lower boundary", false);
-                return result;
+        const auto *searchable = dynamic_cast<const List::SearchableItem *>(it);
 
-              case Result::FOUND_APPROXIMATE:
-                MSG_BUG("Bogus approximate match for bottom partition boundary");
-                return Result::INTERNAL_FAILURE;
-            }
+        if(searchable != nullptr)
+        {
+            /* casefolded once when the item was constructed */
+            strings_.emplace(line, searchable->get_search_key());
+            return;
         }
-    }
-
-  private:
-    template <typename CompareTraits, typename PrefixPolicy>
-    Result bsearch_boundary(const ComparedString &center_string)
-    {
-        msg_vinfo(MESSAGE_LEVEL_DEBUG,
-                  "BSEARCH: Center element \"%s\", length %zu",
-                  center_string.get(), center_string.length());
-
-        Partition &p(CompareTraits::want_top_most_boundary() ? upper_ : lower_);
 
-        msg_log_assert(!p.is_empty());
+        const auto *item = dynamic_cast<const List::TextItem *>(it);
 
-        if(center_string.length() < depth_)
-        {
-            /* center string is a proper prefix of the search string */
-            return PrefixPolicy::proper_prefix_is_smaller_than_whole_string()
-                ? p.pick_top_half(0)
-                : p.pick_bottom_half(0);
-        }
+        if(item == nullptr)
+            return;
 
-        const gunichar ch = center_string.get_char_at(depth_);
-        msg_vinfo(MESSAGE_LEVEL_DEBUG,
-                  "BSEARCH: Decide on character U+%04" G_GINT32_MODIFIER "X "
-                  "(ref U+%04" G_GINT32_MODIFIER "X)",
-                  ch, utf8_key_);
+        const char *item_text = item->get_text();
 
-        if(p.is_unique())
+        if(item_text == nullptr)
         {
-            msg_vinfo(MESSAGE_LEVEL_DEBUG, "BSEARCH: Final check on last item");
-            return (utf8_key_ == ch) ? Result::FOUND_MATCH : Result::FOUND_APPROXIMATE;
+            MSG_BUG("List item %u contains nullptr text", line);
+            return;
         }
 
-        if(p.size() == 2)
-        {
-            static bool shown_bug = false;
-
-            if(!shown_bug)
-            {
-                MSG_BUG("The binary search should resort to linear search once "
-                        "the searched partition becomes small");
-                shown_bug = true;
-            }
-
-            if(utf8_key_ == ch)
-            {
-                if(CompareTraits::want_top_most_boundary() || p.center_ >= p.bottom_)
-                {
-                    p.lock_at_center();
-                    return Result::FOUND_MATCH;
-                }
-
-                if(!CompareTraits::want_top_most_boundary())
-                    bottom_candidate_ = p.center_;
-
-                p.step_center_down();
-
-                return Result::SEARCHING;
-            }
+        strings_.emplace(std::piecewise_construct,
+                         std::forward_as_tuple(line), std::forward_as_tuple())
+            .first->second.set(item_text);
+    }
+};
 
-            if(utf8_key_ > ch)
-            {
-                if(p.center_ < p.bottom_)
-                {
-                    p.step_center_down();
-                    return Result::SEARCHING;
-                }
-                else
-                {
-                    p.lock_at_center();
-                    return Result::CHECKING_BOUNDARY;
-                }
-            }
+/*!
+ * Character of a probed string at given depth.
+ *
+ * All strings within the partition searched at \p depth share their first
+ * \p depth characters with the query, so they cannot be shorter than that in
+ * a sorted list. The end of a string is read as NUL character, hence strings
+ * which are a prefix of the query are sorted before all of their extensions.
+ */
+static gunichar char_at_depth(const Search::Key &string, size_t depth)
+{
+    if(string.length() < depth)
+        throw Search::UnsortedException();
 
-            if(CompareTraits::want_top_most_boundary())
-            {
-                p.lock_at_center();
-                return Result::FOUND_APPROXIMATE;
-            }
-            else if(bottom_candidate_ != UINT_MAX)
-            {
-                p.center_ = bottom_candidate_;
-                p.lock_at_center();
-                return Result::FOUND_MATCH;
-            }
+    return string.get_char_at(depth);
+}
 
-            throw ::Search::UnsortedException();
-        }
+/*!
+ * Find first line in given range which satisfies a predicate.
+ *
+ * The lines in the range are expected to be ordered such that the predicate
+ * is false for all lines up to some line, and true for all remaining lines.
+ * The range is narrowed down using all probes known so far, and new probes
+ * are fetched until the boundary is known.
+ *
+ * \param probes
+ *     Where to get probed strings from.
+ *
+ * \param first, beyond
+ *     The range of lines to search in.
+ *
+ * \param pred
+ *     The predicate.
+ *
+ * \param[out] found
+ *     The first line in the range for which \p pred returns true, or
+ *     \p beyond in case there is no such line.
+ *
+ * \returns
+ *     True on success, false if the list could not be read.
+ *
+ * \throws Search::UnsortedException
+ *     The probed strings contradict the expected order.
+ */
+template <typename Pred>
+static bool find_first(ProbeCache &probes, unsigned int first,
+                       unsigned int beyond, const Pred &pred,
+                       unsigned int &found)
+{
+    const unsigned int range_first = first;
+    const unsigned int range_beyond = beyond;
+    const auto &strings(probes.get_strings());
 
-        if(CompareTraits::want_top_most_boundary())
+    while(true)
+    {
+        for(auto it = strings.lower_bound(first);
+            it != strings.end() && it->first < beyond;
+            ++it)
         {
-            if(CompareTraits::is_utf8_character_greater(ch, utf8_key_))
+            if(pred(it->second))
             {
-                if(lower_.top_ < p.center_)
-                    lower_.pick_bottom_half(0);
+                beyond = it->first;
+                break;
             }
-            else if(lower_.bottom_ > p.center_)
-                lower_.pick_top_half(0);
-        }
-
-        if(CompareTraits::is_utf8_character_greater(utf8_key_, ch))
-        {
-            /* center string is greater than or equal to partition key */
-            msg_vinfo(MESSAGE_LEVEL_DEBUG, "BSEARCH: pick top half");
 
-            return p.pick_top_half(0);
+            first = it->first + 1;
         }
-        else
-        {
-            /* center string is smaller than or equal to partition key */
-            msg_vinfo(MESSAGE_LEVEL_DEBUG, "BSEARCH: pick bottom half");
 
-            if(CompareTraits::want_top_most_boundary())
-            {
-                if(utf8_key_ < ch)
-                    lower_.top_ = p.center_;
-            }
+        if(first >= beyond)
+            break;
 
-            return p.pick_bottom_half(0);
-        }
+        if(!probes.fetch(first, beyond))
+            return false;
     }
 
-    void dump_state(const char *what, bool is_upper) const throw()
+    for(auto it = strings.lower_bound(range_first);
+        it != strings.end() && it->first < range_beyond;
+        ++it)
     {
-        if(!msg_is_verbose(MESSAGE_LEVEL_DEBUG))
-            return;
-
-        const char *const upper_lower(is_upper ? "UPPER" : "LOWER");
-
-        msg_info("BSEARCH %s %s: Upper partition [%u, %u], center %u",
-                 upper_lower, what, upper_.top_,
-                 upper_.bottom_, upper_.center_);
-        msg_info("BSEARCH %s %s: Lower partition [%u, %u], center %u",
-                 upper_lower, what,
-                 lower_.top_, lower_.bottom_, lower_.center_);
+        if(pred(it->second) != (it->first >= first))
+            throw Search::UnsortedException();
     }
-};
+
+    found = first;
+    return true;
+}
 
 ssize_t Search::binary_search_utf8(List::DBusList &list, const std::string &query)
 {
@@ -560,59 +265,59 @@ ssize_t Search::binary_search_utf8(List::DBusList &list, const std::string &quer
     if(list.empty())
         return -1;
 
-    Needle needle(query.c_str(), query.size());
-
-    const char *next_utf8_char = needle.next_utf8_char();
+    const Search::Key needle(query.c_str(), query.size());
 
-    if(next_utf8_char == nullptr)
+    if(needle.empty())
     {
         MSG_BUG("Expected at least one UTF-8 character");
         return -1;
     }
 
-    BSearchState state(list, list.get_number_of_items());
-    BSearchState::Result result = BSearchState::Result::INTERNAL_FAILURE;
-    ComparedString temp_string;
-
-    while(next_utf8_char != nullptr)
-    {
-        const char *const utf8_char = next_utf8_char;
-        next_utf8_char = needle.next_utf8_char();
-
-        state.prepare_next_iteration(utf8_char);
-        result = state.bsearch_top_most(list, temp_string);
+    ProbeCache probes(list);
 
-        msg_vinfo(MESSAGE_LEVEL_DEBUG, "Top-most result: %d",
-                  static_cast<int>(result));
+    /* lines in [top, bottom) match the query up to depth, so within this
+     * partition they are sorted by their character at depth */
+    unsigned int top = 0;
+    unsigned int bottom = list.get_number_of_items();
+    ssize_t result = -1;
 
-        msg_log_assert(result == BSearchState::Result::FOUND_MATCH ||
-                       result == BSearchState::Result::FOUND_APPROXIMATE ||
-                       result == BSearchState::Result::INTERNAL_FAILURE);
-
-        if(result == BSearchState::Result::INTERNAL_FAILURE)
-            return -1;
+    for(size_t depth = 0; depth < needle.length(); ++depth)
+    {
+        const gunichar key = needle.codepoints()[depth];
+        unsigned int first;
 
-        if(result == BSearchState::Result::FOUND_APPROXIMATE)
+        if(!find_first(probes, top, bottom,
+                       [key, depth] (const Search::Key &s)
+                       { return char_at_depth(s, depth) >= key; },
+                       first))
             break;
 
-        if(next_utf8_char != nullptr)
+        if(first == bottom)
         {
-            result = state.bsearch_bottom_most(list, temp_string);
-
-            msg_vinfo(MESSAGE_LEVEL_DEBUG, "Bottom-most result: %d",
-                      static_cast<int>(result));
+            /* all lines in partition are smaller than query */
+            result = bottom - 1;
+            break;
+        }
 
-            msg_log_assert(result == BSearchState::Result::FOUND_MATCH ||
-                           result == BSearchState::Result::INTERNAL_FAILURE);
+        if(char_at_depth(probes.get_strings().at(first), depth) != key ||
+           depth + 1 == needle.length())
+        {
+            result = first;
+            break;
+        }
 
-            if(result == BSearchState::Result::INTERNAL_FAILURE)
-                return -1;
+        if(!find_first(probes, first, bottom,
+                       [key, depth] (const Search::Key &s)
+                       { return char_at_depth(s, depth) > key; },
+                       bottom))
+            break;
 
-            state.prepare_for_next_character();
-        }
+        top = first;
     }
 
-    return ((result != BSearchState::Result::INTERNAL_FAILURE)
-            ? state.get_result()
-            : -1);
+    msg_vinfo(MESSAGE_LEVEL_DEBUG,
+              "Search for \"%s\" took %zu rounds of list fetches",
+              query.c_str(), probes.get_number_of_rounds());
+
+    return result;
 }
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#ifndef SEARCH_KEY_HH
+#define SEARCH_KEY_HH
+
+#include "messages.h"
+
+#include <glib.h>
+#include <string>
+#include <vector>
+#include <cstring>
+
+namespace Search
+{
+
+/*!
+ * String converted for case-insensitive comparison.
+ *
+ * Only the Unicode code points of the casefolded string are stored so that
+ * each character can be accessed in constant time, and so that a key costs
+ * a single allocation. Objects of this class are meant to be computed once
+ * per list item and reused by all searches.
+ */
+class Key
+{
+  private:
+    std::vector<gunichar> codepoints_;
+
+  public:
+    Key(const Key &) = default;
+    Key(Key &&) = default;
+    Key &operator=(const Key &) = default;
+    Key &operator=(Key &&) = default;
+
+    explicit Key() {}
+
+    explicit Key(const char *string) { set(string); }
+
+    explicit Key(const char *string, size_t number_of_bytes)
+    {
+        set(string, number_of_bytes);
+    }
+
+    void set(const char *string)
+    {
+        if(string != nullptr)
+            set(string, strlen(string));
+        else
+            clear();
+    }
+
+    void set(const char *string, size_t number_of_bytes)
+    {
+        clear();
+
+        if(string == nullptr || number_of_bytes == 0)
+            return;
+
+        gchar *folded = g_utf8_casefold(string, number_of_bytes);
+
+        if(folded == nullptr)
+            return;
+
+        glong len = 0;
+        gunichar *ucs4 = g_utf8_to_ucs4_fast(folded, -1, &len);
+
+        if(len > 0)
+            codepoints_.assign(ucs4, ucs4 + len);
+
+        g_free(ucs4);
+        g_free(folded);
+    }
+
+    void clear() { codepoints_.clear(); }
+
+    bool empty() const { return codepoints_.empty(); }
+
+    /*!
+     * Number of Unicode characters in casefolded string.
+     */
+    size_t length() const { return codepoints_.size(); }
+
+    /*!
+     * Unicode code points of casefolded string.
+     */
+    const gunichar *codepoints() const { return codepoints_.data(); }
+
+    /*!
+     * Character at given index.
+     *
+     * The end of the string may be accessed as well, it reads as a
+     * terminating NUL character like in a C string.
+     */
+    gunichar get_char_at(size_t idx) const
+    {
+        msg_log_assert(idx <= codepoints_.size());
+        return idx < codepoints_.size() ? codepoints_[idx] : 0;
+    }
+
+    /*!
+     * Casefolded string, UTF-8 encoded (for diagnostics).
+     */
+    std::string to_utf8() const
+    {
+        std::string result;
+        gchar buffer[6];
+
+        for(const auto &ch : codepoints_)
+            result.append(buffer, g_unichar_to_utf8(ch, buffer));
+
+        return result;
+    }
+};
+
+}
+
+#endif /* !SEARCH_KEY_HH */
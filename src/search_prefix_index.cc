@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "search_prefix_index.hh"
+
+#include <algorithm>
+
+static constexpr uint8_t UNKNOWN_LINE = UINT8_MAX;
+
+Search::PrefixIndex::PrefixIndex(size_t prefix_length, unsigned int max_lines):
+    prefix_length_(std::min(prefix_length, size_t(UNKNOWN_LINE - 1))),
+    max_lines_(max_lines),
+    number_of_lines_(0),
+    number_of_known_lines_(0),
+    sortedness_(Sortedness::UNKNOWN)
+{
+    LoggedLock::configure(lock_, "PrefixIndex", MESSAGE_LEVEL_DEBUG);
+}
+
+void Search::PrefixIndex::reset(ID::List list_id, unsigned int number_of_lines)
+{
+    list_id_ = list_id;
+    number_of_lines_ = number_of_lines;
+    number_of_known_lines_ = 0;
+    sortedness_ = Sortedness::UNKNOWN;
+
+    if(number_of_lines <= max_lines_)
+    {
+        prefixes_.assign(size_t(number_of_lines) * prefix_length_, 0);
+        lengths_.assign(number_of_lines, UNKNOWN_LINE);
+    }
+    else
+    {
+        prefixes_.clear();
+        prefixes_.shrink_to_fit();
+        lengths_.clear();
+        lengths_.shrink_to_fit();
+    }
+}
+
+void Search::PrefixIndex::put(ID::List list_id, unsigned int number_of_lines,
+                              unsigned int line,
+                              const uint32_t *codepoints, size_t count)
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    if(list_id != list_id_ || number_of_lines != number_of_lines_)
+        reset(list_id, number_of_lines);
+
+    if(line >= lengths_.size() || lengths_[line] != UNKNOWN_LINE)
+        return;
+
+    const size_t n = std::min(count, prefix_length_);
+
+    std::copy(codepoints, codepoints + n,
+              prefixes_.begin() + size_t(line) * prefix_length_);
+    lengths_[line] = n;
+    ++number_of_known_lines_;
+}
+
+int Search::PrefixIndex::compare(unsigned int line, const uint32_t *query,
+                                 size_t query_length) const
+{
+    const uint32_t *const prefix = &prefixes_[size_t(line) * prefix_length_];
+    const size_t length = lengths_[line];
+
+    for(size_t i = 0; i < length && i < query_length; ++i)
+    {
+        if(prefix[i] < query[i])
+            return -1;
+
+        if(prefix[i] > query[i])
+            return 1;
+    }
+
+    /* a proper prefix is smaller than the whole string */
+    if(length < query_length)
+        return -1;
+
+    return 0;
+}
+
+uint32_t Search::PrefixIndex::char_at(unsigned int line, size_t idx) const
+{
+    /* the end of the string reads as NUL character, see #Search::Key */
+    return idx < lengths_[line] ? prefixes_[size_t(line) * prefix_length_ + idx] : 0;
+}
+
+bool Search::PrefixIndex::compute_is_sorted() const
+{
+    for(unsigned int line = 1; line < number_of_lines_; ++line)
+        if(compare(line, &prefixes_[size_t(line - 1) * prefix_length_],
+                   lengths_[line - 1]) < 0)
+            return false;
+
+    return true;
+}
+
+Search::PrefixIndex::LookupResult
+Search::PrefixIndex::lookup(ID::List list_id, unsigned int number_of_lines,
+                            const uint32_t *query, size_t query_length,
+                            ssize_t &line) const
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    if(list_id != list_id_ || number_of_lines != number_of_lines_ ||
+       number_of_lines_ == 0 || lengths_.empty())
+        return LookupResult::NOT_INDEXED;
+
+    if(number_of_known_lines_ < number_of_lines_)
+        return LookupResult::INCOMPLETE;
+
+    if(query_length > prefix_length_)
+        return LookupResult::QUERY_TOO_LONG;
+
+    if(sortedness_ == Sortedness::UNKNOWN)
+        sortedness_ = compute_is_sorted() ? Sortedness::SORTED : Sortedness::UNSORTED;
+
+    if(sortedness_ == Sortedness::UNSORTED)
+        return LookupResult::UNSORTED;
+
+    /* lines in [top, bottom) match the query up to depth, so within this
+     * partition they are sorted by their character at depth */
+    unsigned int top = 0;
+    unsigned int bottom = number_of_lines_;
+
+    for(size_t depth = 0; depth < query_length; ++depth)
+    {
+        const uint32_t key = query[depth];
+        unsigned int first = top;
+        unsigned int beyond = bottom;
+
+        while(first < beyond)
+        {
+            const unsigned int center = first + (beyond - first) / 2;
+
+            if(char_at(center, depth) < key)
+                first = center + 1;
+            else
+                beyond = center;
+        }
+
+        if(first == bottom)
+        {
+            /* all lines in partition are smaller than query */
+            line = bottom - 1;
+            return LookupResult::FOUND;
+        }
+
+        if(char_at(first, depth) != key || depth + 1 == query_length)
+        {
+            line = first;
+            return LookupResult::FOUND;
+        }
+
+        beyond = bottom;
+        top = first;
+
+        while(first < beyond)
+        {
+            const unsigned int center = first + (beyond - first) / 2;
+
+            if(char_at(center, depth) <= key)
+                first = center + 1;
+            else
+                beyond = center;
+        }
+
+        bottom = first;
+    }
+
+    /* empty query, cannot be answered by the index */
+    return LookupResult::NOT_INDEXED;
+}
+
+void Search::PrefixIndex::rekey(ID::List old_id, ID::List new_id)
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    if(list_id_ == old_id)
+        list_id_ = new_id;
+}
+
+void Search::PrefixIndex::forget_list(ID::List list_id)
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+
+    if(list_id_ == list_id)
+        reset(ID::List(), 0);
+}
+
+unsigned int Search::PrefixIndex::get_number_of_known_lines() const
+{
+    LOGGED_LOCK_CONTEXT_HINT;
+    std::lock_guard<LoggedLock::Mutex> lk(lock_);
+    return number_of_known_lines_;
+}
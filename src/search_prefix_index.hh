@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#ifndef SEARCH_PREFIX_INDEX_HH
+#define SEARCH_PREFIX_INDEX_HH
+
+#include "idtypes.hh"
+#include "logged_lock.hh"
+
+#include <vector>
+#include <cstdint>
+#include <sys/types.h>
+
+namespace Search
+{
+
+/*!
+ * Local index of casefolded prefixes of all lines in a sorted list.
+ *
+ * The index stores the first few Unicode code points of the casefolded text
+ * of each line of a single list. It is filled incrementally as list ranges
+ * are received from the list broker. As soon as all lines of the list are
+ * known, jump-to queries not longer than the stored prefixes can be answered
+ * locally by bisection over the index, without any D-Bus traffic.
+ *
+ * The index does not replace #Search::binary_search_utf8(). Client code
+ * should fall back to it whenever #Search::PrefixIndex::lookup() does not
+ * return #Search::PrefixIndex::LookupResult::FOUND.
+ *
+ * This class is thread-safe.
+ */
+class PrefixIndex
+{
+  public:
+    /*!
+     * Default number of code points stored per line.
+     */
+    static constexpr size_t DEFAULT_PREFIX_LENGTH = 4;
+
+    /*!
+     * Default maximum number of lines a list may have to be indexed.
+     */
+    static constexpr unsigned int DEFAULT_MAX_LINES = 65536;
+
+    enum class LookupResult
+    {
+        FOUND,
+        NOT_INDEXED,
+        INCOMPLETE,
+        QUERY_TOO_LONG,
+        UNSORTED,
+    };
+
+  private:
+    mutable LoggedLock::Mutex lock_;
+
+    const size_t prefix_length_;
+    const unsigned int max_lines_;
+
+    ID::List list_id_;
+    unsigned int number_of_lines_;
+    unsigned int number_of_known_lines_;
+
+    /*!
+     * Code points, #Search::PrefixIndex::prefix_length_ entries per line.
+     */
+    std::vector<uint32_t> prefixes_;
+
+    /*!
+     * Number of valid code points per line, or \c UINT8_MAX if unknown.
+     */
+    std::vector<uint8_t> lengths_;
+
+    enum class Sortedness
+    {
+        UNKNOWN,
+        SORTED,
+        UNSORTED,
+    };
+
+    mutable Sortedness sortedness_;
+
+  public:
+    PrefixIndex(const PrefixIndex &) = delete;
+    PrefixIndex(PrefixIndex &&) = delete;
+    PrefixIndex &operator=(const PrefixIndex &) = delete;
+    PrefixIndex &operator=(PrefixIndex &&) = delete;
+
+    explicit PrefixIndex(size_t prefix_length = DEFAULT_PREFIX_LENGTH,
+                         unsigned int max_lines = DEFAULT_MAX_LINES);
+
+    /*!
+     * Store casefolded prefix of a line.
+     *
+     * The index is reset if \p list_id or \p number_of_lines differ from the
+     * list currently indexed.
+     *
+     * \param list_id, number_of_lines
+     *     The list the line belongs to, and its total number of lines.
+     *
+     * \param line
+     *     The line number.
+     *
+     * \param codepoints, count
+     *     The Unicode code points of the casefolded line text. Only the first
+     *     few code points are stored.
+     */
+    void put(ID::List list_id, unsigned int number_of_lines, unsigned int line,
+             const uint32_t *codepoints, size_t count);
+
+    /*!
+     * Find line for a jump-to query the same way as
+     * #Search::binary_search_utf8() does.
+     *
+     * The query is processed character by character. For each character,
+     * the partition of lines matching the query so far is narrowed down to
+     * the lines which have that character at the current position. The first
+     * line in the partition with a greater character is returned in case
+     * there is no such line. The last line of the partition is returned in
+     * case all lines in the partition have smaller characters. So unlike a
+     * plain lower bound, the result never leaves the partition matched so
+     * far.
+     *
+     * \param list_id, number_of_lines
+     *     The list to search in, and its total number of lines.
+     *
+     * \param query, query_length
+     *     The Unicode code points of the casefolded search string.
+     *
+     * \param[out] line
+     *     The found line. Only set if #LookupResult::FOUND is returned.
+     *
+     * \retval #Search::PrefixIndex::LookupResult::FOUND
+     *     The query has been answered locally.
+     * \retval #Search::PrefixIndex::LookupResult::NOT_INDEXED
+     *     The index is filled for another list, or the list is too long.
+     * \retval #Search::PrefixIndex::LookupResult::INCOMPLETE
+     *     Not all lines of the list are known yet.
+     * \retval #Search::PrefixIndex::LookupResult::QUERY_TOO_LONG
+     *     The query is longer than the prefixes stored in the index.
+     * \retval #Search::PrefixIndex::LookupResult::UNSORTED
+     *     The indexed list is not sorted.
+     */
+    LookupResult lookup(ID::List list_id, unsigned int number_of_lines,
+                        const uint32_t *query, size_t query_length,
+                        ssize_t &line) const;
+
+    /*!
+     * The list has been replaced by a list with identical content.
+     */
+    void rekey(ID::List old_id, ID::List new_id);
+
+    /*!
+     * Remove all entries stored for given list.
+     */
+    void forget_list(ID::List list_id);
+
+    /*!
+     * Number of lines of the indexed list which are known.
+     */
+    unsigned int get_number_of_known_lines() const;
+
+  private:
+    void reset(ID::List list_id, unsigned int number_of_lines);
+    int compare(unsigned int line, const uint32_t *query, size_t query_length) const;
+    uint32_t char_at(unsigned int line, size_t idx) const;
+    bool compute_is_sorted() const;
+};
+
+}
+
+#endif /* !SEARCH_PREFIX_INDEX_HH */
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#ifndef SHUFFLE_PERMUTATION_HH
+#define SHUFFLE_PERMUTATION_HH
+
+#include <cstdint>
+
+namespace Playlist
+{
+
+namespace Crawler
+{
+
+/*!
+ * Seeded pseudo-random permutation of the numbers 0 to N - 1.
+ *
+ * The permutation is computed on the fly by a small Feistel network over the
+ * smallest power of 4 not smaller than N, restricted to the domain by cycle
+ * walking. It is fully determined by N and the seed, requires constant memory
+ * regardless of N, and can be inverted. The latter is required to find the
+ * position of a given element in the shuffled sequence, e.g., to continue
+ * shuffled playback from a line selected by the user.
+ */
+class ShufflePermutation
+{
+  private:
+    static constexpr unsigned int ROUNDS = 4;
+
+    uint32_t size_;
+    uint64_t seed_;
+    unsigned int half_bits_;
+    uint64_t half_mask_;
+
+  public:
+    explicit ShufflePermutation(uint32_t size, uint64_t seed):
+        size_(size),
+        seed_(seed),
+        half_bits_(1)
+    {
+        while((uint64_t(1) << (2 * half_bits_)) < size_)
+            ++half_bits_;
+
+        half_mask_ = (uint64_t(1) << half_bits_) - 1;
+    }
+
+    uint32_t size() const { return size_; }
+
+    /*!
+     * Element at given position of the shuffled sequence.
+     */
+    uint32_t operator()(uint32_t position) const
+    {
+        if(position >= size_)
+            return position;
+
+        uint64_t x = position;
+
+        do
+            x = encrypt(x);
+        while(x >= size_);
+
+        return x;
+    }
+
+    /*!
+     * Position of given element in the shuffled sequence.
+     */
+    uint32_t inverse(uint32_t element) const
+    {
+        if(element >= size_)
+            return element;
+
+        uint64_t x = element;
+
+        do
+            x = decrypt(x);
+        while(x >= size_);
+
+        return x;
+    }
+
+    /*!
+     * Derive seed for a nested permutation from a seed and some value.
+     */
+    static uint64_t derive_seed(uint64_t seed, uint64_t value)
+    {
+        return mix(seed ^ mix(value + UINT64_C(0x9e3779b97f4a7c15)));
+    }
+
+  private:
+    static uint64_t mix(uint64_t x)
+    {
+        x = (x ^ (x >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+        x = (x ^ (x >> 27)) * UINT64_C(0x94d049bb133111eb);
+        return x ^ (x >> 31);
+    }
+
+    uint64_t round_function(unsigned int round, uint64_t half) const
+    {
+        return mix(seed_ + (uint64_t(round) << 56) + half) & half_mask_;
+    }
+
+    uint64_t encrypt(uint64_t x) const
+    {
+        uint64_t left = x >> half_bits_;
+        uint64_t right = x & half_mask_;
+
+        for(unsigned int r = 0; r < ROUNDS; ++r)
+        {
+            const uint64_t temp = left ^ round_function(r, right);
+            left = right;
+            right = temp;
+        }
+
+        return (left << half_bits_) | right;
+    }
+
+    uint64_t decrypt(uint64_t x) const
+    {
+        uint64_t left = x >> half_bits_;
+        uint64_t right = x & half_mask_;
+
+        for(unsigned int r = ROUNDS; r-- > 0;)
+        {
+            const uint64_t temp = right ^ round_function(r, left);
+            right = left;
+            left = temp;
+        }
+
+        return (left << half_bits_) | right;
+    }
+};
+
+}
+
+}
+
+#endif /* !SHUFFLE_PERMUTATION_HH */
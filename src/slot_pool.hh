@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#ifndef SLOT_POOL_HH
+#define SLOT_POOL_HH
+
+#include <vector>
+#include <memory>
+#include <new>
+
+/*!
+ * Memory slots of fixed sizes which are reused after deallocation.
+ *
+ * Deallocated slots are not returned to the system, but kept in a free list
+ * per slot size and handed out again by the next allocation of the same size.
+ * This avoids repeated heap allocations for node-based containers which
+ * insert and erase elements at a steady rate.
+ *
+ * All slots must have been deallocated before the pool is destroyed. This
+ * class is not thread-safe.
+ */
+class SlotPool
+{
+  private:
+    struct FreeSlot
+    {
+        FreeSlot *next_;
+    };
+
+    struct SizeClass
+    {
+        size_t size_;
+        FreeSlot *free_;
+
+        explicit SizeClass(size_t size):
+            size_(size),
+            free_(nullptr)
+        {}
+    };
+
+    std::vector<SizeClass> classes_;
+
+  public:
+    SlotPool(const SlotPool &) = delete;
+    SlotPool(SlotPool &&) = delete;
+    SlotPool &operator=(const SlotPool &) = delete;
+    SlotPool &operator=(SlotPool &&) = delete;
+
+    explicit SlotPool() {}
+
+    ~SlotPool()
+    {
+        for(auto &c : classes_)
+        {
+            while(c.free_ != nullptr)
+            {
+                FreeSlot *slot = c.free_;
+                c.free_ = slot->next_;
+                ::operator delete(slot);
+            }
+        }
+    }
+
+    void *allocate(size_t size)
+    {
+        auto &c(get_size_class(size));
+
+        if(c.free_ == nullptr)
+            return ::operator new(c.size_);
+
+        FreeSlot *slot = c.free_;
+        c.free_ = slot->next_;
+        return slot;
+    }
+
+    void deallocate(void *p, size_t size)
+    {
+        auto &c(get_size_class(size));
+        FreeSlot *slot = static_cast<FreeSlot *>(p);
+        slot->next_ = c.free_;
+        c.free_ = slot;
+    }
+
+    /*!
+     * Number of deallocated slots available for reuse.
+     */
+    size_t get_number_of_free_slots() const
+    {
+        size_t result = 0;
+
+        for(const auto &c : classes_)
+            for(const FreeSlot *slot = c.free_; slot != nullptr; slot = slot->next_)
+                ++result;
+
+        return result;
+    }
+
+  private:
+    SizeClass &get_size_class(size_t size)
+    {
+        if(size < sizeof(FreeSlot))
+            size = sizeof(FreeSlot);
+
+        /* there are only as many classes as there are node types using the
+         * pool, so linear search is fine */
+        for(auto &c : classes_)
+            if(c.size_ == size)
+                return c;
+
+        classes_.emplace_back(size);
+        return classes_.back();
+    }
+};
+
+/*!
+ * Allocator for node-based standard containers which takes nodes from a
+ * #SlotPool.
+ *
+ * Only single-element allocations are served from the pool, anything else is
+ * passed on to \c std::allocator.
+ */
+template <typename T>
+class SlotAllocator
+{
+  public:
+    using value_type = T;
+
+  private:
+    template <typename U> friend class SlotAllocator;
+
+    SlotPool *pool_;
+
+  public:
+    explicit SlotAllocator(SlotPool &pool): pool_(&pool) {}
+
+    template <typename U>
+    SlotAllocator(const SlotAllocator<U> &other): pool_(other.pool_) {}
+
+    T *allocate(size_t n)
+    {
+        if(n == 1)
+            return static_cast<T *>(pool_->allocate(sizeof(T)));
+
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *p, size_t n)
+    {
+        if(n == 1)
+            pool_->deallocate(p, sizeof(T));
+        else
+            std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const SlotAllocator<U> &other) const
+    {
+        return pool_ == other.pool_;
+    }
+
+    template <typename U>
+    bool operator!=(const SlotAllocator<U> &other) const
+    {
+        return pool_ != other.pool_;
+    }
+};
+
+#endif /* !SLOT_POOL_HH */
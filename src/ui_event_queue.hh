@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016, 2017, 2019, 2020, 2022  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2016, 2017, 2019, 2020, 2022, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -28,149 +28,295 @@
 
 #include <functional>
 #include <deque>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <sys/types.h>
 
 namespace UI
 {
 
-namespace Events
-{
-
-class BaseEvent
-{
-  protected:
-    explicit BaseEvent() {}
-
-  public:
-    BaseEvent(const BaseEvent &) = delete;
-    BaseEvent &operator=(const BaseEvent &) = delete;
-
-    virtual ~BaseEvent() {}
-};
-
-class ViewInput: public BaseEvent
+/*!
+ * Queue of UI events, filled from any thread, drained in main context.
+ *
+ * Events are stored in a bounded ring buffer of preallocated, fixed-size
+ * slots, so that posting an event neither takes a lock nor allocates memory
+ * for the event itself. Any number of threads may post events, but only a
+ * single thread may take them out (this is the multi-producer,
+ * single-consumer ring buffer described by Dmitry Vyukov).
+ *
+ * In the unlikely case the ring buffer is full, events are put into an
+ * overflow list protected by a lock. This happens, for instance, if the main
+ * thread itself posts many events while processing events. Ordering of
+ * events posted by a single thread is maintained in this case, too.
+ *
+ * The trigger function passed to the constructor is called whenever an event
+ * is posted to a queue which has been drained completely before.
+ */
+class EventQueue
 {
   public:
-    const ViewEventID event_id_;
-    std::unique_ptr<UI::Parameters> parameters_;
-
-    ViewInput(const ViewInput &) = delete;
-    ViewInput &operator=(const ViewInput &) = delete;
-
-    explicit ViewInput(EventID event_id,
-                       std::unique_ptr<UI::Parameters> parameters):
-        event_id_(to_event_type<ViewEventID>(event_id)),
-        parameters_(std::move(parameters))
-    {}
-};
+    /*!
+     * Default number of events the ring buffer can store.
+     */
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+    /*!
+     * A single UI event, as stored in the queue.
+     */
+    struct Event
+    {
+        EventID event_id_;
+        std::unique_ptr<UI::Parameters> parameters_;
 
-class Broadcast: public BaseEvent
-{
-  public:
-    const BroadcastEventID event_id_;
-    std::unique_ptr<UI::Parameters> parameters_;
+        Event(const Event &) = delete;
+        Event(Event &&) = default;
+        Event &operator=(const Event &) = delete;
+        Event &operator=(Event &&) = default;
 
-    Broadcast(const Broadcast &) = delete;
-    Broadcast &operator=(const Broadcast &) = delete;
+        explicit Event(): event_id_(EventID::NOP) {}
 
-    explicit Broadcast(EventID event_id,
+        explicit Event(EventID event_id,
                        std::unique_ptr<UI::Parameters> parameters):
-        event_id_(to_event_type<BroadcastEventID>(event_id)),
-        parameters_(std::move(parameters))
-    {}
-};
-
-class ViewMan: public BaseEvent
-{
-  public:
-    const VManEventID event_id_;
-    std::unique_ptr<UI::Parameters> parameters_;
-
-    ViewMan(const ViewMan &) = delete;
-    ViewMan &operator=(const ViewMan &) = delete;
+            event_id_(event_id),
+            parameters_(std::move(parameters))
+        {}
+    };
 
-    explicit ViewMan(EventID event_id,
-                     std::unique_ptr<UI::Parameters> parameters):
-        event_id_(to_event_type<VManEventID>(event_id)),
-        parameters_(std::move(parameters))
-    {}
-};
+  private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence_;
+        Event event_;
+    };
 
-/*
-ActivateView
+    const std::function<void()> trigger_processing_fn_;
 
-ToggleViews
+    const size_t mask_;
+    std::vector<Slot> slots_;
 
-PutSearchParameters
+    alignas(64) std::atomic<size_t> enqueue_pos_;
+    alignas(64) size_t dequeue_pos_;
 
-MoveCursorByLine
+    /*!
+     * Number of posted events which have not been taken yet.
+     *
+     * The counter is decremented before an event is processed, but may be
+     * incremented by the poster after the event has been taken already.
+     * Therefore, it may become negative for short periods of time.
+     */
+    std::atomic<long> pending_;
 
-MoveCursorByPage
+    LoggedLock::Mutex overflow_lock_;
+    std::atomic<bool> is_overflowing_;
+    std::deque<Event> overflow_;
 
-InvalidateList
+  public:
+    EventQueue(const EventQueue &) = delete;
+    EventQueue &operator=(const EventQueue &) = delete;
 
-PutMetaData
+    explicit EventQueue(const std::function<void()> &trigger_processing_fn,
+                        size_t capacity = DEFAULT_CAPACITY):
+        trigger_processing_fn_(trigger_processing_fn),
+        mask_(round_up_to_power_of_2(capacity) - 1),
+        slots_(mask_ + 1),
+        enqueue_pos_(0),
+        dequeue_pos_(0),
+        pending_(0),
+        is_overflowing_(false)
+    {
+        LoggedLock::configure(overflow_lock_, "UIEventQueue", MESSAGE_LEVEL_DEBUG);
 
-StreamStarted
+        for(size_t i = 0; i < slots_.size(); ++i)
+            slots_[i].sequence_.store(i, std::memory_order_relaxed);
+    }
 
-StreamStopped
+    size_t get_capacity() const { return slots_.size(); }
 
-StreamPaused
+    void post(EventID event_id, std::unique_ptr<UI::Parameters> parameters)
+    {
+        if(is_overflowing_.load(std::memory_order_acquire) ||
+           !try_put_into_ring(event_id, parameters))
+        {
+            LOGGED_LOCK_CONTEXT_HINT;
+            std::lock_guard<LoggedLock::Mutex> lock(overflow_lock_);
+            overflow_.emplace_back(event_id, std::move(parameters));
+            is_overflowing_.store(true, std::memory_order_release);
+        }
 
-PutStreamPosition
+        if(pending_.fetch_add(1, std::memory_order_acq_rel) == 0)
+            trigger_processing_fn_();
+    }
 
-PutServiceLoginStatus
-*/
+    /*!
+     * Take out all events, pass them to \p fn in order.
+     *
+     * Events posted while this function is running, including those posted
+     * by \p fn, are processed by this function as well. The function returns
+     * when the queue has been observed empty.
+     *
+     * Must be called from the consumer thread only.
+     *
+     * \returns
+     *     Number of events passed to \p fn.
+     */
+    template <typename F>
+    size_t take_all(const F &fn)
+    {
+        return take_all(fn, [] (const Event &, Event &) { return false; });
+    }
 
-}
+    /*!
+     * Take out all events, merge consecutive events, pass them to \p fn.
+     *
+     * Before an event is passed to \p fn, it is offered the event taken
+     * next by calling \p merge. If \p merge returns \c true, then the next
+     * event has been merged into the previous event and is dropped, and the
+     * merged event is offered the event after that. Otherwise, the previous
+     * event is passed to \p fn. This way, bursts of similar events such as
+     * scroll requests can be collapsed into a single event while maintaining
+     * their order relative to all other events.
+     *
+     * Events are never held back across calls of this function.
+     *
+     * \param fn
+     *     Function which processes an event.
+     *
+     * \param merge
+     *     Function which tries to merge its second parameter into its first
+     *     parameter.
+     *
+     * \returns
+     *     Number of events passed to \p fn.
+     */
+    template <typename F, typename M>
+    size_t take_all(const F &fn, const M &merge)
+    {
+        size_t total = 0;
+        Event held;
+        bool have_held = false;
+        Event ev;
+
+        const auto consume =
+            [&fn, &merge, &total, &held, &have_held] (Event &&next)
+            {
+                if(have_held)
+                {
+                    if(merge(held, next))
+                        return;
+
+                    ++total;
+                    fn(std::move(held));
+                }
+
+                held = std::move(next);
+                have_held = true;
+            };
+
+        while(true)
+        {
+            size_t count = 0;
+
+            while(try_take_from_ring(ev))
+            {
+                ++count;
+                pending_.fetch_sub(1, std::memory_order_acq_rel);
+                consume(std::move(ev));
+            }
+
+            if(is_overflowing_.load(std::memory_order_acquire))
+            {
+                std::deque<Event> overflow;
+
+                {
+                    LOGGED_LOCK_CONTEXT_HINT;
+                    std::lock_guard<LoggedLock::Mutex> lock(overflow_lock_);
+                    overflow_.swap(overflow);
+                    is_overflowing_.store(false, std::memory_order_release);
+                }
+
+                for(auto &oev : overflow)
+                {
+                    ++count;
+                    pending_.fetch_sub(1, std::memory_order_acq_rel);
+                    consume(std::move(oev));
+                }
+            }
+
+            if(have_held)
+            {
+                have_held = false;
+                ++total;
+                fn(std::move(held));
+                held.parameters_.reset();
+            }
+
+            if(count == 0)
+                return total;
+        }
+    }
 
-class EventQueue
-{
   private:
-    const std::function<void()> trigger_processing_fn_;
-
-    LoggedLock::Mutex lock_;
-    std::deque<std::unique_ptr<Events::BaseEvent>> queue_;
+    static size_t round_up_to_power_of_2(size_t n)
+    {
+        size_t result = 2;
 
-  public:
-    EventQueue(const EventQueue &) = delete;
-    EventQueue &operator=(const EventQueue &) = delete;
+        while(result < n)
+            result <<= 1;
 
-    explicit EventQueue(const std::function<void()> &trigger_processing_fn):
-        trigger_processing_fn_(trigger_processing_fn)
-    {
-        LoggedLock::configure(lock_, "UIEventQueue", MESSAGE_LEVEL_DEBUG);
+        return result;
     }
 
-    void post(std::unique_ptr<Events::BaseEvent> event)
+    bool try_put_into_ring(EventID event_id,
+                           std::unique_ptr<UI::Parameters> &parameters)
     {
-        msg_log_assert(event != nullptr);
-
-        bool need_trigger;
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Slot *slot;
 
+        while(true)
         {
-            LOGGED_LOCK_CONTEXT_HINT;
-            std::lock_guard<LoggedLock::Mutex> lock(lock_);
-
-            need_trigger = queue_.empty();
-            queue_.emplace_back(std::move(event));
+            slot = &slots_[pos & mask_];
+            const size_t seq = slot->sequence_.load(std::memory_order_acquire);
+            const auto diff = static_cast<ssize_t>(seq) - static_cast<ssize_t>(pos);
+
+            if(diff == 0)
+            {
+                if(enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                      std::memory_order_relaxed))
+                    break;
+            }
+            else if(diff < 0)
+                return false;
+            else
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
         }
 
-        if(need_trigger)
-            trigger_processing_fn_();
+        slot->event_.event_id_ = event_id;
+        slot->event_.parameters_ = std::move(parameters);
+        slot->sequence_.store(pos + 1, std::memory_order_release);
+
+        return true;
     }
 
-    std::unique_ptr<Events::BaseEvent> take()
+    bool try_take_from_ring(Event &ev)
     {
-        LOGGED_LOCK_CONTEXT_HINT;
-        std::lock_guard<LoggedLock::Mutex> lock(lock_);
+        Slot &slot(slots_[dequeue_pos_ & mask_]);
+
+        while(slot.sequence_.load(std::memory_order_acquire) != dequeue_pos_ + 1)
+        {
+            if(enqueue_pos_.load(std::memory_order_acquire) == dequeue_pos_)
+                return false;
 
-        if(queue_.empty())
-            return nullptr;
+            /* slot has been claimed by a producer, but it has not finished
+             * filling it in yet */
+            std::this_thread::yield();
+        }
 
-        std::unique_ptr<Events::BaseEvent> ret = std::move(queue_.front());
-        queue_.pop_front();
+        ev = std::move(slot.event_);
+        slot.sequence_.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+        ++dequeue_pos_;
 
-        return ret;
+        return true;
     }
 };
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2016--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -31,7 +31,7 @@ static constexpr unsigned int EVENT_ID_MASK    = 0x0000ffff;
 static constexpr unsigned int EVENT_TYPE_SHIFT = 16U;
 
 /*!
- * Event types corresponding to specializations of #UI::Events::BaseEvent.
+ * Event types, used for routing events taken from #UI::EventQueue.
  *
  * For each event type there is an enumeration such as #UI::ViewEventID that
  * lists the events of that type. The combination of values of these
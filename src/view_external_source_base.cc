@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2017, 2019, 2021--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2017, 2019, 2021--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -62,6 +62,6 @@ bool ViewExternalSource::Base::write_xml(std::ostream &os, uint32_t bits,
                                          const DCP::Queue::Data &data,
                                          bool &busy_state_triggered)
 {
-    os << "<text id=\"line0\">" << XmlEscape(_(on_screen_name_)) << "</text>";
+    os << "<text id=\"line0\">" << get_escaped_on_screen_name() << "</text>";
     return true;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -35,6 +35,11 @@
 #include "ui_parameters_predefined.hh"
 #include "de_tahifi_lists_context.h"
 #include "rnfcall_get_location_trace.hh"
+#include "rnfcall_fetch_batch.hh"
+#include "render_trace.hh"
+#include "boot_timeline.hh"
+
+#include <sstream>
 
 ViewFileBrowser::FileItem
 ViewFileBrowser::FileItem::loading_placeholder_("", 0U,
@@ -59,13 +64,14 @@ void ViewFileBrowser::init_i18n()
 
 List::Item *ViewFileBrowser::construct_file_item(const char *name,
                                                  ListItemKind kind,
-                                                 const char *const *names)
+                                                 const char *const *names,
+                                                 const GVariantWrapper &page)
 {
     if(names == nullptr)
-        return new FileItem(name, 0, kind,
+        return new FileItem(page, name, 0, kind,
                             MetaData::PreloadedSet());
     else
-        return new FileItem(name, 0, kind,
+        return new FileItem(page, name, 0, kind,
                             MetaData::PreloadedSet(names[0], names[1], names[2]));
 }
 
@@ -120,8 +126,8 @@ bool ViewFileBrowser::View::handle_enter_list_event_finish(
       case List::QueryContextEnterList::CallerID::ENTER_CONTEXT_ROOT:
       case List::QueryContextEnterList::CallerID::ENTER_ANYWHERE:
       case List::QueryContextEnterList::CallerID::RELOAD_LIST:
-        current_list_id_ = finish_async_enter_dir_op(result, ctx, async_calls_,
-                                                     current_list_id_, *this);
+        set_current_list_id(finish_async_enter_dir_op(result, ctx, async_calls_,
+                                                      current_list_id_, *this));
 
         if((ctx->get_caller_id() == List::QueryContextEnterList::CallerID::ENTER_ROOT))
             root_list_id_ = current_list_id_;
@@ -276,6 +282,8 @@ bool ViewFileBrowser::View::init()
             status_string_for_empty_root_.clear();
         });
 
+    file_list_.enable_prefix_index();
+
     file_list_.register_enter_list_watcher(
         [this] (List::AsyncListIface::OpResult result,
                 std::shared_ptr<List::QueryContextEnterList> ctx)
@@ -323,7 +331,14 @@ bool ViewFileBrowser::View::late_init()
     if(play_view_ == nullptr)
         return false;
 
-    return sync_with_list_broker() && register_audio_sources();
+    {
+        BootTimeline::Phase phase("sync_with_list_broker", name_);
+
+        if(!sync_with_list_broker())
+            return false;
+    }
+
+    return register_audio_sources();
 }
 
 bool ViewFileBrowser::View::register_audio_sources()
@@ -423,26 +438,128 @@ static void fill_context_map_from_variant(List::ContextMap &context_map,
     }
 }
 
-bool ViewFileBrowser::View::sync_with_list_broker(bool is_first_call)
+static guint64 finish_keep_alive(GObject *source_object, GAsyncResult *res,
+                                 bool is_superseded, const char *what,
+                                 const char *error_message,
+                                 const char *view_name)
 {
-    GVariant *empty_list = g_variant_new("au", NULL);
-    guint64 expiry_ms;
-    GVariant *dummy = NULL;
+    guint64 expiry_ms = 0;
+    GVariant *unknown_ids_list = nullptr;
     GErrorWrapper error;
 
-    tdbus_lists_navigation_call_keep_alive_sync(file_list_.get_dbus_proxy(),
-                                                empty_list, &expiry_ms,
-                                                &dummy, NULL, error.await());
+    tdbus_lists_navigation_call_keep_alive_finish(TDBUS_LISTS_NAVIGATION(source_object),
+                                                  &expiry_ms, &unknown_ids_list,
+                                                  res, error.await());
+
+    if(is_superseded)
+    {
+        error.noticed();
+
+        if(unknown_ids_list != nullptr)
+            g_variant_unref(unknown_ids_list);
+
+        return 0;
+    }
 
-    if(error.log_failure("Keep alive on sync"))
+    if(error.log_failure(what))
     {
-        msg_error(0, LOG_ERR, "%s: Failed querying gc expiry time", name_);
-        expiry_ms = 0;
+        msg_error(0, LOG_ERR, "%s: %s", view_name, error_message);
+        return 0;
     }
-    else
-        g_variant_unref(dummy);
+
+    g_variant_unref(unknown_ids_list);
+
+    return expiry_ms;
+}
+
+void ViewFileBrowser::View::initial_keep_alive_done(GObject *source_object,
+                                                    GAsyncResult *res,
+                                                    gpointer user_data)
+{
+    std::unique_ptr<KeepAliveCall> call(static_cast<KeepAliveCall *>(user_data));
+    const guint64 expiry_ms =
+        finish_keep_alive(source_object, res, call->view_ == nullptr,
+                          "Keep alive on sync",
+                          "Failed querying gc expiry time",
+                          call->view_ != nullptr ? call->view_->name_ : nullptr);
+
+    if(call->view_ == nullptr)
+        return;
+
+    auto &view(*call->view_);
+
+    msg_log_assert(view.initial_keep_alive_call_ == call.get());
+    view.initial_keep_alive_call_ = nullptr;
+    view.restart_keep_lists_alive_timer(
+        compute_keep_alive_timeout(expiry_ms, 50, std::chrono::seconds(30)));
+}
+
+void ViewFileBrowser::View::periodic_keep_alive_done(GObject *source_object,
+                                                     GAsyncResult *res,
+                                                     gpointer user_data)
+{
+    std::unique_ptr<KeepAliveCall> call(static_cast<KeepAliveCall *>(user_data));
+    const guint64 expiry_ms =
+        finish_keep_alive(source_object, res, call->view_ == nullptr,
+                          "Periodic keep alive",
+                          "Failed sending keep alive",
+                          call->view_ != nullptr ? call->view_->name_ : nullptr);
+
+    if(call->view_ == nullptr)
+        return;
+
+    auto &view(*call->view_);
+
+    msg_log_assert(view.periodic_keep_alive_call_ == call.get());
+    view.periodic_keep_alive_call_ = nullptr;
+    view.restart_keep_lists_alive_timer(
+        compute_keep_alive_timeout(expiry_ms, 80, std::chrono::minutes(5)));
+}
+
+/*!
+ * Cancel keep-alive request in flight, if any, and forget about it.
+ *
+ * The request object is deleted by its reply handler.
+ */
+void ViewFileBrowser::View::cancel_keep_alive_call(KeepAliveCall *&call)
+{
+    if(call == nullptr)
+        return;
+
+    call->cancel();
+    call = nullptr;
+}
+
+void ViewFileBrowser::View::restart_keep_lists_alive_timer(std::chrono::milliseconds interval)
+{
+    if(interval == keep_lists_alive_interval_)
+        return;
+
+    keep_lists_alive_timeout_.stop();
+    keep_lists_alive_interval_ = interval;
+    keep_lists_alive_timeout_.start(
+            std::move(interval),
+            [this] () { return keep_lists_alive_timer_callback(); });
+}
+
+bool ViewFileBrowser::View::sync_with_list_broker(bool is_first_call)
+{
+    /* answers to requests sent before are meaningless now, the list broker
+     * has presumably been restarted */
+    cancel_keep_alive_call(initial_keep_alive_call_);
+    cancel_keep_alive_call(periodic_keep_alive_call_);
+
+    /* the expiry time is not known yet, so we'll start with some fallback
+     * value and restart the timer as soon as the list broker has answered */
+    initial_keep_alive_call_ = new KeepAliveCall(*this);
+    tdbus_lists_navigation_call_keep_alive(file_list_.get_dbus_proxy(),
+                                           g_variant_new("au", NULL),
+                                           initial_keep_alive_call_->cancellable_,
+                                           initial_keep_alive_done,
+                                           initial_keep_alive_call_);
 
     GVariant *out_contexts;
+    GErrorWrapper error;
 
     tdbus_lists_navigation_call_get_list_contexts_sync(file_list_.get_dbus_proxy(),
                                                        &out_contexts, NULL,
@@ -462,9 +579,10 @@ bool ViewFileBrowser::View::sync_with_list_broker(bool is_first_call)
     if(!is_first_call)
         keep_lists_alive_timeout_.stop();
 
+    keep_lists_alive_interval_ = std::chrono::seconds(30);
+
     return keep_lists_alive_timeout_.start(
-            compute_keep_alive_timeout(expiry_ms, 50,
-                                       std::chrono::seconds(30)),
+            std::chrono::milliseconds(keep_lists_alive_interval_),
             [this] () { return keep_lists_alive_timer_callback(); });
 }
 
@@ -628,10 +746,16 @@ bool ViewFileBrowser::View::point_to_item(const ViewIface &view,
         file_list_.mk_viewport(1, (std::string(name_) + " search").c_str());
     ssize_t found = -1;
 
+    const auto &query(search_parameters.get_query());
+
     try
     {
-        found = Search::binary_search_utf8(file_list_,
-                                           search_parameters.get_query());
+        if(file_list_.lookup_in_prefix_index(Search::Key(query.c_str(), query.size()),
+                                             found))
+            msg_vinfo(MESSAGE_LEVEL_DIAG,
+                      "%s: Answered search from local index", name_);
+        else
+            found = Search::binary_search_utf8(file_list_, query);
     }
     catch(const Search::UnsortedException &e)
     {
@@ -692,49 +816,76 @@ bool ViewFileBrowser::View::apply_search_parameters()
     return retval;
 }
 
-std::chrono::milliseconds ViewFileBrowser::View::keep_lists_alive_timer_callback()
+void ViewFileBrowser::View::update_keep_alive_list_ids(const List::ReferencedLists *player_lists)
 {
-    std::vector<ID::List> list_ids;
+    auto &cache(keep_alive_list_ids_);
 
-    if(current_list_id_.is_valid())
-        list_ids.push_back(current_list_id_);
+    if(cache.is_valid_ &&
+       cache.own_generation_ == referenced_lists_.get_generation() &&
+       cache.player_lists_ == player_lists &&
+       (player_lists == nullptr ||
+        cache.player_generation_ == player_lists->get_generation()))
+        return;
 
-    append_referenced_lists(list_ids);
+    cache.is_valid_ = true;
+    cache.own_generation_ = referenced_lists_.get_generation();
+    cache.player_lists_ = player_lists;
+    cache.player_generation_ = player_lists != nullptr ? player_lists->get_generation() : 0;
 
-    if(have_audio_source())
+    if(referenced_lists_.empty() &&
+       (player_lists == nullptr || player_lists->empty()))
     {
-        const auto *const pview = static_cast<ViewPlay::View *>(play_view_);
-        pview->append_referenced_lists(get_audio_source(), list_ids);
+        cache.ids_ = GVariantWrapper();
+        return;
     }
 
-    if(list_ids.empty())
-        return std::chrono::milliseconds::zero();
-
     GVariantBuilder builder;
     g_variant_builder_init(&builder, G_VARIANT_TYPE("au"));
 
-    for(const auto id : list_ids)
-        g_variant_builder_add(&builder, "u", id.get_raw_id());
+    referenced_lists_.for_each(
+        [&builder] (ID::List id)
+        { g_variant_builder_add(&builder, "u", id.get_raw_id()); });
 
-    GVariant *keep_list = g_variant_builder_end(&builder);
-    GVariant *unknown_ids_list = NULL;
-    guint64 expiry_ms;
-    GErrorWrapper error;
+    if(player_lists != nullptr)
+        player_lists->for_each(
+            [this, &builder] (ID::List id)
+            {
+                if(!referenced_lists_.contains(id))
+                    g_variant_builder_add(&builder, "u", id.get_raw_id());
+            });
 
-    tdbus_lists_navigation_call_keep_alive_sync(file_list_.get_dbus_proxy(),
-                                                keep_list, &expiry_ms,
-                                                &unknown_ids_list,
-                                                NULL, error.await());
+    cache.ids_ = GVariantWrapper(g_variant_builder_end(&builder));
+}
 
-    if(error.log_failure("Periodic keep alive"))
+std::chrono::milliseconds ViewFileBrowser::View::keep_lists_alive_timer_callback()
+{
+    if(initial_keep_alive_call_ != nullptr ||
+       periodic_keep_alive_call_ != nullptr)
     {
-        msg_error(0, LOG_ERR, "%s: Failed sending keep alive", name_);
-        expiry_ms = 0;
+        msg_vinfo(MESSAGE_LEVEL_DIAG,
+                  "%s: Previous keep alive not answered yet", name_);
+        return std::chrono::milliseconds::zero();
     }
+
+    if(have_audio_source())
+        static_cast<const ViewPlay::View *>(play_view_)->with_referenced_lists(
+            get_audio_source(),
+            [this] (const List::ReferencedLists *player_lists)
+            { update_keep_alive_list_ids(player_lists); });
     else
-        g_variant_unref(unknown_ids_list);
+        update_keep_alive_list_ids(nullptr);
+
+    if(keep_alive_list_ids_.ids_ == nullptr)
+        return std::chrono::milliseconds::zero();
 
-    return compute_keep_alive_timeout(expiry_ms, 80, std::chrono::minutes(5));
+    periodic_keep_alive_call_ = new KeepAliveCall(*this);
+    tdbus_lists_navigation_call_keep_alive(file_list_.get_dbus_proxy(),
+                                           GVariantWrapper::get(keep_alive_list_ids_.ids_),
+                                           periodic_keep_alive_call_->cancellable_,
+                                           periodic_keep_alive_done,
+                                           periodic_keep_alive_call_);
+
+    return std::chrono::milliseconds::zero();
 }
 
 class WaitForParametersHelper
@@ -1399,24 +1550,34 @@ bool ViewFileBrowser::View::write_xml(std::ostream &os, uint32_t bits,
                                       const DCP::Queue::Data &data,
                                       bool &busy_state_triggered)
 {
-    os << "<text id=\"cbid\">" << int(drcp_browse_id_) << "</text>"
-       << "<context>"
-       << list_contexts_[DBUS_LISTS_CONTEXT_GET(current_list_id_.get_raw_id())].string_id_.c_str()
-       << "</context>";
+    next_screen_.clear();
+
+    std::string &header(next_screen_.header_);
+    header += "<text id=\"cbid\">";
+    header += std::to_string(int(drcp_browse_id_));
+    header += "</text><context>";
+    header += list_contexts_[DBUS_LISTS_CONTEXT_GET(current_list_id_.get_raw_id())].string_id_.c_str();
+    header += "</context>";
 
     if((bits & WRITE_FLAG_GROUP__AS_MSG_NO_GET_ITEM_HINT_NEEDED) != 0)
     {
-        os << "<text id=\"line0\">" << XmlEscape(_(on_screen_name_)) << "</text>";
+        forget_displayed_screen();
+
+        if(RenderTrace::is_enabled())
+            RenderTrace::record(name_, RenderTrace::What::MESSAGE, bits);
+
+        os << header;
+        os << "<text id=\"line0\">" << get_escaped_on_screen_name() << "</text>";
         os << "<text id=\"line1\">";
 
         if((bits & WRITE_FLAG__IS_LOADING) != 0)
-            os << XmlEscape(_("Loading")) << "...";
+            os << XmlFragments::get(XmlFragments::Text::LOADING);
         else if((bits & WRITE_FLAG__IS_UNAVAILABLE) != 0)
-            os << XmlEscape(_("Unavailable"));
+            os << XmlFragments::get(XmlFragments::Text::UNAVAILABLE);
         else if((bits & WRITE_FLAG__IS_WAITING) != 0)
-            os << XmlEscape(_("Waiting"));
+            os << XmlFragments::get(XmlFragments::Text::WAITING);
         else if((bits & WRITE_FLAG__IS_LOCKED) != 0)
-            os << XmlEscape(_("Locked"));
+            os << XmlFragments::get(XmlFragments::Text::LOCKED);
         else
             MSG_BUG("%s: Generic: what are we supposed to display here?!", name_);
 
@@ -1454,20 +1615,36 @@ bool ViewFileBrowser::View::write_xml(std::ostream &os, uint32_t bits,
         return false;
     }
 
+    read_ahead_.update(browse_navigation_);
+
     if((bits & WRITE_FLAG__IS_EMPTY_ROOT) != 0)
     {
-        os << "<text id=\"line0\">" << XmlEscape(_(on_screen_name_)) << "</text>";
+        forget_displayed_screen();
+
+        if(RenderTrace::is_enabled())
+            RenderTrace::record(name_, RenderTrace::What::MESSAGE, bits);
+
+        os << header;
+        os << "<text id=\"line0\">" << get_escaped_on_screen_name() << "</text>";
         os << "<text id=\"line1\">" << get_status_string_for_empty_root() << "</text>";
         return true;
     }
 
-    size_t displayed_line = 0;
-    std::ostringstream debug_os;
-    debug_os
-        << "List view, size "
-        << browse_navigation_.get_total_number_of_visible_items() << ":\n";
+    next_screen_.is_valid_ = true;
+    if(get_dynamic_title().empty())
+        next_screen_.title_ = get_escaped_on_screen_name();
+    else
+        XmlFragments::append_escaped(next_screen_.title_,
+                                     get_dynamic_title().get_text());
+
+    const bool is_tracing = RenderTrace::is_enabled();
 
-    Guard dump_debug_string([&debug_os] { msg_info("%s", debug_os.str().c_str()); });
+    if(is_tracing)
+        RenderTrace::record(name_, RenderTrace::What::SCREEN_BEGIN,
+                            browse_navigation_.get_total_number_of_visible_items(),
+                            browse_navigation_.get_cursor());
+
+    size_t displayed_line = 0;
 
     for(auto it : browse_navigation_)
     {
@@ -1507,7 +1684,10 @@ bool ViewFileBrowser::View::write_xml(std::ostream &os, uint32_t bits,
         {
             /* we do not abort the serialization even in case of error,
              * otherwise the user would see no update at all */
-            debug_os << "   " << it << ": *NULL ENTRY*";
+            if(is_tracing)
+                RenderTrace::record(name_, RenderTrace::What::LINE_MISSING,
+                                    displayed_line, it);
+
             break;
         }
 
@@ -1554,28 +1734,116 @@ bool ViewFileBrowser::View::write_xml(std::ostream &os, uint32_t bits,
         }
 
         if(it == browse_navigation_.get_cursor())
-        {
             flags.push_back('s');
-            debug_os << "-> ";
-        }
-        else
-            debug_os << "   ";
 
-        os << "<text id=\"line" << displayed_line << "\" flag=\"" << flags << "\">"
-           << XmlEscape(item->get_text()) << "</text>";
+        std::string &line(next_screen_.append_line());
+        line += "<text id=\"line";
+        line += std::to_string(displayed_line);
+        line += "\" flag=\"";
+        line += flags;
+        line += "\">";
+        XmlFragments::append_escaped(line, item->get_text());
+        line += "</text>";
 
-        debug_os
-            << it << ": "
-            << '[' << static_cast<unsigned int>(item->get_kind().get_raw_code())
-            << "] " << item->get_text() << '\n';
+        if(is_tracing)
+            RenderTrace::record(name_, RenderTrace::What::LINE,
+                                displayed_line, it, flags.c_str());
 
         ++displayed_line;
     }
 
-    os << "<value id=\"listpos\" min=\"1\" max=\""
-       << browse_navigation_.get_total_number_of_visible_items() << "\">"
-       << browse_navigation_.get_line_number_by_cursor() + 1
-       << "</value>";
+    std::string &listpos(next_screen_.listpos_);
+    listpos += "<value id=\"listpos\" min=\"1\" max=\"";
+    listpos += std::to_string(browse_navigation_.get_total_number_of_visible_items());
+    listpos += "\">";
+    listpos += std::to_string(browse_navigation_.get_line_number_by_cursor() + 1);
+    listpos += "</value>";
+
+    return write_screen_diff(os, data, busy_state_triggered);
+}
+
+bool ViewFileBrowser::View::write_screen_diff(std::ostream &os,
+                                              const DCP::Queue::Data &data,
+                                              bool busy_state_triggered)
+{
+    const bool is_tracing = RenderTrace::is_enabled();
+    const bool is_forced = (data.view_update_flags_ & UPDATE_FLAGS_FORCE_SEND) != 0;
+
+    if(!is_forced && !busy_state_triggered && !data.busy_flag_.is_known() &&
+       next_screen_ == displayed_screen_)
+    {
+        /* DCPD shows exactly this already, skip transaction */
+        if(is_tracing)
+            RenderTrace::record(name_, RenderTrace::What::SCREEN_CACHE_HIT);
+
+        return false;
+    }
+
+    size_t bytes = 0;
+    uint32_t changed_lines = 0;
+
+    const auto emit =
+        [&os, &bytes] (const std::string &fragment)
+        {
+            os << fragment;
+            bytes += fragment.size();
+        };
+
+    const bool is_full =
+        data.is_full_serialize_ || !displayed_screen_.is_valid_;
+
+    if(is_full)
+    {
+        emit(next_screen_.header_);
+
+        for(size_t i = 0; i < next_screen_.get_number_of_lines(); ++i)
+            emit(next_screen_.get_line(i));
+
+        emit(next_screen_.listpos_);
+        changed_lines = next_screen_.get_number_of_lines();
+    }
+    else
+    {
+        if(next_screen_.title_ != displayed_screen_.title_)
+        {
+            emit("<text id=\"title\">");
+            emit(next_screen_.title_);
+            emit("</text>");
+        }
+
+        if(next_screen_.header_ != displayed_screen_.header_)
+            emit(next_screen_.header_);
+
+        for(size_t i = 0; i < next_screen_.get_number_of_lines(); ++i)
+        {
+            if(i >= displayed_screen_.get_number_of_lines() ||
+               next_screen_.get_line(i) != displayed_screen_.get_line(i))
+            {
+                emit(next_screen_.get_line(i));
+                ++changed_lines;
+            }
+        }
+
+        for(size_t i = next_screen_.get_number_of_lines();
+            i < displayed_screen_.get_number_of_lines(); ++i)
+        {
+            emit("<text id=\"line" + std::to_string(i) + "\"></text>");
+            ++changed_lines;
+        }
+
+        if(next_screen_.listpos_ != displayed_screen_.listpos_)
+            emit(next_screen_.listpos_);
+    }
+
+    if(is_tracing)
+    {
+        RenderTrace::record(name_, RenderTrace::What::SCREEN_CACHE_MISS,
+                            changed_lines, next_screen_.get_number_of_lines());
+        RenderTrace::record(name_, RenderTrace::What::BYTES_EMITTED,
+                            bytes, is_full ? 1 : 0);
+    }
+
+    std::swap(displayed_screen_, next_screen_);
 
     return true;
 }
@@ -1583,6 +1851,7 @@ bool ViewFileBrowser::View::write_xml(std::ostream &os, uint32_t bits,
 void ViewFileBrowser::View::serialize(DCP::Queue &queue, DCP::Queue::Mode mode,
                                       std::ostream *debug_os, const Maybe<bool> &is_busy)
 {
+    add_update_flags(UPDATE_FLAGS_FORCE_SEND);
     ViewSerializeBase::serialize(queue, mode, debug_os, is_busy);
 
     if(debug_os)
@@ -1596,9 +1865,9 @@ void ViewFileBrowser::View::update(DCP::Queue &queue, DCP::Queue::Mode mode,
     /*
      * I've tried to implement partial updates (and succeeded), but the SPI
      * slave software doesn't interpret them correctly. Unfortunately, we have
-     * to stick with full screen updates for the time being. The display cache
-     * implementation required for partial updates has not been comitted to
-     * avoid dead code.
+     * to stick with full screen updates for the time being. Still, full
+     * screen updates are skipped if nothing has changed on screen (see
+     * #ViewFileBrowser::View::write_screen_diff()).
      */
     ViewSerializeBase::update(queue, mode, debug_os, is_busy);
 #else /* !SPI_SLAVE_IMPLEMENTS_SUPPORTS_PARTIAL_UPDATES */
@@ -1740,7 +2009,7 @@ bool ViewFileBrowser::View::list_invalidate(ID::List list_id, ID::List replaceme
                   "%s: Root list %u got removed, blocking further access",
                   name_, list_id.get_raw_id());
 
-        current_list_id_ = ID::List();
+        set_current_list_id(ID::List());
 
         return false;
     }
@@ -1759,7 +2028,7 @@ bool ViewFileBrowser::View::list_invalidate(ID::List list_id, ID::List replaceme
                   name_, replacement_id.get_raw_id(),
                   current_list_id_.get_raw_id());
 
-        current_list_id_ = replacement_id;
+        set_current_list_id(replacement_id);
         reload_list();
     }
     else
@@ -1818,6 +2087,8 @@ bool ViewFileBrowser::View::data_cookies_available(std::vector<uint32_t> &&cooki
     if(cookies.empty())
         return false;
 
+    DBusRNF::FetchBatch batch;
+
     for(const uint32_t c : cookies)
     {
         try
@@ -1830,6 +2101,8 @@ bool ViewFileBrowser::View::data_cookies_available(std::vector<uint32_t> &&cooki
         }
     }
 
+    batch.finish();
+
     return true;
 }
 
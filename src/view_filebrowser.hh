@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -32,12 +32,15 @@
 #include "player_resumer.hh"
 #include "timeout.hh"
 #include "dbuslist.hh"
+#include "dbuslist_readahead.hh"
+#include "referenced_lists.hh"
 #include "dbus_iface.hh"
 #include "dbus_iface_proxies.hh"
 #include "rnfcall_death_row.hh"
 #include "rnfcall_get_list_id.hh"
 
 #include <unordered_map>
+#include <algorithm>
 
 class WaitForParametersHelper;
 
@@ -57,7 +60,8 @@ namespace ViewFileBrowser
 void init_i18n();
 
 List::Item *construct_file_item(const char *name, ListItemKind kind,
-                                const char *const *names);
+                                const char *const *names,
+                                const GVariantWrapper &page);
 
 namespace StandardError
 {
@@ -302,13 +306,28 @@ class PendingCookies
     std::unordered_map<uint32_t, NotifyFnType> notification_functions_;
     std::unordered_map<uint32_t, FetchFnType> fetch_functions_;
 
+    /*!
+     * Number of asynchronous requests whose cookies are not known yet.
+     */
+    unsigned int async_requests_in_flight_;
+
+    /*!
+     * Notifications received for cookies before they have been added.
+     *
+     * Answers to asynchronous requests are processed in main context, so the
+     * list broker's notifications about these cookies may overtake them.
+     */
+    std::unordered_map<uint32_t, ListError> early_announcements_;
+    std::unordered_map<uint32_t, ListError> early_completions_;
+
   public:
     PendingCookies(const PendingCookies &) = delete;
     PendingCookies(PendingCookies &&) = delete;
     PendingCookies &operator=(const PendingCookies &) = delete;
     PendingCookies &operator=(PendingCookies &&) = delete;
 
-    explicit PendingCookies()
+    explicit PendingCookies():
+        async_requests_in_flight_(0)
     {
         LoggedLock::configure(lock_, "ViewFileBrowser::PendingCookies",
                               MESSAGE_LEVEL_DEBUG);
@@ -342,6 +361,14 @@ class PendingCookies
      * \returns
      *     True if the cookie has been stored, false if the cookie was already
      *     stored (which probably indicates that there is a bug).
+     *
+     * \note
+     *     In case notifications for \p cookie have been received before this
+     *     function is called (see
+     *     #ViewFileBrowser::PendingCookies::async_request_started()), then
+     *     the functions are invoked right away. Cookies returned by
+     *     asynchronous requests must therefore not be added with the RNF call
+     *     object locked.
      */
     bool add(uint32_t cookie, NotifyFnType &&notify_fn, FetchFnType &&fetch_fn)
     {
@@ -349,9 +376,84 @@ class PendingCookies
         msg_log_assert(fetch_fn != nullptr);
 
         LOGGED_LOCK_CONTEXT_HINT;
-        std::lock_guard<LoggedLock::RecMutex> lock(lock_);
+        LoggedLock::UniqueLock<LoggedLock::RecMutex> lock(lock_);
         notification_functions_.emplace(cookie, std::move(notify_fn));
-        return fetch_functions_.emplace(cookie, std::move(fetch_fn)).second;
+
+        if(!fetch_functions_.emplace(cookie, std::move(fetch_fn)).second)
+            return false;
+
+        if(early_announcements_.empty() && early_completions_.empty())
+            return true;
+
+        const auto announced(early_announcements_.find(cookie));
+        const auto completed(early_completions_.find(cookie));
+        const bool have_announcement = announced != early_announcements_.end();
+        const bool have_completion = completed != early_completions_.end();
+        const ListError announcement_error(have_announcement ? announced->second : ListError());
+        const ListError completion_error(have_completion ? completed->second : ListError());
+
+        if(have_announcement)
+            early_announcements_.erase(announced);
+
+        if(have_completion)
+            early_completions_.erase(completed);
+
+        lock.unlock();
+
+        if(have_announcement)
+            available(cookie, announcement_error, "early availability");
+
+        if(have_completion)
+            finish(cookie, completion_error, "early completion");
+
+        return true;
+    }
+
+    /*!
+     * Keep notifications for unknown cookies until the request is answered.
+     *
+     * Must be called before an asynchronous request is sent to the list
+     * broker. Each call must be balanced by a call of
+     * #ViewFileBrowser::PendingCookies::async_request_done().
+     */
+    void async_request_started()
+    {
+        LOGGED_LOCK_CONTEXT_HINT;
+        std::lock_guard<LoggedLock::RecMutex> lock(lock_);
+        ++async_requests_in_flight_;
+    }
+
+    /*!
+     * The answer to an asynchronous request has been processed.
+     *
+     * Must be called after the cookie returned by the request, if any, has
+     * been added. Once there are no more requests in flight, notifications
+     * kept for unknown cookies cannot belong to anything and are dropped.
+     */
+    void async_request_done()
+    {
+        LOGGED_LOCK_CONTEXT_HINT;
+        std::lock_guard<LoggedLock::RecMutex> lock(lock_);
+
+        if(async_requests_in_flight_ == 0)
+        {
+            MSG_BUG("Unbalanced end of asynchronous request");
+            return;
+        }
+
+        if(--async_requests_in_flight_ > 0)
+            return;
+
+        for(const auto &it : early_announcements_)
+            MSG_BUG("No notification function for cookie %u (early announcement)",
+                    it.first);
+
+        for(const auto &it : early_completions_)
+            MSG_BUG("Got notification for unknown cookie %u (early completion)",
+                    it.first);
+
+        early_announcements_.clear();
+        early_completions_.clear();
     }
 
     /*!
@@ -412,7 +514,11 @@ class PendingCookies
 
         if(it == notification_functions_.end())
         {
-            MSG_BUG("No notification function for cookie %u (%s)", cookie, what);
+            if(async_requests_in_flight_ > 0)
+                early_announcements_[cookie] = error;
+            else
+                MSG_BUG("No notification function for cookie %u (%s)", cookie, what);
+
             return;
         }
 
@@ -445,7 +551,11 @@ class PendingCookies
 
         if(it == fetch_functions_.end())
         {
-            MSG_BUG("Got %s notification for unknown cookie %u (finish)", what, cookie);
+            if(async_requests_in_flight_ > 0)
+                early_completions_[cookie] = error;
+            else
+                MSG_BUG("Got %s notification for unknown cookie %u (finish)", what, cookie);
+
             return;
         }
 
@@ -488,6 +598,9 @@ class View: public ViewIface, public ViewSerializeBase, public ViewWithAudioSour
     static constexpr const uint32_t WRITE_FLAG_GROUP__AS_MSG_ANY =
         WRITE_FLAG_GROUP__AS_MSG_NO_GET_ITEM_HINT_NEEDED | WRITE_FLAG__IS_EMPTY_ROOT;
 
+    /* send list even if it looks the same as the last one sent */
+    static constexpr const uint32_t UPDATE_FLAGS_FORCE_SEND = 1U << 0;
+
   public:
     /*!
      * Collection of type aliases and pointers to #DBus::AsyncCall instances.
@@ -580,12 +693,97 @@ class View: public ViewIface, public ViewSerializeBase, public ViewWithAudioSour
     ID::List current_list_id_;
     ContextRestriction context_restriction_;
 
+    /*!
+     * Lists used by this view which must be kept alive.
+     *
+     * Contains the current list and whatever derived classes need to keep
+     * around. Lists referenced by the player are kept alive as well, but are
+     * not stored here.
+     */
+    List::ReferencedLists referenced_lists_;
+
     /* list for the user */
     List::DBusList file_list_;
 
     List::NavItemNoFilter browse_item_filter_;  // contains viewport for browsing
     List::Nav browse_navigation_;
 
+  private:
+    /* load pages next to the displayed page before the user gets there */
+    List::DBusListReadAhead read_ahead_;
+
+    /*!
+     * The list screen as last sent to DCPD.
+     *
+     * Each element is stored as the XML fragment which has been emitted for
+     * it, so that comparing fragments also compares text, flags, and cursor
+     * position. The header contains browse ID and list context, and the
+     * title is stored already escaped so that it can be emitted as is.
+     *
+     * Clearing the screen keeps the memory allocated by the strings so that
+     * the fragments of the next screen can be built without allocations in
+     * most cases.
+     */
+    struct DisplayedScreen
+    {
+        bool is_valid_;
+        std::string title_;
+        std::string header_;
+        std::string listpos_;
+
+      private:
+        /* only the first #number_of_lines_ elements are in use */
+        std::vector<std::string> lines_;
+        size_t number_of_lines_;
+
+      public:
+        explicit DisplayedScreen(): is_valid_(false), number_of_lines_(0) {}
+
+        void clear()
+        {
+            is_valid_ = false;
+            title_.clear();
+            header_.clear();
+            listpos_.clear();
+            number_of_lines_ = 0;
+        }
+
+        /*!
+         * Add empty line, return reference for filling it in.
+         */
+        std::string &append_line()
+        {
+            if(number_of_lines_ >= lines_.size())
+                lines_.emplace_back();
+
+            auto &line(lines_[number_of_lines_++]);
+            line.clear();
+            return line;
+        }
+
+        size_t get_number_of_lines() const { return number_of_lines_; }
+
+        const std::string &get_line(size_t i) const
+        {
+            msg_log_assert(i < number_of_lines_);
+            return lines_[i];
+        }
+
+        bool operator==(const DisplayedScreen &other) const
+        {
+            return is_valid_ && other.is_valid_ &&
+                   title_ == other.title_ && header_ == other.header_ &&
+                   listpos_ == other.listpos_ &&
+                   number_of_lines_ == other.number_of_lines_ &&
+                   std::equal(lines_.begin(), lines_.begin() + number_of_lines_,
+                              other.lines_.begin());
+        }
+    };
+
+    DisplayedScreen displayed_screen_;
+    DisplayedScreen next_screen_;
+
+  protected:
     ViewIface *play_view_;
     const char *const default_audio_source_name_;
 
@@ -599,6 +797,66 @@ class View: public ViewIface, public ViewSerializeBase, public ViewWithAudioSour
 
   private:
     Timeout::Timer keep_lists_alive_timeout_;
+    std::chrono::milliseconds keep_lists_alive_interval_;
+
+    /*!
+     * Keep-alive request sent to the list broker, passed as user data.
+     *
+     * The reply handler owns and deletes the object. A request which has
+     * been superseded by a newer one or whose view is gone is cancelled, and
+     * its reply handler does not touch the view then.
+     */
+    class KeepAliveCall
+    {
+      public:
+        View *view_;
+        GCancellable *const cancellable_;
+
+        KeepAliveCall(const KeepAliveCall &) = delete;
+        KeepAliveCall &operator=(const KeepAliveCall &) = delete;
+
+        explicit KeepAliveCall(View &view):
+            view_(&view),
+            cancellable_(g_cancellable_new())
+        {}
+
+        ~KeepAliveCall() { g_object_unref(cancellable_); }
+
+        void cancel()
+        {
+            view_ = nullptr;
+            g_cancellable_cancel(cancellable_);
+        }
+    };
+
+    /* requests in flight, tracked separately because their answers are
+     * processed differently */
+    KeepAliveCall *initial_keep_alive_call_;
+    KeepAliveCall *periodic_keep_alive_call_;
+
+    /*!
+     * List IDs sent with the last keep-alive message.
+     *
+     * The D-Bus parameter is rebuilt only if the referenced lists have
+     * changed since it has been built.
+     */
+    struct KeepAliveListIDs
+    {
+        GVariantWrapper ids_;
+        bool is_valid_;
+        unsigned int own_generation_;
+        const List::ReferencedLists *player_lists_;
+        unsigned int player_generation_;
+
+        explicit KeepAliveListIDs():
+            is_valid_(false),
+            own_generation_(0),
+            player_lists_(nullptr),
+            player_generation_(0)
+        {}
+    };
+
+    KeepAliveListIDs keep_alive_list_ids_;
 
     ViewIface *search_parameters_view_;
     bool waiting_for_search_parameters_;
@@ -632,16 +890,26 @@ class View: public ViewIface, public ViewSerializeBase, public ViewWithAudioSour
         browse_item_filter_(file_list_.mk_viewport(max_lines, "view"), &file_list_),
         browse_navigation_(max_lines, List::Nav::WrapMode::FULL_WRAP,
                            browse_item_filter_),
+        read_ahead_(file_list_, max_lines),
         play_view_(nullptr),
         default_audio_source_name_(audio_source_name),
         crawler_(cm, DBus::get_lists_navigation_iface(listbroker_id_),
                  event_store, list_contexts_, construct_file_item),
         crawler_defaults_(std::move(crawler_defaults)),
         drcp_browse_id_(drcp_browse_id),
+        keep_lists_alive_interval_(0),
+        initial_keep_alive_call_(nullptr),
+        periodic_keep_alive_call_(nullptr),
         search_parameters_view_(nullptr),
         waiting_for_search_parameters_(false)
     {}
 
+    virtual ~View()
+    {
+        cancel_keep_alive_call(initial_keep_alive_call_);
+        cancel_keep_alive_call(periodic_keep_alive_call_);
+    }
+
     bool init() final override;
     bool late_init() final override;
 
@@ -712,6 +980,20 @@ class View: public ViewIface, public ViewSerializeBase, public ViewWithAudioSour
      */
     bool data_cookie_abort(uint32_t cookie);
 
+    /*!
+     * Keep early cookie notifications while an asynchronous request is
+     * pending.
+     */
+    void data_cookies_async_request_started()
+    {
+        pending_cookies_.async_request_started();
+    }
+
+    void data_cookies_async_request_done()
+    {
+        pending_cookies_.async_request_done();
+    }
+
     /*!
      * Block and queue cookie notifications.
      *
@@ -750,6 +1032,11 @@ class View: public ViewIface, public ViewSerializeBase, public ViewWithAudioSour
      * calling the \p fetch() function previously passed to
      * #ViewFileBrowser::View::data_cookie_set_pending().
      *
+     * The results for all cookies in \p cookies are fetched in a single
+     * pipelined round using a #DBusRNF::FetchBatch, so that the total time
+     * spent in here is bounded by the slowest fetch, not by the sum of all
+     * fetches.
+     *
      * Since this function sychronously retrieves results via D-Bus from the
      * list broker that has caused this function to be called, it must not be
      * called in D-Bus context. See
@@ -907,6 +1194,33 @@ class View: public ViewIface, public ViewSerializeBase, public ViewWithAudioSour
     bool write_xml(std::ostream &os, uint32_t bits,
                    const DCP::Queue::Data &data, bool &busy_state_triggered) override;
 
+    void xml_transaction_failed() final override { forget_displayed_screen(); }
+
+  private:
+    /*!
+     * Emit list screen stored in #ViewFileBrowser::View::next_screen_.
+     *
+     * In case of a full serialization, the whole screen is emitted. For
+     * partial updates, only those elements which differ from what has been
+     * sent before are emitted. If nothing has changed at all and the
+     * serialization has not been forced, then nothing is emitted and the
+     * transaction is skipped.
+     *
+     * \returns
+     *     True if the transaction should be sent, false if it should be
+     *     skipped.
+     */
+    bool write_screen_diff(std::ostream &os, const DCP::Queue::Data &data,
+                           bool busy_state_triggered);
+
+  protected:
+    /*!
+     * Next list serialization will be sent completely.
+     *
+     * To be called when something else than the list has been sent.
+     */
+    void forget_displayed_screen() { displayed_screen_.clear(); }
+
     const std::string &get_status_string_for_empty_root();
 
     const Player::LocalPermissionsIface &get_local_permissions() const;
@@ -947,12 +1261,26 @@ class View: public ViewIface, public ViewSerializeBase, public ViewWithAudioSour
     bool apply_search_parameters();
 
     std::chrono::milliseconds keep_lists_alive_timer_callback();
+    void update_keep_alive_list_ids(const List::ReferencedLists *player_lists);
+    void restart_keep_lists_alive_timer(std::chrono::milliseconds interval);
+    static void cancel_keep_alive_call(KeepAliveCall *&call);
+    static void initial_keep_alive_done(GObject *source_object,
+                                        GAsyncResult *res, gpointer user_data);
+    static void periodic_keep_alive_done(GObject *source_object,
+                                         GAsyncResult *res, gpointer user_data);
+
+    /*!
+     * Change current list, update referenced lists accordingly.
+     */
+    void set_current_list_id(ID::List list_id)
+    {
+        referenced_lists_.exchange(current_list_id_, list_id);
+        current_list_id_ = list_id;
+    }
 
     void resume_request();
 
   protected:
-    virtual void append_referenced_lists(std::vector<ID::List> &list_ids) const {}
-
     virtual void handle_enter_list_event(List::AsyncListIface::OpResult result,
                                          const List::QueryContextEnterList *const ctx)
     {
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2016--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -49,13 +49,25 @@ bool ViewFileBrowser::AirableView::try_jump_to_stored_position(StoredPosition &p
     return false;
 }
 
-void ViewFileBrowser::AirableView::append_referenced_lists(std::vector<ID::List> &list_ids) const
+void ViewFileBrowser::AirableView::sync_stash_references()
 {
+    std::vector<ID::List> list_ids;
+
     for(const auto &pos : audio_source_navigation_stash_)
     {
         if(pos.is_set() && !pos.is_keep_alive_suppressed())
             list_ids.push_back(pos.get_list_id());
     }
+
+    /* take new references before dropping the old ones so that lists
+     * referenced before and after are not removed in between */
+    for(const auto id : list_ids)
+        referenced_lists_.ref(id);
+
+    for(const auto id : stash_referenced_lists_)
+        referenced_lists_.unref(id);
+
+    stash_referenced_lists_.swap(list_ids);
 }
 
 void ViewFileBrowser::AirableView::audio_source_state_changed(
@@ -106,6 +118,8 @@ void ViewFileBrowser::AirableView::audio_source_state_changed(
 
         break;
     }
+
+    sync_stash_references();
 }
 
 ViewIface::InputResult
@@ -511,6 +525,8 @@ bool ViewFileBrowser::AirableView::list_invalidate(ID::List list_id, ID::List re
     for(auto &stash : audio_source_navigation_stash_)
         stash.list_invalidate(list_id, replacement_id);
 
+    sync_stash_references();
+
     return View::list_invalidate(list_id, replacement_id);
 }
 
@@ -898,6 +914,8 @@ bool ViewFileBrowser::AirableView::write_xml(std::ostream &os, uint32_t bits,
     if((bits & WRITE_FLAG_GROUP__AS_MSG_NO_GET_ITEM_HINT_NEEDED) == 0)
         return ViewFileBrowser::View::write_xml(os, bits, data, busy_state_triggered);
 
+    forget_displayed_screen();
+
     const auto ctx_id(determine_ctx_id(have_audio_source(),
                                        context_restriction_.get_context_id(),
                                        current_list_id_));
@@ -921,13 +939,13 @@ bool ViewFileBrowser::AirableView::write_xml(std::ostream &os, uint32_t bits,
        << "<text id=\"line1\">";
 
     if((bits & WRITE_FLAG__IS_LOADING) != 0)
-        os << XmlEscape(_("Accessing")) << "...";
+        os << XmlFragments::get(XmlFragments::Text::ACCESSING);
     else if((bits & WRITE_FLAG__IS_UNAVAILABLE) != 0)
-        os << XmlEscape(_("Unavailable"));
+        os << XmlFragments::get(XmlFragments::Text::UNAVAILABLE);
     else if((bits & WRITE_FLAG__IS_WAITING) != 0)
-        os << XmlEscape(_("Waiting"));
+        os << XmlFragments::get(XmlFragments::Text::WAITING);
     else if((bits & WRITE_FLAG__IS_LOCKED) != 0)
-        os << XmlEscape(_("Please use our app."));
+        os << XmlFragments::get(XmlFragments::Text::PLEASE_USE_OUR_APP);
     else
         MSG_BUG("Airable: what are we supposed to display here?!");
 
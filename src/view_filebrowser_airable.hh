@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2016--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -261,6 +261,10 @@ class AirableView: public View
      * audio-specific locations when switching between audio sources */
     std::vector<StoredPosition> audio_source_navigation_stash_;
 
+    /* lists in #ViewFileBrowser::AirableView::audio_source_navigation_stash_
+     * currently accounted for in #ViewFileBrowser::View::referenced_lists_ */
+    std::vector<ID::List> stash_referenced_lists_;
+
   public:
     AirableView(const AirableView &) = delete;
     AirableView &operator=(const AirableView &) = delete;
@@ -285,6 +289,8 @@ class AirableView: public View
                               std::unique_ptr<UI::Parameters> parameters) final override;
 
   private:
+    void sync_stash_references();
+
     InputResult process_login_status_update(std::unique_ptr<UI::Parameters> parameters);
     InputResult process_oauth_request(std::unique_ptr<UI::Parameters> parameters);
 
@@ -301,8 +307,6 @@ class AirableView: public View
   protected:
     bool register_audio_sources() final override;
 
-    void append_referenced_lists(std::vector<ID::List> &list_ids) const final override;
-
     void cancel_and_delete_all_async_calls() final override;
     void handle_enter_list_event(List::AsyncListIface::OpResult result,
                                  const List::QueryContextEnterList *const ctx) final override;
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016, 2018, 2019  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2016, 2018, 2019, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -24,17 +24,38 @@
 
 #include "list.hh"
 #include "metadata_preloaded.hh"
+#include "search_key.hh"
+#include "gvariantwrapper.hh"
 #include "de_tahifi_lists_item_kinds.hh"
 
 namespace ViewFileBrowser
 {
 
-class FileItem: public List::TextItem
+/*!
+ * List item in a list retrieved from a list broker.
+ *
+ * Items constructed from D-Bus data do not copy any strings. Instead, they
+ * keep a reference to the \c GVariant containing the range of list items the
+ * item was received with, and point directly into the serialized data.
+ * Creating and destroying such an item costs a single allocation for the
+ * object itself and one for its search key.
+ */
+class FileItem: public List::TextItem, public List::SearchableItem
 {
   private:
+    /*!
+     * Owner of all strings this item refers to, may be empty.
+     */
+    GVariantWrapper page_;
+
     ListItemKind kind_;
     MetaData::PreloadedSet preloaded_meta_data_;
 
+    /*!
+     * Casefolded item text for list search, computed once on construction.
+     */
+    Search::Key search_key_;
+
     static FileItem loading_placeholder_;
 
   public:
@@ -42,12 +63,34 @@ class FileItem: public List::TextItem
     FileItem &operator=(const FileItem &) = delete;
     explicit FileItem(FileItem &&) = default;
 
+    /*!
+     * Construct item which copies its text.
+     *
+     * The strings referenced by \p meta_data must be static.
+     */
     explicit FileItem(const char *text, unsigned int flags,
                       ListItemKind item_kind, MetaData::PreloadedSet &&meta_data):
         List::Item(flags),
         List::TextItem(text, true, flags),
+        List::SearchableItem(flags),
         kind_(item_kind),
-        preloaded_meta_data_(std::move(meta_data))
+        preloaded_meta_data_(std::move(meta_data)),
+        search_key_(get_text())
+    {}
+
+    /*!
+     * Construct item which refers to strings stored in \p page.
+     */
+    explicit FileItem(const GVariantWrapper &page, const char *text,
+                      unsigned int flags, ListItemKind item_kind,
+                      MetaData::PreloadedSet &&meta_data):
+        List::Item(flags),
+        List::TextItem(BorrowText(), text, true, flags),
+        List::SearchableItem(flags),
+        page_(page),
+        kind_(item_kind),
+        preloaded_meta_data_(std::move(meta_data)),
+        search_key_(get_text())
     {}
 
     static void init_i18n();
@@ -59,6 +102,8 @@ class FileItem: public List::TextItem
         return preloaded_meta_data_;
     }
 
+    const Search::Key &get_search_key() const override { return search_key_; }
+
     static const List::Item &get_loading_placeholder() { return loading_placeholder_; }
 };
 
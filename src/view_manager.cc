@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -31,9 +31,12 @@
 #include "ui_parameters_predefined.hh"
 #include "messages.h"
 #include "dump_enum_value.hh"
+#include "boot_timeline.hh"
 
 #include <string>
 #include <numeric>
+#include <limits>
+#include <cstdlib>
 
 static ViewNop::View nop_view;
 
@@ -80,10 +83,13 @@ bool ViewManager::Manager::add_view(ViewIface &view)
 
 bool ViewManager::Manager::invoke_late_init_functions()
 {
+    BootTimeline::Phase phase("invoke_late_init_functions");
+
     const bool result =
         std::accumulate(all_views_.begin(), all_views_.end(), true,
             [] (bool ok, auto &v)
             {
+                BootTimeline::Phase view_phase("late_init", v.second->name_);
                 return v.second->late_init() && ok;
             });
 
@@ -122,6 +128,9 @@ void ViewManager::Manager::set_resume_playback_configuration_file(const char *fi
     msg_log_assert(filename[0] != '\0');
 
     resume_playback_config_filename_ = filename;
+
+    BootTimeline::Phase phase("parse resume file");
+
     inifile_free(&resume_configuration_file_);
     inifile_parse_from_file(&resume_configuration_file_,
                             resume_playback_config_filename_);
@@ -352,25 +361,10 @@ void ViewManager::Manager::notify_main_thread_if_necessary(
 void ViewManager::Manager::store_event(UI::EventID event_id,
                                        std::unique_ptr<UI::Parameters> parameters)
 {
-    std::unique_ptr<UI::Events::BaseEvent> ev;
-
-    switch(UI::get_event_type_id(event_id))
-    {
-      case UI::EventTypeID::INPUT_EVENT:
-        ev = std::make_unique<UI::Events::ViewInput>(event_id, std::move(parameters));
-        break;
-
-      case UI::EventTypeID::BROADCAST_EVENT:
-        ev = std::make_unique<UI::Events::Broadcast>(event_id, std::move(parameters));
-        break;
-
-      case UI::EventTypeID::VIEW_MANAGER_EVENT:
+    if(UI::get_event_type_id(event_id) == UI::EventTypeID::VIEW_MANAGER_EVENT)
         notify_main_thread_if_necessary(event_id, parameters.get());
-        ev = std::make_unique<UI::Events::ViewMan>(event_id, std::move(parameters));
-        break;
-    }
 
-    ui_events_.post(std::move(ev));
+    ui_events_.post(event_id, std::move(parameters));
 }
 
 static void log_event_dispatch(const UI::ViewEventID event_id,
@@ -801,24 +795,113 @@ void ViewManager::Manager::hide_view_if_active(const ViewIface *view)
         handle_input_result(ViewIface::InputResult::SHOULD_HIDE, *active_view_);
 }
 
-void ViewManager::Manager::process_pending_events()
+/*!
+ * Merge bursts of events which are superseded by their successors.
+ *
+ * Consecutive scroll requests into the same direction are merged into a
+ * single request with the summed distance. Consecutive stream position
+ * updates for the same stream are replaced by the latest update. This avoids
+ * sending a DCP transaction for each intermediate step when the user spins
+ * the encoder knob or when the stream player reports positions faster than
+ * we process them.
+ *
+ * Scroll requests are merged only while a browser view is active. Other
+ * views may switch to another view in reaction to the first scroll request
+ * (see #ViewPlay::View), and the remaining requests must be processed by
+ * the view switched to. The held event has not been dispatched yet when this
+ * function is called, so \p active_view is the view the held event is going
+ * to be dispatched to.
+ */
+static bool coalesce_events(UI::EventQueue::Event &held,
+                            UI::EventQueue::Event &next,
+                            const ViewIface *active_view)
 {
-    while(true)
+    if(held.event_id_ != next.event_id_ ||
+       held.parameters_ == nullptr || next.parameters_ == nullptr)
+        return false;
+
+    switch(held.event_id_)
     {
-        std::unique_ptr<UI::Events::BaseEvent> event = ui_events_.take();
+      case UI::EventID::NAV_SCROLL_LINES:
+      case UI::EventID::NAV_SCROLL_PAGES:
+        {
+            if(dynamic_cast<const ViewFileBrowser::View *>(active_view) == nullptr)
+                return false;
 
-        if(event == nullptr)
-            return;
+            using PType =
+                UI::Events::ParamTraits<UI::EventID::NAV_SCROLL_LINES>::PType;
+            auto *const h = dynamic_cast<PType *>(held.parameters_.get());
+            const auto *const n = dynamic_cast<const PType *>(next.parameters_.get());
 
-        if(auto *ev_vi = dynamic_cast<UI::Events::ViewInput *>(event.get()))
-            dispatch_event(ev_vi->event_id_, std::move(ev_vi->parameters_));
-        else if(auto *ev_bc = dynamic_cast<UI::Events::Broadcast *>(event.get()))
-            dispatch_event(ev_bc->event_id_, std::move(ev_bc->parameters_));
-        else if(auto *ev_vm = dynamic_cast<UI::Events::ViewMan *>(event.get()))
-            dispatch_event(ev_vm->event_id_, std::move(ev_vm->parameters_));
-        else
-            MSG_BUG("Unhandled event");
+            if(h == nullptr || n == nullptr)
+                return false;
+
+            int &distance(h->get_specific_non_const());
+            const int more = n->get_specific();
+
+            /* changing direction may hit the end of the list in between, so
+             * the sum would not be equivalent to the single steps */
+            if((distance < 0) != (more < 0))
+                return false;
+
+            if(std::abs(distance) > std::numeric_limits<int>::max() - std::abs(more))
+                return false;
+
+            distance += more;
+            return true;
+        }
+
+      case UI::EventID::VIEW_PLAYER_STREAM_POSITION:
+        {
+            using PType =
+                UI::Events::ParamTraits<UI::EventID::VIEW_PLAYER_STREAM_POSITION>::PType;
+            const auto *const h = dynamic_cast<const PType *>(held.parameters_.get());
+            const auto *const n = dynamic_cast<const PType *>(next.parameters_.get());
+
+            if(h == nullptr || n == nullptr ||
+               std::get<0>(h->get_specific()) != std::get<0>(n->get_specific()))
+                return false;
+
+            held.parameters_ = std::move(next.parameters_);
+            return true;
+        }
+
+      default:
+        break;
     }
+
+    return false;
+}
+
+void ViewManager::Manager::process_pending_events()
+{
+    ui_events_.take_all(
+        [this] (UI::EventQueue::Event &&ev)
+        {
+            switch(UI::get_event_type_id(ev.event_id_))
+            {
+              case UI::EventTypeID::INPUT_EVENT:
+                dispatch_event(UI::to_event_type<UI::ViewEventID>(ev.event_id_),
+                               std::move(ev.parameters_));
+                return;
+
+              case UI::EventTypeID::BROADCAST_EVENT:
+                dispatch_event(UI::to_event_type<UI::BroadcastEventID>(ev.event_id_),
+                               std::move(ev.parameters_));
+                return;
+
+              case UI::EventTypeID::VIEW_MANAGER_EVENT:
+                dispatch_event(UI::to_event_type<UI::VManEventID>(ev.event_id_),
+                               std::move(ev.parameters_));
+                return;
+            }
+
+            MSG_BUG("Unhandled event");
+        },
+        [this] (UI::EventQueue::Event &held, UI::EventQueue::Event &next)
+        {
+            return coalesce_events(held, next, active_view_);
+        });
 }
 
 void ViewManager::Manager::busy_state_notification(bool is_busy)
@@ -898,6 +981,28 @@ bool ViewManager::Manager::abort_cookie(const void *proxy, uint32_t cookie)
     return view->data_cookie_abort(cookie);
 }
 
+void ViewManager::Manager::async_request_started(const void *proxy)
+{
+    auto *const view =
+        dynamic_cast<ViewFileBrowser::View *>(get_view_by_dbus_proxy(proxy));
+
+    if(view != nullptr)
+        view->data_cookies_async_request_started();
+    else
+        MSG_BUG("No file browser view for given proxy, cannot start async request");
+}
+
+void ViewManager::Manager::async_request_done(const void *proxy)
+{
+    auto *const view =
+        dynamic_cast<ViewFileBrowser::View *>(get_view_by_dbus_proxy(proxy));
+
+    if(view != nullptr)
+        view->data_cookies_async_request_done();
+    else
+        MSG_BUG("No file browser view for given proxy, cannot finish async request");
+}
+
 void ViewManager::Manager::configuration_changed_notification(
         const char *origin,
         const std::array<bool, Configuration::DrcpdValues::NUMBER_OF_KEYS> &changed)
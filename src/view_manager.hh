@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015--2021  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015--2021, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -249,6 +249,8 @@ class Manager: public VMIface, public UI::EventStoreIface, public DBusRNF::Cooki
                             NotifyByCookieFn &&notify, FetchByCookieFn &&fetch)
         final override;
     bool abort_cookie(const void *proxy, uint32_t cookie) final override;
+    void async_request_started(const void *proxy) final override;
+    void async_request_done(const void *proxy) final override;
 
     const char *get_view_name_by_dbus_proxy(const void *dbus_proxy) const;
 
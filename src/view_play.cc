@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -36,6 +36,8 @@
 #include "xmlescape.hh"
 #include "messages.h"
 
+#include <sstream>
+
 bool ViewPlay::View::init()
 {
     return true;
@@ -147,14 +149,16 @@ void ViewPlay::View::player_finished(Player::Control::FinishedWith what,
     view_manager_->hide_view_if_active(this);
 }
 
-void ViewPlay::View::append_referenced_lists(const Player::AudioSource &audio_source,
-                                             std::vector<ID::List> &list_ids) const
+void ViewPlay::View::with_referenced_lists(
+        const Player::AudioSource &audio_source,
+        const std::function<void(const List::ReferencedLists *)> &fn) const
 {
     const auto lock_ctrl(player_control_.lock());
     const auto lock_data(player_data_.lock());
 
-    if(player_control_.is_active_controller_for_audio_source(audio_source))
-        player_data_.append_referenced_lists(list_ids);
+    fn(player_control_.is_active_controller_for_audio_source(audio_source)
+       ? &player_data_.get_referenced_lists()
+       : nullptr);
 }
 
 static void send_current_stream_info_to_dcpd(const Player::Data &player_data)
@@ -1001,7 +1005,12 @@ ViewPlay::View::process_event(UI::ViewEventID event_id,
         break;
 
       case UI::ViewEventID::PLAYBACK_MODE_SHUFFLE_TOGGLE:
-        player_control_.shuffle_mode_toggle_request();
+        if(player_control_.shuffle_mode_toggle_request())
+        {
+            add_update_flags(UPDATE_FLAGS_PLAYBACK_MODES);
+            view_manager_->update_view_if_active(this, DCP::Queue::Mode::FORCE_ASYNC);
+        }
+
         break;
 
       case UI::ViewEventID::SEARCH_COMMENCE:
@@ -1104,7 +1113,7 @@ bool ViewPlay::View::write_xml(std::ostream &os, uint32_t bits,
 
     if(data.is_full_serialize_ && is_buffering)
         os << "<text id=\"track\">"
-           << XmlEscape(_("Buffering")) << "..."
+           << XmlFragments::get(XmlFragments::Text::BUFFERING)
            << "</text>";
     else if((update_flags & UPDATE_FLAGS_META_DATA) != 0)
     {
@@ -1160,19 +1169,17 @@ bool ViewPlay::View::write_xml(std::ostream &os, uint32_t bits,
         /* matches enum #Player::VisibleStreamState */
         static const char *play_icon[] =
         {
-            "",
-            "",
-            "play",
-            "pause",
-            "ffmode",
-            "frmode",
+            "<icon id=\"play\"></icon>",
+            "<icon id=\"play\"></icon>",
+            "<icon id=\"play\">play</icon>",
+            "<icon id=\"play\">pause</icon>",
+            "<icon id=\"play\">ffmode</icon>",
+            "<icon id=\"play\">frmode</icon>",
         };
 
         static_assert(sizeof(play_icon) / sizeof(play_icon[0]) == static_cast<size_t>(Player::VisibleStreamState::LAST) + 1, "Array has wrong size");
 
-        os << "<icon id=\"play\">"
-           << play_icon[static_cast<size_t>(stream_state)]
-           << "</icon>";
+        os << play_icon[static_cast<size_t>(stream_state)];
     }
 
     if((update_flags & UPDATE_FLAGS_PLAYBACK_MODES) != 0)
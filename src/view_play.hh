@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -115,8 +115,16 @@ class View: public ViewIface, public ViewSerializeBase
             std::shared_ptr<Playlist::Crawler::FindNextOpBase> find_op,
             const Player::LocalPermissionsIface &permissions, std::string &&reason);
     void stop_playing(const Player::AudioSource &audio_source);
-    void append_referenced_lists(const Player::AudioSource &audio_source,
-                                 std::vector<ID::List> &list_ids) const;
+
+    /*!
+     * Call function with lists referenced by the player, if any.
+     *
+     * The function is called with the player data locked. It is passed a
+     * null pointer in case the player is not controlled through the given
+     * audio source.
+     */
+    void with_referenced_lists(const Player::AudioSource &audio_source,
+                               const std::function<void(const List::ReferencedLists *)> &fn) const;
 
   private:
     /*!
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2016--2023  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2016--2023, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -23,6 +23,7 @@
 #define VIEW_SERIALIZE_HH
 
 #include <ostream>
+#include <sstream>
 #include <atomic>
 #include <array>
 
@@ -33,6 +34,7 @@
 #include "i18n.hh"
 #include "i18nstring.hh"
 #include "xmlescape.hh"
+#include "xml_fragments.hh"
 #include "guard.hh"
 
 /* open up a bit for unit tests */
@@ -65,6 +67,15 @@ class ViewSerializeBase
     I18n::String dynamic_title_;
     std::atomic_bool is_serializing_;
 
+    /*!
+     * Translated and XML-escaped #ViewSerializeBase::on_screen_name_.
+     *
+     * Built on first use and after each language change, see
+     * #XmlFragments::get_language_generation().
+     */
+    mutable std::string escaped_on_screen_name_;
+    mutable unsigned int escaped_on_screen_name_generation_;
+
   public:
     ViewSerializeBase(const ViewSerializeBase &) = delete;
     ViewSerializeBase &operator=(const ViewSerializeBase &) = delete;
@@ -83,7 +94,8 @@ class ViewSerializeBase
         drcp_view_id_(drcp_view_id),
         update_flags_(0),
         dynamic_title_(false),
-        is_serializing_(false)
+        is_serializing_(false),
+        escaped_on_screen_name_generation_(0)
     {}
 
     virtual ~ViewSerializeBase() {}
@@ -141,6 +153,14 @@ class ViewSerializeBase
                 write_xml_end(os, bits, data, busy_state_triggered));
     }
 
+    /*!
+     * DCPD has not accepted the XML written for this view.
+     *
+     * Views which keep track of what they have sent to DCPD should forget
+     * about it here. The base implementation does nothing.
+     */
+    virtual void xml_transaction_failed() {}
+
     virtual void set_dynamic_title(const I18n::String &t) { dynamic_title_ = t; }
     virtual void set_dynamic_title(const char *t)         { dynamic_title_ = t; }
     virtual void set_dynamic_title(I18n::String &&t)      { dynamic_title_ = std::move(t); }
@@ -164,6 +184,25 @@ class ViewSerializeBase
         return std::make_pair(drcp_view_id_, ScreenID::INVALID_ID);
     }
 
+    /*!
+     * Translated on-screen name of this view, ready to be written to DCPD.
+     */
+    const std::string &get_escaped_on_screen_name() const
+    {
+        const unsigned int generation = XmlFragments::get_language_generation();
+
+        if(escaped_on_screen_name_generation_ != generation ||
+           generation == 0)
+        {
+            std::ostringstream os;
+            os << XmlEscape(_(on_screen_name_));
+            escaped_on_screen_name_ = os.str();
+            escaped_on_screen_name_generation_ = generation;
+        }
+
+        return escaped_on_screen_name_;
+    }
+
     /*!
      * Start writing XML data, opens view or update tag and some generic tags.
      *
@@ -193,11 +232,16 @@ class ViewSerializeBase
 
         if(data.is_full_serialize_)
         {
-            if(ids.first != ViewID::ERROR)
+            if(ids.first == ViewID::ERROR)
+            {
+                /* no title */
+            }
+            else if(get_dynamic_title().empty())
+                os << "<text id=\"title\">" << get_escaped_on_screen_name()
+                   << "</text>";
+            else
                 os << "<text id=\"title\">"
-                   << (get_dynamic_title().empty()
-                       ? XmlEscape(_(on_screen_name_))
-                       : XmlEscape(get_dynamic_title().get_text()))
+                   << XmlEscape(get_dynamic_title().get_text())
                    << "</text>";
 
             if(ids.second != ScreenID::INVALID_ID)
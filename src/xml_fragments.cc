@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include "xml_fragments.hh"
+#include "i18n.hh"
+#include "xmlescape.hh"
+
+#include <array>
+#include <sstream>
+
+struct FragmentSource
+{
+    const char *const text_;
+    const char *const suffix_;
+};
+
+static const std::array<FragmentSource, size_t(XmlFragments::Text::LAST_TEXT) + 1> sources
+{
+    FragmentSource{N_("Loading"), "..."},
+    FragmentSource{N_("Unavailable"), ""},
+    FragmentSource{N_("Waiting"), ""},
+    FragmentSource{N_("Locked"), ""},
+    FragmentSource{N_("Buffering"), "..."},
+    FragmentSource{N_("Accessing"), "..."},
+    FragmentSource{N_("Please use our app."), ""},
+};
+
+static std::array<std::string, size_t(XmlFragments::Text::LAST_TEXT) + 1> fragments;
+static unsigned int language_generation;
+
+static void rebuild_fragments()
+{
+    for(size_t i = 0; i < sources.size(); ++i)
+    {
+        std::ostringstream os;
+        os << XmlEscape(_(sources[i].text_)) << sources[i].suffix_;
+        fragments[i] = os.str();
+    }
+
+    ++language_generation;
+}
+
+void XmlFragments::init_i18n()
+{
+    rebuild_fragments();
+    I18n::register_notifier([] (const char *) { rebuild_fragments(); });
+}
+
+const std::string &XmlFragments::get(Text text)
+{
+    if(language_generation == 0)
+        rebuild_fragments();
+
+    return fragments[size_t(text)];
+}
+
+unsigned int XmlFragments::get_language_generation()
+{
+    return language_generation;
+}
+
+/*!
+ * Stream buffer which appends all output to a string.
+ */
+class AppendToString: public std::streambuf
+{
+  private:
+    std::string *dest_;
+
+  public:
+    AppendToString(const AppendToString &) = delete;
+    AppendToString &operator=(const AppendToString &) = delete;
+
+    explicit AppendToString(): dest_(nullptr) {}
+
+    void set_destination(std::string *dest) { dest_ = dest; }
+
+  protected:
+    int_type overflow(int_type ch) override
+    {
+        if(dest_ == nullptr)
+            return traits_type::eof();
+
+        if(!traits_type::eq_int_type(ch, traits_type::eof()))
+            dest_->push_back(traits_type::to_char_type(ch));
+
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char_type *s, std::streamsize count) override
+    {
+        if(dest_ == nullptr)
+            return 0;
+
+        dest_->append(s, count);
+        return count;
+    }
+};
+
+void XmlFragments::append_escaped(std::string &dest, const char *src)
+{
+    static thread_local AppendToString buffer;
+    static thread_local std::ostream os(&buffer);
+
+    buffer.set_destination(&dest);
+    os << XmlEscape(src);
+    buffer.set_destination(nullptr);
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#ifndef XML_FRAGMENTS_HH
+#define XML_FRAGMENTS_HH
+
+#include <string>
+
+/*!
+ * Translated, XML-escaped strings for use in DCP XML.
+ *
+ * Several short strings are sent to DCPD over and over again, most of them
+ * translated. Instead of passing them through \c gettext() and escaping them
+ * for each serialization, they are translated and escaped once per language
+ * change and stored here.
+ */
+namespace XmlFragments
+{
+
+enum class Text
+{
+    LOADING,
+    UNAVAILABLE,
+    WAITING,
+    LOCKED,
+    BUFFERING,
+    ACCESSING,
+    PLEASE_USE_OUR_APP,
+
+    LAST_TEXT = PLEASE_USE_OUR_APP,
+};
+
+/*!
+ * Register language change notifier, build fragments for current language.
+ *
+ * Must be called after #I18n::init(). In case this function is never
+ * called, the fragments are built on first use and never updated.
+ */
+void init_i18n();
+
+/*!
+ * Translated and escaped string, ready to be written to DCPD.
+ */
+const std::string &get(Text text);
+
+/*!
+ * Number of language changes seen so far.
+ *
+ * Client code which caches translated strings itself should store this
+ * number along with its cached strings, and rebuild them if the number has
+ * changed.
+ */
+unsigned int get_language_generation();
+
+/*!
+ * Append XML-escaped string to given string.
+ *
+ * The string is escaped by #XmlEscape, but written straight into \p dest
+ * without going through a string stream, so that building fragments in
+ * strings which are reused does not allocate in most cases.
+ */
+void append_escaped(std::string &dest, const char *src);
+
+}
+
+#endif /* !XML_FRAGMENTS_HH */
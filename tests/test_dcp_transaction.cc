@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2015, 2016, 2019, 2020  T+A elektroakustik GmbH & Co. KG
+ * Copyright (C) 2015, 2016, 2019, 2020, 2026  T+A elektroakustik GmbH & Co. KG
  *
  * This file is part of DRCPD.
  *
@@ -24,8 +24,11 @@
 #endif /* HAVE_CONFIG_H */
 
 #include <cppcutter.h>
+#include <sstream>
+#include <vector>
 
 #include "dcp_transaction.hh"
+#include "gather_writer.hh"
 
 #include "mock_messages.hh"
 
@@ -308,6 +311,130 @@ void test_set_null_output_stream()
     cut_assert_true(dt->done());
 }
 
+/*!
+ * Stream buffer which accepts only limited amounts of data per write.
+ */
+class PartialGatherWriter: public std::streambuf, public GatherWriter
+{
+  private:
+    std::vector<ssize_t> write_limits_;
+    size_t next_limit_;
+
+  public:
+    std::string written_;
+    std::vector<size_t> number_of_buffers_;
+
+    PartialGatherWriter(const PartialGatherWriter &) = delete;
+    PartialGatherWriter &operator=(const PartialGatherWriter &) = delete;
+
+    explicit PartialGatherWriter(std::vector<ssize_t> &&write_limits):
+        write_limits_(std::move(write_limits)),
+        next_limit_(0)
+    {}
+
+    void check() const
+    {
+        cppcut_assert_equal(write_limits_.size(), next_limit_);
+    }
+
+  protected:
+    ssize_t write_some(const struct iovec *iov, size_t count) override
+    {
+        cppcut_assert_operator(write_limits_.size(), >, next_limit_);
+
+        number_of_buffers_.push_back(count);
+
+        const ssize_t limit = write_limits_[next_limit_++];
+
+        if(limit < 0)
+            return limit;
+
+        size_t remaining = limit;
+
+        for(size_t i = 0; i < count && remaining > 0; ++i)
+        {
+            const size_t n = std::min(remaining, iov[i].iov_len);
+            written_.append(static_cast<const char *>(iov[i].iov_base), n);
+            remaining -= n;
+        }
+
+        return limit - remaining;
+    }
+};
+
+/*!\test
+ * Partial writes to a gathering stream buffer are continued with the
+ * remaining data.
+ */
+void test_commit_continues_partial_gathered_writes()
+{
+    PartialGatherWriter sbuf({3, 7, 100});
+    std::ostream out(&sbuf);
+    dt->set_output_stream(&out);
+
+    cut_assert_true(dt->start());
+    cppcut_assert_not_null(dt->stream());
+    *dt->stream() << "Gathered";
+    mock_messages->expect_msg_is_verbose(false, MESSAGE_LEVEL_TRACE);
+    cut_assert_true(dt->commit());
+    cut_assert_true(dt->done());
+
+    sbuf.check();
+    cut_assert_true(out.good());
+    cppcut_assert_equal("Size: 8\nGathered", sbuf.written_.c_str());
+
+    /* header, header and body, remainder of body */
+    cppcut_assert_equal(size_t(3), sbuf.number_of_buffers_.size());
+    cppcut_assert_equal(size_t(2), sbuf.number_of_buffers_[0]);
+    cppcut_assert_equal(size_t(2), sbuf.number_of_buffers_[1]);
+    cppcut_assert_equal(size_t(1), sbuf.number_of_buffers_[2]);
+}
+
+/*!\test
+ * A gathered write which makes no progress is treated as error instead of
+ * being retried forever.
+ */
+void test_commit_fails_if_gathered_write_makes_no_progress()
+{
+    PartialGatherWriter sbuf({4, 0});
+    std::ostream out(&sbuf);
+    dt->set_output_stream(&out);
+
+    cut_assert_true(dt->start());
+    cppcut_assert_not_null(dt->stream());
+    *dt->stream() << "Stuck";
+    mock_messages->expect_msg_is_verbose(false, MESSAGE_LEVEL_TRACE);
+    mock_messages->expect_msg_error(0, LOG_ERR,
+                                    "Failed writing gathered data, no progress");
+    cut_assert_true(dt->commit());
+    cut_assert_true(dt->done());
+
+    sbuf.check();
+    cut_assert_true(out.bad());
+    cppcut_assert_equal("Size", sbuf.written_.c_str());
+}
+
+/*!\test
+ * A failing gathered write is reported through the output stream state.
+ */
+void test_commit_fails_if_gathered_write_fails()
+{
+    PartialGatherWriter sbuf({-1});
+    std::ostream out(&sbuf);
+    dt->set_output_stream(&out);
+
+    cut_assert_true(dt->start());
+    cppcut_assert_not_null(dt->stream());
+    *dt->stream() << "Failed";
+    mock_messages->expect_msg_is_verbose(false, MESSAGE_LEVEL_TRACE);
+    cut_assert_true(dt->commit());
+    cut_assert_true(dt->done());
+
+    sbuf.check();
+    cut_assert_true(out.bad());
+    cut_assert_true(sbuf.written_.empty());
+}
+
 }
 
 
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <doctest.h>
+
+#include "boot_timeline.hh"
+
+#include <vector>
+#include <string>
+
+TEST_SUITE_BEGIN("Boot timeline");
+
+using Clock = std::chrono::steady_clock;
+
+static std::vector<std::string> collect(const BootTimeline::Timeline<4> &timeline)
+{
+    std::vector<std::string> result;
+
+    timeline.for_each(
+        [&result] (const BootTimeline::Entry &e)
+        {
+            std::string s(e.depth_, '-');
+            s += e.phase_;
+
+            if(e.subject_ != nullptr)
+            {
+                s += ' ';
+                s += e.subject_;
+            }
+
+            if(!e.is_finished_)
+                s += '*';
+
+            result.push_back(s);
+        });
+
+    return result;
+}
+
+TEST_CASE("Phases are stored in order of their beginning with nesting depth")
+{
+    BootTimeline::Timeline<4> timeline;
+    const Clock::time_point t0;
+
+    CHECK(timeline.size() == 0);
+
+    const auto outer = timeline.begin("outer", nullptr, t0);
+    const auto first = timeline.begin("init", "a", t0 + std::chrono::milliseconds(1));
+    timeline.end(first, t0 + std::chrono::milliseconds(3));
+    const auto second = timeline.begin("init", "b", t0 + std::chrono::milliseconds(3));
+
+    const std::vector<std::string> expected_running {"outer*", "-init a", "-init b*"};
+    CHECK(collect(timeline) == expected_running);
+
+    timeline.end(second, t0 + std::chrono::milliseconds(7));
+    timeline.end(outer, t0 + std::chrono::milliseconds(8));
+
+    const std::vector<std::string> expected_done {"outer", "-init a", "-init b"};
+    CHECK(collect(timeline) == expected_done);
+
+    std::vector<long long> durations;
+    timeline.for_each(
+        [&durations] (const BootTimeline::Entry &e)
+        {
+            durations.push_back(
+                std::chrono::duration_cast<std::chrono::milliseconds>(e.end_ - e.begin_).count());
+        });
+
+    const std::vector<long long> expected_durations {8, 2, 4};
+    CHECK(durations == expected_durations);
+}
+
+TEST_CASE("Phases beyond capacity are dropped")
+{
+    BootTimeline::Timeline<4> timeline;
+    const Clock::time_point t0;
+    const size_t invalid_index = BootTimeline::Timeline<4>::INVALID_INDEX;
+
+    for(int i = 0; i < 3; ++i)
+        timeline.end(timeline.begin("phase", nullptr, t0), t0);
+
+    const auto outer = timeline.begin("outer", nullptr, t0);
+    const auto inner = timeline.begin("dropped", nullptr, t0);
+    CHECK(outer != invalid_index);
+    CHECK(inner == invalid_index);
+
+    timeline.end(inner, t0);
+    timeline.end(outer, t0);
+
+    const std::vector<std::string> expected {"phase", "phase", "phase", "outer"};
+    CHECK(timeline.size() == 4);
+    CHECK(collect(timeline) == expected);
+}
+
+TEST_SUITE_END();
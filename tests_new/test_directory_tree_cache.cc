@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <doctest.h>
+
+#include "directory_tree_cache.hh"
+
+#define MOCK_EXPECTATION_WITH_EXPECTATION_SEQUENCE_SINGLETON
+#include "mock_backtrace.hh"
+
+TEST_SUITE_BEGIN("Directory tree cache");
+
+std::shared_ptr<MockExpectationSequence> mock_expectation_sequence_singleton =
+    std::make_shared<MockExpectationSequence>();
+
+using Cache = Playlist::Crawler::DirectoryTreeCache;
+
+TEST_CASE("Child and parent lists can be looked up")
+{
+    Cache cache;
+    Cache::Child child;
+    ID::List parent;
+    unsigned int line;
+
+    CHECK_FALSE(cache.lookup_child(ID::List(1), 5, child));
+    CHECK_FALSE(cache.lookup_parent(ID::List(2), parent, line));
+
+    cache.put_child(ID::List(1), 5, ID::List(2));
+
+    REQUIRE(cache.lookup_child(ID::List(1), 5, child));
+    CHECK(child.list_id_ == ID::List(2));
+    CHECK_FALSE(child.is_size_known_);
+    CHECK_FALSE(cache.lookup_child(ID::List(1), 6, child));
+
+    REQUIRE(cache.lookup_parent(ID::List(2), parent, line));
+    CHECK(parent == ID::List(1));
+    CHECK(line == 5);
+
+    cache.put_size(ID::List(2), 17);
+    REQUIRE(cache.lookup_child(ID::List(1), 5, child));
+    CHECK(child.is_size_known_);
+    CHECK(child.number_of_items_ == 17);
+}
+
+TEST_CASE("Storing another child for the same line replaces the entry")
+{
+    Cache cache;
+    Cache::Child child;
+    ID::List parent;
+    unsigned int line;
+
+    cache.put_child(ID::List(1), 5, ID::List(2));
+    cache.put_child(ID::List(1), 5, ID::List(3));
+
+    CHECK(cache.size() == 1);
+    REQUIRE(cache.lookup_child(ID::List(1), 5, child));
+    CHECK(child.list_id_ == ID::List(3));
+    CHECK_FALSE(cache.lookup_parent(ID::List(2), parent, line));
+
+    /* list has moved to another line */
+    cache.put_child(ID::List(1), 7, ID::List(3));
+    CHECK(cache.size() == 1);
+    CHECK_FALSE(cache.lookup_child(ID::List(1), 5, child));
+    REQUIRE(cache.lookup_parent(ID::List(3), parent, line));
+    CHECK(line == 7);
+}
+
+TEST_CASE("Least recently used entries are evicted")
+{
+    Cache cache(3);
+    Cache::Child child;
+
+    cache.put_child(ID::List(1), 0, ID::List(10));
+    cache.put_child(ID::List(1), 1, ID::List(11));
+    cache.put_child(ID::List(1), 2, ID::List(12));
+
+    /* entry for line 0 is now most recently used */
+    CHECK(cache.lookup_child(ID::List(1), 0, child));
+
+    cache.put_child(ID::List(1), 3, ID::List(13));
+    CHECK(cache.size() == 3);
+    CHECK(cache.lookup_child(ID::List(1), 0, child));
+    CHECK_FALSE(cache.lookup_child(ID::List(1), 1, child));
+    CHECK(cache.lookup_child(ID::List(1), 2, child));
+    CHECK(cache.lookup_child(ID::List(1), 3, child));
+}
+
+TEST_CASE("Invalidated lists are removed or replaced")
+{
+    Cache cache;
+    Cache::Child child;
+    ID::List parent;
+    unsigned int line;
+
+    cache.put_child(ID::List(1), 0, ID::List(2));
+    cache.put_child(ID::List(2), 4, ID::List(3));
+    cache.put_child(ID::List(5), 0, ID::List(6));
+    cache.put_size(ID::List(3), 8);
+
+    cache.list_invalidate(ID::List(2), ID::List(20));
+    CHECK(cache.size() == 3);
+    REQUIRE(cache.lookup_child(ID::List(1), 0, child));
+    CHECK(child.list_id_ == ID::List(20));
+    REQUIRE(cache.lookup_child(ID::List(20), 4, child));
+    CHECK(child.list_id_ == ID::List(3));
+    CHECK(child.number_of_items_ == 8);
+    REQUIRE(cache.lookup_parent(ID::List(3), parent, line));
+    CHECK(parent == ID::List(20));
+    CHECK_FALSE(cache.lookup_parent(ID::List(2), parent, line));
+
+    cache.list_invalidate(ID::List(20), ID::List());
+    CHECK(cache.size() == 1);
+    CHECK_FALSE(cache.lookup_child(ID::List(1), 0, child));
+    CHECK_FALSE(cache.lookup_parent(ID::List(3), parent, line));
+    CHECK(cache.lookup_child(ID::List(5), 0, child));
+
+    cache.forget_child(ID::List(5), 0);
+    CHECK(cache.size() == 0);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <doctest.h>
+
+#include "dbuslist_item_cache.hh"
+
+#include <string>
+
+#define MOCK_EXPECTATION_WITH_EXPECTATION_SEQUENCE_SINGLETON
+#include "mock_backtrace.hh"
+
+TEST_SUITE_BEGIN("List item cache");
+
+std::shared_ptr<MockExpectationSequence> mock_expectation_sequence_singleton =
+    std::make_shared<MockExpectationSequence>();
+
+static List::Item *mk_item(const char *text)
+{
+    return new List::TextItem(text, false, 0);
+}
+
+static const char *text_of(const List::Item *item)
+{
+    return dynamic_cast<const List::TextItem *>(item)->get_text();
+}
+
+TEST_CASE("Inserted items can be looked up by list ID and line")
+{
+    List::DBusListItemCache cache;
+    const ID::List a(5);
+    const ID::List b(6);
+
+    cache.insert(a, 10, mk_item("a10"));
+    cache.insert(a, 11, mk_item("a11"));
+    cache.insert(b, 10, mk_item("b10"));
+
+    CHECK(cache.size() == 3);
+    CHECK(text_of(cache.lookup(a, 10)) == "a10");
+    CHECK(text_of(cache.lookup(a, 11)) == "a11");
+    CHECK(text_of(cache.lookup(b, 10)) == "b10");
+    CHECK(cache.lookup(a, 12) == nullptr);
+    CHECK(cache.lookup(ID::List(7), 10) == nullptr);
+    CHECK(cache.get_number_of_unreferenced_items() == 0);
+
+    cache.unref_segment(a, List::Segment(10, 2));
+    cache.unref_segment(b, List::Segment(10, 1));
+    CHECK(cache.size() == 3);
+    CHECK(cache.get_number_of_unreferenced_items() == 3);
+}
+
+TEST_CASE("Unreferenced items are kept in cache and can be referenced again")
+{
+    List::DBusListItemCache cache;
+    const ID::List id(1);
+
+    cache.insert(id, 0, mk_item("first"));
+    CHECK(cache.ref(id, 0));
+    CHECK_FALSE(cache.ref(id, 1));
+
+    cache.unref(id, 0);
+    CHECK(cache.get_number_of_unreferenced_items() == 0);
+
+    cache.unref(id, 0);
+    CHECK(cache.get_number_of_unreferenced_items() == 1);
+    REQUIRE(cache.lookup(id, 0) != nullptr);
+    CHECK(text_of(cache.lookup(id, 0)) == "first");
+
+    CHECK(cache.ref(id, 0));
+    CHECK(cache.get_number_of_unreferenced_items() == 0);
+    CHECK(cache.size() == 1);
+}
+
+TEST_CASE("Inserting an item for a cached line keeps the cached item")
+{
+    List::DBusListItemCache cache(0);
+    const ID::List id(1);
+
+    cache.insert(id, 3, mk_item("original"));
+    cache.insert(id, 3, mk_item("duplicate"));
+
+    CHECK(cache.size() == 1);
+    CHECK(text_of(cache.lookup(id, 3)) == "original");
+
+    cache.unref(id, 3);
+    CHECK(cache.size() == 1);
+    cache.unref(id, 3);
+    CHECK(cache.size() == 0);
+}
+
+TEST_CASE("Least recently used items are evicted when budget is exceeded")
+{
+    List::DBusListItemCache cache(3);
+    const ID::List id(2);
+
+    for(unsigned int line = 0; line < 5; ++line)
+        cache.insert(id, line, mk_item(std::to_string(line).c_str()));
+
+    /* released in order 0, 1, 2, 3, 4 */
+    for(unsigned int line = 0; line < 5; ++line)
+        cache.unref(id, line);
+
+    CHECK(cache.size() == 3);
+    CHECK(cache.lookup(id, 0) == nullptr);
+    CHECK(cache.lookup(id, 1) == nullptr);
+    REQUIRE(cache.lookup(id, 2) != nullptr);
+    REQUIRE(cache.lookup(id, 3) != nullptr);
+    REQUIRE(cache.lookup(id, 4) != nullptr);
+
+    /* referenced items do not count against the budget */
+    CHECK(cache.ref(id, 2));
+    cache.insert(id, 10, mk_item("10"));
+    cache.unref(id, 10);
+    CHECK(cache.size() == 4);
+    CHECK(cache.get_number_of_unreferenced_items() == 3);
+
+    /* item 2 is now most recently used */
+    cache.unref(id, 2);
+    CHECK(cache.lookup(id, 3) == nullptr);
+    CHECK(cache.lookup(id, 2) != nullptr);
+    CHECK(cache.lookup(id, 4) != nullptr);
+    CHECK(cache.lookup(id, 10) != nullptr);
+
+    cache.set_budget(1);
+    CHECK(cache.size() == 1);
+    REQUIRE(cache.lookup(id, 2) != nullptr);
+    CHECK(text_of(cache.lookup(id, 2)) == "2");
+}
+
+TEST_CASE("Stashed items are stored without taking a reference")
+{
+    List::DBusListItemCache cache(2);
+    const ID::List id(3);
+
+    cache.insert(id, 7, mk_item("referenced"));
+    cache.stash(id, 7, mk_item("ignored"));
+    cache.stash(id, 8, mk_item("stashed 8"));
+    cache.stash(id, 9, mk_item("stashed 9"));
+
+    CHECK(cache.size() == 3);
+    CHECK(cache.get_number_of_unreferenced_items() == 2);
+    CHECK(text_of(cache.lookup(id, 7)) == "referenced");
+
+    cache.stash_if_missing(id, 9,
+                           [] () -> List::Item * { FAIL("unexpected call"); return nullptr; });
+    cache.stash_if_missing(id, 10, [] { return mk_item("stashed 10"); });
+
+    CHECK(cache.size() == 3);
+    CHECK(cache.lookup(id, 8) == nullptr);
+    CHECK(text_of(cache.lookup(id, 10)) == "stashed 10");
+
+    cache.ref_or_insert(id, 9,
+                        [] () -> List::Item * { FAIL("unexpected call"); return nullptr; });
+    CHECK(cache.get_number_of_unreferenced_items() == 1);
+}
+
+TEST_CASE("Unreferenced items of invalidated lists can be dropped")
+{
+    List::DBusListItemCache cache;
+    const ID::List id(4);
+
+    cache.insert(id, 0, mk_item("in view"));
+    cache.stash(id, 1, mk_item("out of view"));
+    cache.stash(ID::List(5), 1, mk_item("other list"));
+
+    cache.forget_list(id);
+    CHECK(cache.size() == 2);
+    CHECK(cache.lookup(id, 0) != nullptr);
+    CHECK(cache.lookup(id, 1) == nullptr);
+    CHECK(cache.lookup(ID::List(5), 1) != nullptr);
+}
+
+TEST_CASE("Cached items can be moved over to replacement list")
+{
+    List::DBusListItemCache cache;
+    const ID::List old_id(20);
+    const ID::List new_id(21);
+
+    cache.insert(old_id, 0, mk_item("x"));
+    cache.stash(old_id, 1, mk_item("y"));
+    cache.rekey(old_id, new_id);
+
+    CHECK(cache.lookup(old_id, 0) == nullptr);
+    REQUIRE(cache.lookup(new_id, 0) != nullptr);
+    CHECK(text_of(cache.lookup(new_id, 0)) == "x");
+
+    cache.set_budget(0);
+    CHECK(cache.size() == 1);
+
+    cache.unref(new_id, 0);
+    CHECK(cache.size() == 0);
+}
+
+TEST_CASE("Scrolling through a list reuses bookkeeping slots of evicted items")
+{
+    List::DBusListItemCache cache(4);
+    const ID::List id(30);
+    static constexpr unsigned int view_size = 3;
+
+    for(unsigned int line = 0; line < view_size; ++line)
+        cache.insert(id, line, mk_item(std::to_string(line).c_str()));
+
+    size_t free_slots = 0;
+
+    /* scroll down line by line, dropping the top line and loading the line
+     * coming into view at the bottom */
+    for(unsigned int top = 0; top < 20; ++top)
+    {
+        cache.unref(id, top);
+        cache.insert(id, top + view_size,
+                     mk_item(std::to_string(top + view_size).c_str()));
+
+        CHECK(cache.size() <= 4 + view_size);
+
+        /* once the budget is exhausted, each step frees exactly the slots it
+         * takes, so no new slots are allocated */
+        if(top == 6)
+            free_slots = cache.get_number_of_free_slots();
+        else if(top > 6)
+            CHECK(cache.get_number_of_free_slots() == free_slots);
+    }
+
+    CHECK(free_slots > 0);
+    CHECK(cache.size() == 4 + view_size);
+    REQUIRE(cache.lookup(id, 22) != nullptr);
+    CHECK(text_of(cache.lookup(id, 22)) == "22");
+}
+
+TEST_CASE("Deallocated pool slots are reused by allocations of the same size")
+{
+    SlotPool pool;
+
+    void *a = pool.allocate(32);
+    void *b = pool.allocate(48);
+    CHECK(pool.get_number_of_free_slots() == 0);
+
+    pool.deallocate(a, 32);
+    pool.deallocate(b, 48);
+    CHECK(pool.get_number_of_free_slots() == 2);
+
+    CHECK(pool.allocate(48) == b);
+    CHECK(pool.allocate(32) == a);
+    CHECK(pool.get_number_of_free_slots() == 0);
+
+    pool.deallocate(a, 32);
+    pool.deallocate(b, 48);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <doctest.h>
+
+#include "list_readahead.hh"
+
+TEST_SUITE_BEGIN("List read-ahead");
+
+static constexpr unsigned int PAGE_SIZE = 10;
+static constexpr unsigned int TOTAL = 1000;
+
+static bool segment_equals(const List::Segment &s,
+                           unsigned int line, unsigned int size)
+{
+    return s.line() == line && s.size() == size;
+}
+
+TEST_CASE("Nothing is read ahead before the cursor moves")
+{
+    List::ReadAheadPolicy policy;
+
+    CHECK(policy.update(0, 0, PAGE_SIZE, TOTAL).empty());
+    CHECK(policy.update(0, 0, PAGE_SIZE, TOTAL).empty());
+}
+
+TEST_CASE("Moving down reads ahead more pages the longer the cursor moves")
+{
+    List::ReadAheadPolicy policy(3);
+
+    CHECK(policy.update(0, 0, PAGE_SIZE, TOTAL).empty());
+    CHECK(segment_equals(policy.update(1, 0, PAGE_SIZE, TOTAL), 10, 10));
+    CHECK(segment_equals(policy.update(2, 0, PAGE_SIZE, TOTAL), 10, 20));
+    CHECK(segment_equals(policy.update(3, 0, PAGE_SIZE, TOTAL), 10, 30));
+    CHECK(segment_equals(policy.update(4, 0, PAGE_SIZE, TOTAL), 10, 30));
+
+    /* no movement, same suggestion */
+    CHECK(segment_equals(policy.update(4, 0, PAGE_SIZE, TOTAL), 10, 30));
+
+    /* displayed page follows the cursor */
+    CHECK(segment_equals(policy.update(10, 1, PAGE_SIZE, TOTAL), 11, 30));
+}
+
+TEST_CASE("Moving up reads ahead pages above displayed page")
+{
+    List::ReadAheadPolicy policy(2);
+
+    CHECK(policy.update(500, 495, PAGE_SIZE, TOTAL).empty());
+    CHECK(segment_equals(policy.update(499, 495, PAGE_SIZE, TOTAL), 485, 10));
+    CHECK(segment_equals(policy.update(498, 495, PAGE_SIZE, TOTAL), 475, 20));
+    CHECK(segment_equals(policy.update(497, 495, PAGE_SIZE, TOTAL), 475, 20));
+}
+
+TEST_CASE("Changing direction starts over with a single page")
+{
+    List::ReadAheadPolicy policy(3);
+
+    policy.update(100, 100, PAGE_SIZE, TOTAL);
+    policy.update(101, 100, PAGE_SIZE, TOTAL);
+    CHECK(segment_equals(policy.update(102, 100, PAGE_SIZE, TOTAL), 110, 20));
+    CHECK(segment_equals(policy.update(101, 100, PAGE_SIZE, TOTAL), 90, 10));
+    CHECK(segment_equals(policy.update(102, 100, PAGE_SIZE, TOTAL), 110, 10));
+}
+
+TEST_CASE("Scrolling by pages reads ahead multiple pages right away")
+{
+    List::ReadAheadPolicy policy(4);
+
+    policy.update(0, 0, PAGE_SIZE, TOTAL);
+    CHECK(segment_equals(policy.update(20, 20, PAGE_SIZE, TOTAL), 30, 20));
+    CHECK(segment_equals(policy.update(40, 40, PAGE_SIZE, TOTAL), 50, 40));
+}
+
+TEST_CASE("Read-ahead segments are clipped to list boundaries")
+{
+    List::ReadAheadPolicy policy(3);
+
+    policy.update(980, 975, PAGE_SIZE, TOTAL);
+    policy.update(981, 975, PAGE_SIZE, TOTAL);
+    CHECK(segment_equals(policy.update(982, 975, PAGE_SIZE, TOTAL), 985, 15));
+    CHECK(policy.update(999, 990, PAGE_SIZE, TOTAL).empty());
+
+    policy.reset();
+    policy.update(10, 5, PAGE_SIZE, TOTAL);
+    policy.update(9, 5, PAGE_SIZE, TOTAL);
+    CHECK(segment_equals(policy.update(8, 5, PAGE_SIZE, TOTAL), 0, 5));
+    CHECK(policy.update(0, 0, PAGE_SIZE, TOTAL).empty());
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,308 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <doctest.h>
+
+#include "player_push_batch.hh"
+
+#include <deque>
+#include <algorithm>
+
+#define MOCK_EXPECTATION_WITH_EXPECTATION_SEQUENCE_SINGLETON
+#include "mock_backtrace.hh"
+
+TEST_SUITE_BEGIN("Player push batch");
+
+std::shared_ptr<MockExpectationSequence> mock_expectation_sequence_singleton =
+    std::make_shared<MockExpectationSequence>();
+
+/*!
+ * Simplified stream player URL FIFO.
+ *
+ * Pushes are answered immediately, but the answers are kept back until the
+ * test delivers them to the batch, just like D-Bus answers which are received
+ * some time after the pushes have been sent.
+ */
+class MockStreamPlayer
+{
+  public:
+    struct PendingAnswer
+    {
+        size_t index_;
+        Player::PushBatch::Answer answer_;
+    };
+
+  private:
+    const size_t capacity_;
+    std::deque<ID::Stream> fifo_;
+    bool is_playing_;
+
+  public:
+    std::deque<PendingAnswer> answers_;
+
+    explicit MockStreamPlayer(size_t capacity, bool is_playing = false):
+        capacity_(capacity),
+        is_playing_(is_playing)
+    {}
+
+    void push(Player::PushBatch &batch, ID::OurStream stream_id,
+              bool keep_queue = true, bool fail = false,
+              std::function<void()> &&rejected_fn = nullptr)
+    {
+        const size_t idx = batch.add(stream_id, std::move(rejected_fn));
+
+        if(fail)
+        {
+            answers_.push_back({idx, Player::PushBatch::Answer()});
+            return;
+        }
+
+        std::vector<ID::Stream> dropped;
+
+        if(!keep_queue)
+        {
+            dropped.assign(fifo_.begin(), fifo_.end());
+            fifo_.clear();
+        }
+
+        const bool is_overflow = fifo_.size() >= capacity_;
+
+        if(!is_overflow)
+            fifo_.push_back(stream_id.get());
+
+        answers_.push_back({idx, Player::PushBatch::Answer(is_overflow, is_playing_,
+                                                           std::move(dropped))});
+    }
+
+    bool deliver_next(Player::PushBatch &batch)
+    {
+        CHECK_FALSE(answers_.empty());
+
+        if(answers_.empty())
+            return false;
+
+        auto a(std::move(answers_.front()));
+        answers_.pop_front();
+        return batch.answer(a.index_, std::move(a.answer_));
+    }
+
+    void start_playing() { is_playing_ = true; }
+};
+
+static std::vector<ID::OurStream> mk_ids(size_t count)
+{
+    std::vector<ID::OurStream> result;
+    auto id(ID::OurStream::make());
+
+    for(size_t i = 0; i < count; ++i)
+    {
+        result.push_back(id);
+        ++id;
+    }
+
+    return result;
+}
+
+TEST_CASE("Batch is complete after it has been sealed and all answers are in")
+{
+    MockStreamPlayer player(20);
+    Player::PushBatch batch;
+    const auto ids(mk_ids(3));
+
+    CHECK(batch.empty());
+
+    for(const auto &id : ids)
+        player.push(batch, id);
+
+    CHECK(batch.size() == 3);
+    CHECK_FALSE(player.deliver_next(batch));
+    CHECK_FALSE(player.deliver_next(batch));
+    CHECK_FALSE(player.deliver_next(batch));
+    CHECK_FALSE(batch.is_complete());
+
+    CHECK(batch.seal());
+
+    const auto result(batch.take_result());
+    CHECK(result.accepted_ == ids);
+    CHECK(result.rejected_.empty());
+    CHECK(result.dropped_.empty());
+    CHECK_FALSE(result.is_playing_);
+}
+
+TEST_CASE("Last answer completes a sealed batch")
+{
+    MockStreamPlayer player(20, true);
+    Player::PushBatch batch;
+    const auto ids(mk_ids(2));
+
+    player.push(batch, ids[0]);
+    player.push(batch, ids[1]);
+
+    CHECK_FALSE(batch.seal());
+    CHECK_FALSE(player.deliver_next(batch));
+    CHECK(player.deliver_next(batch));
+
+    const auto result(batch.take_result());
+    CHECK(result.accepted_ == ids);
+    CHECK(result.is_playing_);
+}
+
+TEST_CASE("Dropped streams of all answers are merged in push order")
+{
+    MockStreamPlayer player(20);
+    const auto ids(mk_ids(5));
+
+    Player::PushBatch first;
+    player.push(first, ids[0]);
+    player.push(first, ids[1]);
+    first.seal();
+    player.deliver_next(first);
+    player.deliver_next(first);
+
+    Player::PushBatch second;
+    player.push(second, ids[2], false);
+    player.push(second, ids[3]);
+    player.push(second, ids[4], false);
+    second.seal();
+    player.deliver_next(second);
+    player.deliver_next(second);
+    REQUIRE(player.deliver_next(second));
+
+    const auto result(second.take_result());
+
+    const std::vector<ID::Stream> expected_dropped
+    {
+        ids[0].get(), ids[1].get(), ids[2].get(), ids[3].get(),
+    };
+    const std::vector<ID::OurStream> expected_accepted
+    {
+        ids[2], ids[3], ids[4],
+    };
+
+    CHECK(result.dropped_ == expected_dropped);
+    CHECK(result.accepted_ == expected_accepted);
+    CHECK(result.rejected_.empty());
+}
+
+TEST_CASE("Failed and overflowing pushes are rejected")
+{
+    MockStreamPlayer player(2);
+    Player::PushBatch batch;
+    const auto ids(mk_ids(4));
+
+    player.push(batch, ids[0]);
+    player.push(batch, ids[1], true, true);
+    player.push(batch, ids[2]);
+    player.start_playing();
+    player.push(batch, ids[3]);
+    batch.seal();
+
+    while(!player.answers_.empty())
+        player.deliver_next(batch);
+
+    REQUIRE(batch.is_complete());
+
+    const auto result(batch.take_result());
+
+    const std::vector<ID::OurStream> expected_accepted{ids[0], ids[2]};
+    const std::vector<ID::OurStream> expected_rejected{ids[1], ids[3]};
+
+    CHECK(result.accepted_ == expected_accepted);
+    CHECK(result.rejected_ == expected_rejected);
+
+    /* the only answer reporting playback is from a rejected push */
+    CHECK_FALSE(result.is_playing_);
+}
+
+TEST_CASE("Rejection handlers are returned for rejected pushes only")
+{
+    MockStreamPlayer player(1);
+    Player::PushBatch batch;
+    const auto ids(mk_ids(4));
+    std::vector<ID::OurStream> handled;
+
+    const auto mk_handler =
+        [&handled] (ID::OurStream id)
+        {
+            return [&handled, id] { handled.push_back(id); };
+        };
+
+    player.push(batch, ids[0], true, false, mk_handler(ids[0]));
+    player.push(batch, ids[1], true, true, mk_handler(ids[1]));
+    player.push(batch, ids[2], true, true);
+    player.push(batch, ids[3], true, false, mk_handler(ids[3]));
+    batch.seal();
+
+    while(!player.answers_.empty())
+        player.deliver_next(batch);
+
+    REQUIRE(batch.is_complete());
+
+    const auto result(batch.take_result());
+
+    const std::vector<ID::OurStream> expected_rejected{ids[1], ids[2], ids[3]};
+    CHECK(result.accepted_ == std::vector<ID::OurStream>{ids[0]});
+    CHECK(result.rejected_ == expected_rejected);
+    REQUIRE(result.rejected_fns_.size() == 2);
+
+    for(const auto &fn : result.rejected_fns_)
+        fn();
+
+    /* failed push and overflowing push, not the accepted one */
+    const std::vector<ID::OurStream> expected_handled{ids[1], ids[3]};
+    CHECK(handled == expected_handled);
+}
+
+TEST_CASE("Streams of incomplete batch are told apart by their answers")
+{
+    MockStreamPlayer player(20);
+    Player::PushBatch batch;
+    const auto ids(mk_ids(4));
+
+    player.push(batch, ids[0], true, true);
+    player.push(batch, ids[1]);
+    player.push(batch, ids[2]);
+    player.push(batch, ids[3]);
+    batch.seal();
+    player.deliver_next(batch);
+    player.deliver_next(batch);
+    player.deliver_next(batch);
+
+    std::vector<ID::OurStream> accepted;
+    batch.for_each_accepted(
+        [&accepted] (ID::OurStream id) { accepted.push_back(id); });
+
+    std::vector<ID::OurStream> not_accepted;
+    batch.for_each_not_accepted(
+        [&not_accepted] (ID::OurStream id) { not_accepted.push_back(id); });
+
+    /* unanswered streams are not considered accepted */
+    const std::vector<ID::OurStream> expected_accepted{ids[1], ids[2]};
+    const std::vector<ID::OurStream> expected_not_accepted{ids[0], ids[3]};
+    CHECK(accepted == expected_accepted);
+    CHECK(not_accepted == expected_not_accepted);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <doctest.h>
+
+#include "referenced_lists.hh"
+
+#include <vector>
+
+#define MOCK_EXPECTATION_WITH_EXPECTATION_SEQUENCE_SINGLETON
+#include "mock_backtrace.hh"
+
+TEST_SUITE_BEGIN("Referenced lists");
+
+std::shared_ptr<MockExpectationSequence> mock_expectation_sequence_singleton =
+    std::make_shared<MockExpectationSequence>();
+
+static std::vector<ID::List> to_vector(const List::ReferencedLists &lists)
+{
+    std::vector<ID::List> result;
+    lists.for_each([&result] (ID::List id) { result.push_back(id); });
+    return result;
+}
+
+TEST_CASE("Lists are kept until the last reference is dropped")
+{
+    List::ReferencedLists lists;
+    const ID::List a(5);
+    const ID::List b(9);
+
+    CHECK(lists.empty());
+    const auto gen0 = lists.get_generation();
+
+    lists.ref(a);
+    lists.ref(b);
+    lists.ref(a);
+    CHECK(lists.size() == 2);
+    CHECK(lists.contains(a));
+    CHECK(lists.contains(b));
+
+    const auto gen1 = lists.get_generation();
+    CHECK(gen1 != gen0);
+
+    lists.unref(a);
+    CHECK(lists.contains(a));
+    CHECK(lists.get_generation() == gen1);
+
+    lists.unref(a);
+    CHECK_FALSE(lists.contains(a));
+    CHECK(lists.get_generation() != gen1);
+    CHECK(to_vector(lists) == std::vector<ID::List>{b});
+}
+
+TEST_CASE("Invalid and unknown list IDs are ignored")
+{
+    List::ReferencedLists lists;
+    const auto gen = lists.get_generation();
+
+    lists.ref(ID::List());
+    lists.unref(ID::List(3));
+
+    CHECK(lists.empty());
+    CHECK(lists.get_generation() == gen);
+}
+
+TEST_CASE("Exchanging list IDs keeps lists referenced elsewhere")
+{
+    List::ReferencedLists lists;
+    const ID::List a(1);
+    const ID::List b(2);
+
+    lists.ref(a);
+    lists.exchange(ID::List(), a);
+    CHECK(lists.size() == 1);
+
+    const auto gen = lists.get_generation();
+    lists.exchange(a, a);
+    CHECK(lists.get_generation() == gen);
+
+    lists.exchange(a, b);
+    CHECK(lists.contains(a));
+    CHECK(lists.contains(b));
+
+    lists.exchange(a, ID::List());
+    CHECK(to_vector(lists) == std::vector<ID::List>{b});
+
+    lists.clear();
+    CHECK(lists.empty());
+    CHECK(lists.get_generation() != gen);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <doctest.h>
+
+#include "render_trace.hh"
+
+#include <vector>
+#include <string>
+
+TEST_SUITE_BEGIN("Render trace");
+
+static std::vector<uint32_t> collect_a(const RenderTrace::Ring<4> &ring)
+{
+    std::vector<uint32_t> result;
+    ring.for_each([&result] (const RenderTrace::Event &ev) { result.push_back(ev.a_); });
+    return result;
+}
+
+TEST_CASE("Events are stored in order")
+{
+    RenderTrace::Ring<4> ring;
+
+    CHECK(ring.size() == 0);
+    CHECK(collect_a(ring).empty());
+
+    ring.add("view", RenderTrace::What::SCREEN_BEGIN, 10, 2, nullptr);
+    ring.add("view", RenderTrace::What::LINE, 0, 1, "ds");
+
+    REQUIRE(ring.size() == 2);
+
+    std::vector<RenderTrace::What> whats;
+    std::vector<std::string> flags;
+    ring.for_each(
+        [&whats, &flags] (const RenderTrace::Event &ev)
+        {
+            whats.push_back(ev.what_);
+            flags.push_back(ev.flags_);
+        });
+
+    const std::vector<RenderTrace::What> expected_whats
+    {
+        RenderTrace::What::SCREEN_BEGIN, RenderTrace::What::LINE,
+    };
+    const std::vector<std::string> expected_flags {"", "ds"};
+
+    CHECK(whats == expected_whats);
+    CHECK(flags == expected_flags);
+}
+
+TEST_CASE("Oldest events are overwritten when the ring is full")
+{
+    RenderTrace::Ring<4> ring;
+
+    for(uint32_t i = 0; i < 6; ++i)
+        ring.add("view", RenderTrace::What::LINE, i, 0, nullptr);
+
+    CHECK(ring.size() == 4);
+
+    const std::vector<uint32_t> expected {2, 3, 4, 5};
+    CHECK(collect_a(ring) == expected);
+
+    ring.clear();
+    CHECK(ring.size() == 0);
+
+    ring.add("view", RenderTrace::What::LINE, 7, 0, nullptr);
+    const std::vector<uint32_t> expected_after_clear {7};
+    CHECK(collect_a(ring) == expected_after_clear);
+}
+
+TEST_CASE("Long flag strings are truncated")
+{
+    RenderTrace::Ring<4> ring;
+
+    ring.add("view", RenderTrace::What::LINE, 0, 0, "abcdefghij");
+
+    ring.for_each(
+        [] (const RenderTrace::Event &ev) { CHECK(std::string(ev.flags_) == "abcdef"); });
+}
+
+TEST_SUITE_END();
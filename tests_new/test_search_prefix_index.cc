@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <doctest.h>
+
+#include "search_prefix_index.hh"
+
+#include <cstring>
+
+#define MOCK_EXPECTATION_WITH_EXPECTATION_SEQUENCE_SINGLETON
+#include "mock_backtrace.hh"
+
+TEST_SUITE_BEGIN("Search prefix index");
+
+std::shared_ptr<MockExpectationSequence> mock_expectation_sequence_singleton =
+    std::make_shared<MockExpectationSequence>();
+
+/* ASCII strings are their own code points for our purposes */
+static std::vector<uint32_t> cps(const char *s)
+{
+    return std::vector<uint32_t>(s, s + strlen(s));
+}
+
+static void put(Search::PrefixIndex &idx, ID::List id, unsigned int total,
+                unsigned int line, const char *s)
+{
+    const auto c(cps(s));
+    idx.put(id, total, line, c.data(), c.size());
+}
+
+static Search::PrefixIndex::LookupResult
+lookup(const Search::PrefixIndex &idx, ID::List id, unsigned int total,
+       const char *q, ssize_t &line)
+{
+    const auto c(cps(q));
+    return idx.lookup(id, total, c.data(), c.size(), line);
+}
+
+static const char *const sorted_names[] =
+{
+    "abba", "ac/dc", "b", "beatles", "beck", "bjork", "cure", "zappa",
+};
+
+static constexpr unsigned int NUM_NAMES =
+    sizeof(sorted_names) / sizeof(sorted_names[0]);
+
+TEST_CASE("Lookup is only possible after all lines have been indexed")
+{
+    Search::PrefixIndex idx;
+    const ID::List id(7);
+    ssize_t line = -1;
+
+    CHECK(lookup(idx, id, NUM_NAMES, "b", line) ==
+          Search::PrefixIndex::LookupResult::NOT_INDEXED);
+
+    for(unsigned int i = NUM_NAMES; i-- > 1;)
+        put(idx, id, NUM_NAMES, i, sorted_names[i]);
+
+    CHECK(idx.get_number_of_known_lines() == NUM_NAMES - 1);
+    CHECK(lookup(idx, id, NUM_NAMES, "b", line) ==
+          Search::PrefixIndex::LookupResult::INCOMPLETE);
+
+    put(idx, id, NUM_NAMES, 0, sorted_names[0]);
+    REQUIRE(lookup(idx, id, NUM_NAMES, "b", line) ==
+            Search::PrefixIndex::LookupResult::FOUND);
+    CHECK(line == 2);
+
+    CHECK(lookup(idx, ID::List(8), NUM_NAMES, "b", line) ==
+          Search::PrefixIndex::LookupResult::NOT_INDEXED);
+}
+
+TEST_CASE("Lookup finds first line greater than or equal to query")
+{
+    Search::PrefixIndex idx;
+    const ID::List id(7);
+
+    for(unsigned int i = 0; i < NUM_NAMES; ++i)
+        put(idx, id, NUM_NAMES, i, sorted_names[i]);
+
+    ssize_t line = -1;
+
+    REQUIRE(lookup(idx, id, NUM_NAMES, "a", line) == Search::PrefixIndex::LookupResult::FOUND);
+    CHECK(line == 0);
+    REQUIRE(lookup(idx, id, NUM_NAMES, "ac", line) == Search::PrefixIndex::LookupResult::FOUND);
+    CHECK(line == 1);
+    REQUIRE(lookup(idx, id, NUM_NAMES, "bec", line) == Search::PrefixIndex::LookupResult::FOUND);
+    CHECK(line == 4);
+    REQUIRE(lookup(idx, id, NUM_NAMES, "bj", line) == Search::PrefixIndex::LookupResult::FOUND);
+    CHECK(line == 5);
+    REQUIRE(lookup(idx, id, NUM_NAMES, "d", line) == Search::PrefixIndex::LookupResult::FOUND);
+    CHECK(line == 7);
+    REQUIRE(lookup(idx, id, NUM_NAMES, "zz", line) == Search::PrefixIndex::LookupResult::FOUND);
+    CHECK(line == 7);
+
+    CHECK(lookup(idx, id, NUM_NAMES, "beatl", line) ==
+          Search::PrefixIndex::LookupResult::QUERY_TOO_LONG);
+}
+
+TEST_CASE("Approximate matches stay inside the partition matched so far")
+{
+    Search::PrefixIndex idx;
+    const ID::List id(7);
+
+    for(unsigned int i = 0; i < NUM_NAMES; ++i)
+        put(idx, id, NUM_NAMES, i, sorted_names[i]);
+
+    /* results as determined by Search::binary_search_utf8(): the last line
+     * of the partition if all lines in it are smaller, otherwise the first
+     * line with a greater character */
+    static const struct
+    {
+        const char *query;
+        ssize_t expected_line;
+    }
+    expectations[] =
+    {
+        { "bz",   5, },     /* "bjork", not "cure" */
+        { "ba",   3, },     /* "beatles", "b" ends before */
+        { "bea",  3, },
+        { "beb",  4, },     /* "beck" */
+        { "bez",  4, },     /* "beck", not "bjork" */
+        { "abz",  0, },     /* "abba", not "ac/dc" */
+        { "acz",  1, },
+        { "c",    6, },
+        { "cz",   6, },     /* "cure", not "zappa" */
+        { "e",    7, },
+        { "zb",   7, },
+        { "0",    0, },
+        { "bj0",  5, },
+    };
+
+    for(const auto &e : expectations)
+    {
+        ssize_t line = -1;
+
+        CAPTURE(e.query);
+        REQUIRE(lookup(idx, id, NUM_NAMES, e.query, line) ==
+                Search::PrefixIndex::LookupResult::FOUND);
+        CHECK(line == e.expected_line);
+    }
+}
+
+TEST_CASE("Unsorted lists are detected")
+{
+    Search::PrefixIndex idx;
+    const ID::List id(3);
+
+    put(idx, id, 3, 0, "b");
+    put(idx, id, 3, 1, "a");
+    put(idx, id, 3, 2, "c");
+
+    ssize_t line = -1;
+    CHECK(lookup(idx, id, 3, "a", line) ==
+          Search::PrefixIndex::LookupResult::UNSORTED);
+}
+
+TEST_CASE("Index follows list replacement and invalidation")
+{
+    Search::PrefixIndex idx;
+    const ID::List old_id(10);
+    const ID::List new_id(11);
+
+    put(idx, old_id, 2, 0, "x");
+    put(idx, old_id, 2, 1, "y");
+    idx.rekey(old_id, new_id);
+
+    ssize_t line = -1;
+    REQUIRE(lookup(idx, new_id, 2, "y", line) ==
+            Search::PrefixIndex::LookupResult::FOUND);
+    CHECK(line == 1);
+
+    idx.forget_list(new_id);
+    CHECK(idx.get_number_of_known_lines() == 0);
+    CHECK(lookup(idx, new_id, 2, "y", line) ==
+          Search::PrefixIndex::LookupResult::NOT_INDEXED);
+
+    /* changed list size resets the index */
+    put(idx, new_id, 2, 0, "x");
+    put(idx, new_id, 3, 1, "y");
+    CHECK(idx.get_number_of_known_lines() == 1);
+}
+
+TEST_CASE("Lists longer than the configured maximum are not indexed")
+{
+    Search::PrefixIndex idx(4, 2);
+    const ID::List id(1);
+
+    put(idx, id, 3, 0, "a");
+    put(idx, id, 3, 1, "b");
+    put(idx, id, 3, 2, "c");
+
+    ssize_t line = -1;
+    CHECK(idx.get_number_of_known_lines() == 0);
+    CHECK(lookup(idx, id, 3, "a", line) ==
+          Search::PrefixIndex::LookupResult::NOT_INDEXED);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <doctest.h>
+
+#include "shuffle_permutation.hh"
+
+#include <vector>
+
+TEST_SUITE_BEGIN("Shuffle permutation");
+
+static void check_is_permutation(uint32_t size, uint64_t seed)
+{
+    const Playlist::Crawler::ShufflePermutation perm(size, seed);
+    std::vector<bool> seen(size, false);
+
+    for(uint32_t pos = 0; pos < size; ++pos)
+    {
+        const uint32_t element = perm(pos);
+
+        REQUIRE(element < size);
+        CHECK_FALSE(seen[element]);
+        seen[element] = true;
+        CHECK(perm.inverse(element) == pos);
+    }
+}
+
+TEST_CASE("Each element occurs exactly once in shuffled sequence")
+{
+    for(uint32_t size = 0; size <= 70; ++size)
+        check_is_permutation(size, 42);
+
+    check_is_permutation(1000, 1);
+    check_is_permutation(4096, 2);
+    check_is_permutation(65537, 3);
+}
+
+TEST_CASE("Shuffled sequence is determined by its seed")
+{
+    const Playlist::Crawler::ShufflePermutation a(500, 0x1234);
+    const Playlist::Crawler::ShufflePermutation b(500, 0x1234);
+    const Playlist::Crawler::ShufflePermutation c(500, 0x1235);
+
+    unsigned int differences = 0;
+    unsigned int fixed_points = 0;
+
+    for(uint32_t pos = 0; pos < 500; ++pos)
+    {
+        CHECK(a(pos) == b(pos));
+
+        if(a(pos) != c(pos))
+            ++differences;
+
+        if(a(pos) == pos)
+            ++fixed_points;
+    }
+
+    CHECK(differences > 400);
+    CHECK(fixed_points < 20);
+}
+
+TEST_CASE("Derived seeds differ for different values")
+{
+    using Perm = Playlist::Crawler::ShufflePermutation;
+
+    CHECK(Perm::derive_seed(7, 0) != Perm::derive_seed(7, 1));
+    CHECK(Perm::derive_seed(7, 0) != Perm::derive_seed(8, 0));
+    CHECK(Perm::derive_seed(7, 0) == Perm::derive_seed(7, 0));
+}
+
+TEST_CASE("Positions out of range are mapped to themselves")
+{
+    const Playlist::Crawler::ShufflePermutation perm(10, 99);
+
+    CHECK(perm(10) == 10);
+    CHECK(perm.inverse(12) == 12);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2026  T+A elektroakustik GmbH & Co. KG
+ *
+ * This file is part of DRCPD.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA  02110-1301, USA.
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <doctest.h>
+
+#include "ui_event_queue.hh"
+
+#include <vector>
+#include <climits>
+
+#define MOCK_EXPECTATION_WITH_EXPECTATION_SEQUENCE_SINGLETON
+#include "mock_backtrace.hh"
+
+TEST_SUITE_BEGIN("UI event queue");
+
+std::shared_ptr<MockExpectationSequence> mock_expectation_sequence_singleton =
+    std::make_shared<MockExpectationSequence>();
+
+using Param = UI::SpecificParameters<unsigned int>;
+
+static std::unique_ptr<UI::Parameters> mk_param(unsigned int value)
+{
+    return std::make_unique<Param>(std::move(value));
+}
+
+static unsigned int value_of(const UI::EventQueue::Event &ev)
+{
+    const auto *p = dynamic_cast<const Param *>(ev.parameters_.get());
+    return p != nullptr ? p->get_specific() : UINT_MAX;
+}
+
+TEST_CASE("Events are taken out in order of posting")
+{
+    unsigned int triggers = 0;
+    UI::EventQueue queue([&triggers] { ++triggers; }, 4);
+
+    CHECK(queue.get_capacity() == 4);
+
+    queue.post(UI::EventID::NAV_SCROLL_LINES, mk_param(1));
+    CHECK(triggers == 1);
+    queue.post(UI::EventID::NAV_SCROLL_PAGES, mk_param(2));
+    queue.post(UI::EventID::NAV_SELECT_ITEM, nullptr);
+    CHECK(triggers == 1);
+
+    std::vector<UI::EventID> ids;
+    std::vector<unsigned int> values;
+
+    CHECK(queue.take_all(
+        [&ids, &values] (UI::EventQueue::Event &&ev)
+        {
+            ids.push_back(ev.event_id_);
+            values.push_back(ev.parameters_ != nullptr ? value_of(ev) : 0);
+        }) == 3);
+
+    const std::vector<UI::EventID> expected_ids
+    {
+        UI::EventID::NAV_SCROLL_LINES,
+        UI::EventID::NAV_SCROLL_PAGES,
+        UI::EventID::NAV_SELECT_ITEM,
+    };
+    const std::vector<unsigned int> expected_values {1, 2, 0};
+
+    CHECK(ids == expected_ids);
+    CHECK(values == expected_values);
+
+    CHECK(queue.take_all([] (UI::EventQueue::Event &&) { FAIL("unexpected event"); }) == 0);
+
+    /* queue has been drained, so the next event triggers processing again */
+    queue.post(UI::EventID::NAV_SELECT_ITEM, nullptr);
+    CHECK(triggers == 2);
+}
+
+TEST_CASE("Events posted while processing are processed in same run")
+{
+    UI::EventQueue queue([] {}, 4);
+    std::vector<unsigned int> values;
+
+    queue.post(UI::EventID::NAV_SCROLL_LINES, mk_param(0));
+
+    CHECK(queue.take_all(
+        [&queue, &values] (UI::EventQueue::Event &&ev)
+        {
+            const unsigned int v = value_of(ev);
+            values.push_back(v);
+
+            if(v < 5)
+                queue.post(UI::EventID::NAV_SCROLL_LINES, mk_param(v + 1));
+        }) == 6);
+
+    const std::vector<unsigned int> expected {0, 1, 2, 3, 4, 5};
+    CHECK(values == expected);
+    CHECK(queue.take_all([] (UI::EventQueue::Event &&) { FAIL("unexpected event"); }) == 0);
+}
+
+TEST_CASE("Events exceeding the capacity are kept in order")
+{
+    unsigned int triggers = 0;
+    UI::EventQueue queue([&triggers] { ++triggers; }, 4);
+
+    for(unsigned int i = 0; i < 10; ++i)
+        queue.post(UI::EventID::NAV_SCROLL_LINES, mk_param(i));
+
+    CHECK(triggers == 1);
+
+    std::vector<unsigned int> values;
+    CHECK(queue.take_all(
+        [&values] (UI::EventQueue::Event &&ev) { values.push_back(value_of(ev)); }) == 10);
+    const std::vector<unsigned int> expected_first {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    CHECK(values == expected_first);
+
+    /* ring buffer is used again after overflow has been drained */
+    queue.post(UI::EventID::NAV_SCROLL_LINES, mk_param(10));
+    queue.post(UI::EventID::NAV_SCROLL_LINES, mk_param(11));
+    CHECK(triggers == 2);
+
+    values.clear();
+    CHECK(queue.take_all(
+        [&values] (UI::EventQueue::Event &&ev) { values.push_back(value_of(ev)); }) == 2);
+    const std::vector<unsigned int> expected_second {10, 11};
+    CHECK(values == expected_second);
+}
+
+TEST_CASE("Consecutive events can be merged without reordering other events")
+{
+    UI::EventQueue queue([] {}, 8);
+
+    queue.post(UI::EventID::NAV_SCROLL_LINES, mk_param(1));
+    queue.post(UI::EventID::NAV_SCROLL_LINES, mk_param(2));
+    queue.post(UI::EventID::NAV_SCROLL_LINES, mk_param(3));
+    queue.post(UI::EventID::NAV_SELECT_ITEM, nullptr);
+    queue.post(UI::EventID::NAV_SCROLL_LINES, mk_param(4));
+    queue.post(UI::EventID::NAV_SCROLL_PAGES, mk_param(5));
+    queue.post(UI::EventID::NAV_SCROLL_PAGES, mk_param(6));
+
+    std::vector<UI::EventID> ids;
+    std::vector<unsigned int> values;
+
+    const auto merge_sums =
+        [] (UI::EventQueue::Event &held, UI::EventQueue::Event &next)
+        {
+            if(held.event_id_ != next.event_id_ || held.parameters_ == nullptr)
+                return false;
+
+            auto *h = dynamic_cast<Param *>(held.parameters_.get());
+            h->get_specific_non_const() += value_of(next);
+            return true;
+        };
+
+    CHECK(queue.take_all(
+        [&ids, &values] (UI::EventQueue::Event &&ev)
+        {
+            ids.push_back(ev.event_id_);
+            values.push_back(ev.parameters_ != nullptr ? value_of(ev) : 0);
+        },
+        merge_sums) == 4);
+
+    const std::vector<UI::EventID> expected_ids
+    {
+        UI::EventID::NAV_SCROLL_LINES,
+        UI::EventID::NAV_SELECT_ITEM,
+        UI::EventID::NAV_SCROLL_LINES,
+        UI::EventID::NAV_SCROLL_PAGES,
+    };
+    const std::vector<unsigned int> expected_values {6, 0, 4, 11};
+
+    CHECK(ids == expected_ids);
+    CHECK(values == expected_values);
+}
+
+/*
+ * Scroll requests sent to the player view switch back to the browser view,
+ * so only the first request is consumed by the player view. The remaining
+ * requests must reach the browser view, so they must not be merged into the
+ * first one. This mirrors the merge policy used by the view manager.
+ */
+TEST_CASE("Events which may switch the consumer are not merged with their successors")
+{
+    UI::EventQueue queue([] {}, 8);
+
+    for(unsigned int i = 1; i <= 4; ++i)
+        queue.post(UI::EventID::NAV_SCROLL_LINES, mk_param(i));
+
+    enum class ActiveView { PLAYER, BROWSER };
+    ActiveView active = ActiveView::PLAYER;
+    std::vector<unsigned int> swallowed_by_player;
+    std::vector<unsigned int> scrolled_in_browser;
+
+    const auto merge_while_browsing =
+        [&active] (UI::EventQueue::Event &held, UI::EventQueue::Event &next)
+        {
+            if(active != ActiveView::BROWSER ||
+               held.event_id_ != next.event_id_ || held.parameters_ == nullptr)
+                return false;
+
+            auto *h = dynamic_cast<Param *>(held.parameters_.get());
+            h->get_specific_non_const() += value_of(next);
+            return true;
+        };
+
+    CHECK(queue.take_all(
+        [&active, &swallowed_by_player, &scrolled_in_browser]
+        (UI::EventQueue::Event &&ev)
+        {
+            switch(active)
+            {
+              case ActiveView::PLAYER:
+                swallowed_by_player.push_back(value_of(ev));
+                active = ActiveView::BROWSER;
+                break;
+
+              case ActiveView::BROWSER:
+                scrolled_in_browser.push_back(value_of(ev));
+                break;
+            }
+        },
+        merge_while_browsing) == 2);
+
+    CHECK(swallowed_by_player == std::vector<unsigned int>{1});
+    CHECK(scrolled_in_browser == std::vector<unsigned int>{9});
+}
+
+TEST_CASE("Events from concurrent producers are all delivered in per-thread order")
+{
+    static constexpr unsigned int NUMBER_OF_THREADS = 4;
+    static constexpr unsigned int EVENTS_PER_THREAD = 5000;
+
+    std::atomic<unsigned int> triggers(0);
+    UI::EventQueue queue([&triggers] { ++triggers; }, 16);
+
+    std::vector<std::thread> producers;
+
+    for(unsigned int t = 0; t < NUMBER_OF_THREADS; ++t)
+        producers.emplace_back(
+            [&queue, t]
+            {
+                for(unsigned int i = 0; i < EVENTS_PER_THREAD; ++i)
+                    queue.post(UI::EventID::NAV_SCROLL_LINES,
+                               mk_param(t * EVENTS_PER_THREAD + i));
+            });
+
+    std::vector<unsigned int> next(NUMBER_OF_THREADS, 0);
+    unsigned int total = 0;
+    bool in_order = true;
+
+    const auto consume =
+        [&next, &in_order] (UI::EventQueue::Event &&ev)
+        {
+            const unsigned int v = value_of(ev);
+            const unsigned int t = v / EVENTS_PER_THREAD;
+
+            if(v % EVENTS_PER_THREAD != next[t])
+                in_order = false;
+
+            ++next[t];
+        };
+
+    while(total < NUMBER_OF_THREADS * EVENTS_PER_THREAD)
+        total += queue.take_all(consume);
+
+    for(auto &p : producers)
+        p.join();
+
+    CHECK(in_order);
+    CHECK(total == NUMBER_OF_THREADS * EVENTS_PER_THREAD);
+    CHECK(queue.take_all(consume) == 0);
+    CHECK(triggers.load() >= 1);
+}
+
+TEST_SUITE_END();